@@ -3,6 +3,9 @@
 
 #include <AzCore/EBus/EBus.h>
 #include <AzCore/Interface/Interface.h>
+#include <AzCore/Name/Name.h>
+
+#include <CustomCppToolGem/ProceduralModel.h>
 
 namespace CustomCppToolGem
 {
@@ -11,7 +14,29 @@ namespace CustomCppToolGem
     public:
         AZ_RTTI(CustomCppToolGemRequests, "{70FC8083-5232-483D-9F9E-C33A84F6F612}");
         virtual ~CustomCppToolGemRequests() = default;
-        // Put your public methods here
+
+        //! Queues mesh for upload as a model on the job system. The mesh is consumed; call through
+        //! CustomCppToolGemInterface to move it in rather than copy it.
+        virtual CustomGem::ModelBuildHandle BuildModel(
+            const AZ::Name& name, CustomGem::MeshData mesh, const CustomGem::ModelRequestSettings& settings) = 0;
+
+        //! Queues a parametric shape for generation and upload on the job system
+        virtual CustomGem::ModelBuildHandle BuildPrimitive(
+            const AZ::Name& name, const CustomGem::PrimitiveDesc& primitive, const CustomGem::ModelRequestSettings& settings) = 0;
+
+        //! Gives a model obtained from a build handle back; its buffers return to the shared pools once
+        //! no other holder of the same cached model is left.
+        virtual void ReleaseModel(AZ::Data::Asset<AZ::RPI::ModelAsset>& model) = 0;
+
+        //! Queues main thread work that is run a step at a time from OnTick within cg_generationBudgetMs,
+        //! lowest priority value first.
+        virtual CustomGem::GenerationTaskId QueueGenerationTask(CustomGem::GenerationStep step, float priority) = 0;
+
+        //! Removes a queued task; returns false when it is unknown or already finished. A task whose step
+        //! is running is removed once the step returns.
+        virtual bool CancelGenerationTask(CustomGem::GenerationTaskId id) = 0;
+
+        virtual void SetGenerationTaskPriority(CustomGem::GenerationTaskId id, float priority) = 0;
     };
     
     class CustomCppToolGemBusTraits
@@ -22,6 +47,8 @@ namespace CustomCppToolGem
         // EBusTraits overrides
         static constexpr AZ::EBusHandlerPolicy HandlerPolicy = AZ::EBusHandlerPolicy::Single;
         static constexpr AZ::EBusAddressPolicy AddressPolicy = AZ::EBusAddressPolicy::Single;
+        //! Builds are requested from loading code on any thread
+        using MutexType = AZStd::recursive_mutex;
         //////////////////////////////////////////////////////////////////////////
     };
 
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/containers/span.h>
+#include <AzCore/std/containers/vector.h>
+
+namespace CustomGem
+{
+    //! Non-owning view over tightly packed mesh streams, laid out like MeshData.
+    //! Exactly one of indices / indices16 is expected to hold data.
+    struct MeshStreams
+    {
+        AZStd::span<const uint32_t> indices;
+        AZStd::span<const uint16_t> indices16;
+        AZStd::span<const float> positions;   // x, y, z
+        AZStd::span<const float> normals;     // nx, ny, nz
+        AZStd::span<const float> tangents;    // tx, ty, tz, tw
+        AZStd::span<const float> bitangents;  // bx, by, bz
+        AZStd::span<const float> uvs;         // u, v
+    };
+
+    struct MeshData
+    {
+        //! Largest vertex index written to a 16-bit index buffer; 0xFFFF is kept free for primitive restart
+        static constexpr uint32_t MaxIndex16 = 0xFFFE;
+
+        AZStd::vector<uint32_t> indices;
+        AZStd::vector<uint16_t> indices16; // used instead of indices while use16BitIndices is set
+        AZStd::vector<float> positions;   // x, y, z
+        AZStd::vector<float> normals;     // nx, ny, nz
+        AZStd::vector<float> tangents;    // tx, ty, tz, tw
+        AZStd::vector<float> bitangents;  // bx, by, bz
+        AZStd::vector<float> uvs;         // u, v
+
+        //! Write 16-bit indices while the mesh is small enough.
+        //! AppendIndices switches to 32-bit indices on its own once an index exceeds MaxIndex16.
+        bool use16BitIndices = false;
+
+        //! Convenience clear function
+        void Clear()
+        {
+            indices.clear();
+            indices16.clear();
+            positions.clear();
+            normals.clear();
+            tangents.clear();
+            bitangents.clear();
+            uvs.clear();
+        }
+
+        //! Returns whether tangent and bitangent data are available
+        bool HasTangents() const { return !tangents.empty(); }
+        bool HasBitangents() const { return !bitangents.empty(); }
+        bool HasUVs() const { return !uvs.empty(); }
+
+        size_t GetVertexCount() const { return positions.size() / 3; }
+        size_t GetIndexCount() const { return use16BitIndices ? indices16.size() : indices.size(); }
+
+        //! Make room for vertexCount vertices and indexCount indices in total, so generators that
+        //! know their size up front fill every stream without reallocating. Capacity grows by at
+        //! least half each time, so repeated calls with slowly rising totals stay amortized.
+        void Reserve(size_t vertexCount, size_t indexCount)
+        {
+            auto reserveStream = [](auto& stream, size_t count)
+            {
+                if (count > stream.capacity())
+                {
+                    stream.reserve(AZStd::max(count, stream.capacity() + stream.capacity() / 2));
+                }
+            };
+            reserveStream(positions, vertexCount * 3);
+            reserveStream(normals, vertexCount * 3);
+            reserveStream(tangents, vertexCount * 4);
+            reserveStream(bitangents, vertexCount * 3);
+            reserveStream(uvs, vertexCount * 2);
+            if (use16BitIndices && vertexCount <= MaxIndex16 + 1)
+            {
+                reserveStream(indices16, indexCount);
+            }
+            else
+            {
+                reserveStream(indices, indexCount);
+            }
+        }
+
+        //! Make room for quadCount more quads (4 vertices and 6 indices each) after the current content
+        void ReserveQuads(size_t quadCount)
+        {
+            Reserve(GetVertexCount() + quadCount * 4, GetIndexCount() + quadCount * 6);
+        }
+
+        //! Bytes allocated by all streams, used or not
+        size_t GetCapacityBytes() const
+        {
+            return indices.capacity() * sizeof(uint32_t) + indices16.capacity() * sizeof(uint16_t) +
+                (positions.capacity() + normals.capacity() + tangents.capacity() + bitangents.capacity() + uvs.capacity()) * sizeof(float);
+        }
+
+        //! Append indices in the active index width
+        template<size_t Count>
+        void AppendIndices(const uint32_t (&values)[Count])
+        {
+            if (use16BitIndices)
+            {
+                uint32_t maxValue = 0;
+                for (uint32_t value : values)
+                {
+                    maxValue = AZStd::max(maxValue, value);
+                }
+
+                if (maxValue <= MaxIndex16)
+                {
+                    for (uint32_t value : values)
+                    {
+                        indices16.push_back(static_cast<uint16_t>(value));
+                    }
+                    return;
+                }
+                WidenIndices();
+            }
+            indices.insert(indices.end(), AZStd::begin(values), AZStd::end(values));
+        }
+
+        //! Move any 16-bit indices into the 32-bit stream and keep writing 32-bit indices
+        void WidenIndices()
+        {
+            if (use16BitIndices)
+            {
+                indices.insert(indices.end(), indices16.begin(), indices16.end());
+                indices16.clear();
+                indices16.shrink_to_fit();
+                use16BitIndices = false;
+            }
+        }
+
+        //! Switch back to 16-bit indices when every vertex can be addressed by one.
+        //! Returns whether the mesh uses 16-bit indices afterwards.
+        bool NarrowIndices()
+        {
+            if (!use16BitIndices && GetVertexCount() <= MaxIndex16 + 1)
+            {
+                indices16.resize(indices.size());
+                for (size_t i = 0; i < indices.size(); ++i)
+                {
+                    indices16[i] = static_cast<uint16_t>(indices[i]);
+                }
+                indices.clear();
+                indices.shrink_to_fit();
+                use16BitIndices = true;
+            }
+            return use16BitIndices;
+        }
+
+        //! Returns spans over all streams
+        MeshStreams GetStreams() const
+        {
+            MeshStreams streams;
+            streams.indices = AZStd::span<const uint32_t>(indices.data(), indices.size());
+            streams.indices16 = AZStd::span<const uint16_t>(indices16.data(), indices16.size());
+            streams.positions = AZStd::span<const float>(positions.data(), positions.size());
+            streams.normals = AZStd::span<const float>(normals.data(), normals.size());
+            streams.tangents = AZStd::span<const float>(tangents.data(), tangents.size());
+            streams.bitangents = AZStd::span<const float>(bitangents.data(), bitangents.size());
+            streams.uvs = AZStd::span<const float>(uvs.data(), uvs.size());
+            return streams;
+        }
+    };
+} // namespace CustomGem
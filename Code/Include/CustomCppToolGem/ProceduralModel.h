@@ -0,0 +1,200 @@
+#pragma once
+
+#include <CustomCppToolGem/MeshData.h>
+
+#include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/std/functional.h>
+#include <AzCore/std/parallel/atomic.h>
+#include <AzCore/std/parallel/conditional_variable.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/smart_ptr/make_shared.h>
+#include <AzCore/std/smart_ptr/shared_ptr.h>
+
+#include <Atom/RPI.Reflect/Model/ModelAsset.h>
+
+namespace CustomGem
+{
+    //! Parametric shapes CustomCppToolGemRequests::BuildPrimitive can generate
+    enum class PrimitiveShape : uint8_t
+    {
+        //! size.x by size.y in the XY plane facing +Z, centred on the origin, segments x segments quads
+        Plane,
+        //! size extents centred on the origin, segments x segments quads per side
+        Box,
+        //! Uv sphere of diameter size.x with segments slices and segments / 2 stacks
+        Sphere,
+        //! size.x by size.y grid centred on the origin with heights[column + row * heightsWidth] along +Z;
+        //! heights.size() must be a multiple of heightsWidth and both sides need at least two samples
+        Heightfield,
+    };
+
+    struct PrimitiveDesc
+    {
+        PrimitiveShape shape = PrimitiveShape::Box;
+        //! Every component must be positive, including the ones the shape does not use
+        AZ::Vector3 size = AZ::Vector3::CreateOne();
+        uint32_t segments = 1;
+        AZStd::vector<float> heights;
+        uint32_t heightsWidth = 0;
+    };
+
+    //! Build options for runtime requests; a subset of ModelBuildSettings that callers outside the gem can set
+    struct ModelRequestSettings
+    {
+        //! Triangle ratio of each LOD after LOD 0, finest first. Empty builds a single LOD.
+        AZStd::vector<float> lodTriangleRatios;
+        //! Reorder the mesh for the vertex cache and vertex fetch before upload
+        bool optimizeMesh = false;
+        //! Octahedral normals and tangents and half-float uvs; materials must decode them
+        bool quantizeVertices = false;
+        //! Share models built from identical input
+        bool useModelCache = true;
+        //! Also keep cached primitives in the on-disk model cache under @user@, so later sessions skip
+        //! generating them. Meant for tools and development builds; shipped games usually leave it off.
+        bool useDiskCache = false;
+        //! Queued builds start lowest value first, e.g. the distance to the camera. See ModelBuildHandle::SetPriority.
+        float priority = 0.0f;
+    };
+
+    enum class ModelBuildStatus : uint8_t
+    {
+        Pending,
+        Ready,
+        Failed,
+        Canceled,
+    };
+
+    //! What a generation task step reports back to the scheduler
+    enum class GenerationStepResult : uint8_t
+    {
+        //! The task is finished and leaves the queue
+        Done,
+        //! More work is left; the task may run again this frame while budget remains
+        Continue,
+        //! The task cannot make progress right now; it is retried next frame
+        Wait,
+    };
+
+    //! One slice of main thread work queued with CustomCppToolGemRequests::QueueGenerationTask.
+    //! Steps should be short, well under the per-frame budget; the budget is checked between steps.
+    using GenerationStep = AZStd::function<GenerationStepResult()>;
+    using GenerationTaskId = uint64_t;
+    constexpr GenerationTaskId InvalidGenerationTaskId = 0;
+
+    //! Shared between a ModelBuildHandle and the job building its model
+    class ModelBuildState
+    {
+    public:
+        explicit ModelBuildState(float priority = 0.0f)
+            : m_priority(priority)
+        {
+        }
+
+        ModelBuildStatus GetStatus() const { return m_status.load(AZStd::memory_order_acquire); }
+
+        //! Publishes the model, or the failure when it is empty, and wakes waiting threads
+        void Finish(AZ::Data::Asset<AZ::RPI::ModelAsset> model)
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+            m_model = AZStd::move(model);
+            m_status.store(m_model ? ModelBuildStatus::Ready : ModelBuildStatus::Failed, AZStd::memory_order_release);
+            m_done.notify_all();
+        }
+
+        //! Ends the build without a model after a cancel request
+        void FinishCanceled()
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+            m_status.store(ModelBuildStatus::Canceled, AZStd::memory_order_release);
+            m_done.notify_all();
+        }
+
+        void RequestCancel() { m_cancelRequested.store(true, AZStd::memory_order_relaxed); }
+        bool IsCancelRequested() const { return m_cancelRequested.load(AZStd::memory_order_relaxed); }
+
+        void SetPriority(float priority) { m_priority.store(priority, AZStd::memory_order_relaxed); }
+        float GetPriority() const { return m_priority.load(AZStd::memory_order_relaxed); }
+
+        AZ::Data::Asset<AZ::RPI::ModelAsset> GetModel() const
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+            return m_model;
+        }
+
+        void Wait() const
+        {
+            AZStd::unique_lock<AZStd::mutex> lock(m_mutex);
+            m_done.wait(lock, [this]() { return GetStatus() != ModelBuildStatus::Pending; });
+        }
+
+    private:
+        AZStd::atomic<ModelBuildStatus> m_status{ ModelBuildStatus::Pending };
+        AZStd::atomic<float> m_priority;
+        AZStd::atomic_bool m_cancelRequested{ false };
+        mutable AZStd::mutex m_mutex;
+        mutable AZStd::condition_variable m_done;
+        AZ::Data::Asset<AZ::RPI::ModelAsset> m_model;
+    };
+
+    //! Result of an asynchronous model build. Cheap to copy; all copies observe the same build.
+    //! Builds wait in the generation queue, most urgent first, until a build job slot is free.
+    //! Poll IsDone() from the game thread, or Wait() where blocking is acceptable (never on the main
+    //! thread, which drains the queue, and never on a job thread).
+    //! A finished model belongs to the caller, who hands it back through
+    //! CustomCppToolGemRequests::ReleaseModel when it is no longer used.
+    class ModelBuildHandle
+    {
+    public:
+        ModelBuildHandle() = default;
+        explicit ModelBuildHandle(AZStd::shared_ptr<ModelBuildState> state)
+            : m_state(AZStd::move(state))
+        {
+        }
+
+        static ModelBuildHandle Create(float priority = 0.0f) { return ModelBuildHandle(AZStd::make_shared<ModelBuildState>(priority)); }
+
+        bool IsValid() const { return m_state != nullptr; }
+        ModelBuildStatus GetStatus() const { return m_state ? m_state->GetStatus() : ModelBuildStatus::Failed; }
+        bool IsDone() const { return GetStatus() != ModelBuildStatus::Pending; }
+
+        //! The model once the build is Ready, empty before that and on failure
+        AZ::Data::Asset<AZ::RPI::ModelAsset> GetModel() const
+        {
+            return m_state ? m_state->GetModel() : AZ::Data::Asset<AZ::RPI::ModelAsset>();
+        }
+
+        void Wait() const
+        {
+            if (m_state)
+            {
+                m_state->Wait();
+            }
+        }
+
+        //! Drops a queued build, which then ends Canceled on the next tick. A build already running
+        //! finishes its work but also ends Canceled, with its model released.
+        void Cancel() const
+        {
+            if (m_state)
+            {
+                m_state->RequestCancel();
+            }
+        }
+
+        //! Reorders a queued build; takes effect on the next tick
+        void SetPriority(float priority) const
+        {
+            if (m_state)
+            {
+                m_state->SetPriority(priority);
+            }
+        }
+
+        //! For the build side
+        ModelBuildState* GetState() const { return m_state.get(); }
+
+    private:
+        AZStd::shared_ptr<ModelBuildState> m_state;
+    };
+} // namespace CustomGem
@@ -3,10 +3,53 @@
 
 #include <CustomCppToolGem/CustomCppToolGemTypeIds.h>
 
+#include <Generation/ModelBuilder.h>
+#include <Generation/PrimitiveGenerator.h>
+
+#include <AzCore/Console/IConsole.h>
+#include <AzCore/Jobs/JobFunction.h>
 #include <AzCore/Serialization/SerializeContext.h>
+#include <AzCore/std/algorithm.h>
 
 namespace CustomCppToolGem
 {
+    namespace
+    {
+        CustomGem::ModelBuildSettings ToBuildSettings(const CustomGem::ModelRequestSettings& request)
+        {
+            CustomGem::ModelBuildSettings settings;
+            settings.optimizeMesh = request.optimizeMesh;
+            settings.vertexProfile = request.quantizeVertices ? CustomGem::VertexProfile::Quantized : CustomGem::VertexProfile::Full;
+            settings.useModelCache = request.useModelCache;
+            settings.useDiskCache = request.useModelCache && request.useDiskCache;
+            for (float ratio : request.lodTriangleRatios)
+            {
+                CustomGem::ModelLodSettings lod;
+                lod.triangleRatio = ratio;
+                settings.lods.push_back(lod);
+            }
+            return settings;
+        }
+
+        CustomGem::ModelBuildHandle FailedBuild()
+        {
+            CustomGem::ModelBuildHandle handle = CustomGem::ModelBuildHandle::Create();
+            handle.GetState()->Finish({});
+            return handle;
+        }
+    } // namespace
+
+    AZ_CVAR(float, cg_generationBudgetMs, 2.0f, nullptr, AZ::ConsoleFunctorFlags::Null,
+        "Milliseconds of main thread time the generation queue may use per frame; at least one step always runs");
+    AZ_CVAR(uint32_t, cg_generationMaxBuildJobs, 2, nullptr, AZ::ConsoleFunctorFlags::Null,
+        "Model builds allowed on the job system at once; further builds wait in the generation queue");
+    AZ_CVAR(uint32_t, cg_generationQueueDepth, 0, nullptr, AZ::ConsoleFunctorFlags::ReadOnly,
+        "Generation tasks left queued after the last frame");
+    AZ_CVAR(float, cg_generationLastFrameMs, 0.0f, nullptr, AZ::ConsoleFunctorFlags::ReadOnly,
+        "Milliseconds the generation queue used in the last frame");
+    AZ_CVAR(AZ::u64, cg_generationOverruns, 0, nullptr, AZ::ConsoleFunctorFlags::ReadOnly,
+        "Frames in which the generation queue went past cg_generationBudgetMs");
+
     AZ_COMPONENT_IMPL(CustomCppToolGemSystemComponent, "CustomCppToolGemSystemComponent",
         CustomCppToolGemSystemComponentTypeId);
 
@@ -68,10 +111,171 @@ namespace CustomCppToolGem
     {
         AZ::TickBus::Handler::BusDisconnect();
         CustomCppToolGemRequestBus::Handler::BusDisconnect();
+        CancelBuilds();
+        m_scheduler.Clear();
+    }
+
+    CustomGem::ModelBuildHandle CustomCppToolGemSystemComponent::BuildModel(
+        const AZ::Name& name, CustomGem::MeshData mesh, const CustomGem::ModelRequestSettings& settings)
+    {
+        if (mesh.GetVertexCount() == 0 || mesh.GetIndexCount() == 0)
+        {
+            AZ_Warning("CustomCppToolGem", false, "BuildModel: %s has no triangles", name.GetCStr());
+            return FailedBuild();
+        }
+
+        return QueueBuild([name, mesh = AZStd::move(mesh), buildSettings = ToBuildSettings(settings)]() mutable
+            {
+                return CustomGem::ModelBuilder::CreateModel(name, AZStd::move(mesh), buildSettings);
+            }, settings.priority);
+    }
+
+    CustomGem::ModelBuildHandle CustomCppToolGemSystemComponent::BuildPrimitive(
+        const AZ::Name& name, const CustomGem::PrimitiveDesc& primitive, const CustomGem::ModelRequestSettings& settings)
+    {
+        if (!CustomGem::PrimitiveGenerator::Validate(primitive))
+        {
+            return FailedBuild();
+        }
+
+        const AZ::HashValue64 key = CustomGem::PrimitiveGenerator::ComputeKey(primitive);
+        return QueueBuild([name, primitive, key, buildSettings = ToBuildSettings(settings)]()
+            {
+                return CustomGem::ModelBuilder::CreateCachedModel(name, key, [&primitive](CustomGem::MeshData& mesh)
+                    {
+                        CustomGem::PrimitiveGenerator::Generate(primitive, mesh);
+                    }, buildSettings);
+            }, settings.priority);
+    }
+
+    void CustomCppToolGemSystemComponent::ReleaseModel(AZ::Data::Asset<AZ::RPI::ModelAsset>& model)
+    {
+        CustomGem::ModelBuilder::ReleaseModel(model);
+    }
+
+    CustomGem::GenerationTaskId CustomCppToolGemSystemComponent::QueueGenerationTask(CustomGem::GenerationStep step, float priority)
+    {
+        return m_scheduler.Queue(AZStd::move(step), priority);
+    }
+
+    bool CustomCppToolGemSystemComponent::CancelGenerationTask(CustomGem::GenerationTaskId id)
+    {
+        return m_scheduler.Cancel(id);
+    }
+
+    void CustomCppToolGemSystemComponent::SetGenerationTaskPriority(CustomGem::GenerationTaskId id, float priority)
+    {
+        m_scheduler.SetPriority(id, priority);
+    }
+
+    CustomGem::ModelBuildHandle CustomCppToolGemSystemComponent::QueueBuild(BuildFunction build, float priority)
+    {
+        CustomGem::ModelBuildHandle handle = CustomGem::ModelBuildHandle::Create(priority);
+
+        // The step only takes a job slot; the build itself never runs on the main thread
+        auto step = [this, handle, build = AZStd::move(build)]() mutable
+        {
+            CustomGem::ModelBuildState* state = handle.GetState();
+            if (state->IsCancelRequested())
+            {
+                state->FinishCanceled();
+                return CustomGem::GenerationStepResult::Done;
+            }
+            if (m_runningBuilds.load(AZStd::memory_order_relaxed) >= cg_generationMaxBuildJobs)
+            {
+                return CustomGem::GenerationStepResult::Wait;
+            }
+
+            m_runningBuilds.fetch_add(1, AZStd::memory_order_relaxed);
+            AZ::Job* job = AZ::CreateJobFunction([this, handle, build = AZStd::move(build)]()
+                {
+                    CustomGem::ModelBuildState* buildState = handle.GetState();
+                    AZ::Data::Asset<AZ::RPI::ModelAsset> model;
+                    if (!buildState->IsCancelRequested())
+                    {
+                        model = build();
+                    }
+
+                    // Free the slot before waking waiters, which may deactivate the component
+                    m_runningBuilds.fetch_sub(1, AZStd::memory_order_relaxed);
+                    if (buildState->IsCancelRequested())
+                    {
+                        CustomGem::ModelBuilder::ReleaseModel(model);
+                        buildState->FinishCanceled();
+                    }
+                    else
+                    {
+                        buildState->Finish(AZStd::move(model));
+                    }
+                }, true);
+            job->Start();
+            return CustomGem::GenerationStepResult::Done;
+        };
+
+        AZStd::lock_guard<AZStd::mutex> lock(m_buildMutex);
+        QueuedBuild queued;
+        queued.handle = handle;
+        queued.task = m_scheduler.Queue(AZStd::move(step), priority);
+        m_builds.push_back(AZStd::move(queued));
+        return handle;
+    }
+
+    void CustomCppToolGemSystemComponent::UpdateQueuedBuilds()
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_buildMutex);
+        m_builds.erase(AZStd::remove_if(m_builds.begin(), m_builds.end(),
+            [](const QueuedBuild& build) { return build.handle.IsDone(); }), m_builds.end());
+
+        // Once a build has started its task has left the scheduler and both calls do nothing
+        for (const QueuedBuild& build : m_builds)
+        {
+            CustomGem::ModelBuildState* state = build.handle.GetState();
+            if (state->IsCancelRequested())
+            {
+                if (m_scheduler.Cancel(build.task))
+                {
+                    state->FinishCanceled();
+                }
+            }
+            else
+            {
+                m_scheduler.SetPriority(build.task, state->GetPriority());
+            }
+        }
+    }
+
+    void CustomCppToolGemSystemComponent::CancelBuilds()
+    {
+        AZStd::vector<QueuedBuild> builds;
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_buildMutex);
+            builds.swap(m_builds);
+        }
+        for (const QueuedBuild& build : builds)
+        {
+            if (m_scheduler.Cancel(build.task))
+            {
+                build.handle.GetState()->FinishCanceled();
+            }
+        }
+        for (const QueuedBuild& build : builds)
+        {
+            build.handle.Wait();
+        }
     }
 
     void CustomCppToolGemSystemComponent::OnTick([[maybe_unused]] float deltaTime, [[maybe_unused]] AZ::ScriptTimePoint time)
     {
+        UpdateQueuedBuilds();
+        m_scheduler.Run(cg_generationBudgetMs);
+
+        // Cached models whose callers dropped them without ReleaseModel()
+        CustomGem::ModelBuilder::ReleaseUnusedModels();
+
+        const GenerationSchedulerStats stats = m_scheduler.GetStats();
+        cg_generationQueueDepth = static_cast<uint32_t>(stats.queueDepth);
+        cg_generationLastFrameMs = stats.lastMilliseconds;
+        cg_generationOverruns = stats.overruns;
     }
 
 } // namespace CustomCppToolGem
@@ -3,8 +3,14 @@
 
 #include <AzCore/Component/Component.h>
 #include <AzCore/Component/TickBus.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/functional.h>
+#include <AzCore/std/parallel/atomic.h>
+#include <AzCore/std/parallel/mutex.h>
 #include <CustomCppToolGem/CustomCppToolGemBus.h>
 
+#include "GenerationScheduler.h"
+
 namespace CustomCppToolGem
 {
     class CustomCppToolGemSystemComponent
@@ -28,7 +34,14 @@ namespace CustomCppToolGem
     protected:
         ////////////////////////////////////////////////////////////////////////
         // CustomCppToolGemRequestBus interface implementation
-
+        CustomGem::ModelBuildHandle BuildModel(
+            const AZ::Name& name, CustomGem::MeshData mesh, const CustomGem::ModelRequestSettings& settings) override;
+        CustomGem::ModelBuildHandle BuildPrimitive(
+            const AZ::Name& name, const CustomGem::PrimitiveDesc& primitive, const CustomGem::ModelRequestSettings& settings) override;
+        void ReleaseModel(AZ::Data::Asset<AZ::RPI::ModelAsset>& model) override;
+        CustomGem::GenerationTaskId QueueGenerationTask(CustomGem::GenerationStep step, float priority) override;
+        bool CancelGenerationTask(CustomGem::GenerationTaskId id) override;
+        void SetGenerationTaskPriority(CustomGem::GenerationTaskId id, float priority) override;
         ////////////////////////////////////////////////////////////////////////
 
         ////////////////////////////////////////////////////////////////////////
@@ -42,6 +55,30 @@ namespace CustomCppToolGem
         // AZTickBus interface implementation
         void OnTick(float deltaTime, AZ::ScriptTimePoint time) override;
         ////////////////////////////////////////////////////////////////////////
+
+    private:
+        using BuildFunction = AZStd::function<AZ::Data::Asset<AZ::RPI::ModelAsset>()>;
+
+        struct QueuedBuild
+        {
+            CustomGem::ModelBuildHandle handle;
+            CustomGem::GenerationTaskId task = CustomGem::InvalidGenerationTaskId;
+        };
+
+        //! Queues a scheduler task that runs build on the job system once a build job slot is free,
+        //! and keeps the handle until the build has finished
+        CustomGem::ModelBuildHandle QueueBuild(BuildFunction build, float priority);
+
+        //! Applies cancel and priority requests made through the handles of builds still queued
+        void UpdateQueuedBuilds();
+
+        //! Ends every build that has not started yet as Canceled and blocks until the running ones finish
+        void CancelBuilds();
+
+        GenerationScheduler m_scheduler;
+        AZStd::atomic<uint32_t> m_runningBuilds{ 0 };
+        AZStd::mutex m_buildMutex;
+        AZStd::vector<QueuedBuild> m_builds;
     };
 
 } // namespace CustomCppToolGem
@@ -0,0 +1,162 @@
+#include "GenerationScheduler.h"
+
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/chrono/chrono.h>
+
+namespace CustomCppToolGem
+{
+    CustomGem::GenerationTaskId GenerationScheduler::Queue(CustomGem::GenerationStep step, float priority)
+    {
+        if (!step)
+        {
+            return CustomGem::InvalidGenerationTaskId;
+        }
+
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        Task task;
+        task.id = m_nextId++;
+        task.priority = priority;
+        task.step = AZStd::move(step);
+        m_tasks.push_back(AZStd::move(task));
+        return m_tasks.back().id;
+    }
+
+    bool GenerationScheduler::Cancel(CustomGem::GenerationTaskId id)
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        auto queued = AZStd::find_if(m_tasks.begin(), m_tasks.end(), [id](const Task& task) { return task.id == id; });
+        if (queued != m_tasks.end())
+        {
+            m_tasks.erase(queued);
+            return true;
+        }
+
+        if (AZStd::binary_search(m_runningIds.begin(), m_runningIds.end(), id) &&
+            AZStd::find(m_runningCanceled.begin(), m_runningCanceled.end(), id) == m_runningCanceled.end())
+        {
+            m_runningCanceled.push_back(id);
+            return true;
+        }
+        return false;
+    }
+
+    void GenerationScheduler::SetPriority(CustomGem::GenerationTaskId id, float priority)
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        auto queued = AZStd::find_if(m_tasks.begin(), m_tasks.end(), [id](const Task& task) { return task.id == id; });
+        if (queued != m_tasks.end())
+        {
+            queued->priority = priority;
+        }
+        else if (AZStd::binary_search(m_runningIds.begin(), m_runningIds.end(), id))
+        {
+            m_runningPriorities[id] = priority;
+        }
+    }
+
+    void GenerationScheduler::Run(float budgetMilliseconds)
+    {
+        const auto startTime = AZStd::chrono::steady_clock::now();
+        const auto budget = AZStd::chrono::duration<float, AZStd::milli>(budgetMilliseconds);
+
+        // Steps run without the lock so they can queue, cancel and reprioritize tasks themselves
+        AZStd::vector<Task> tasks;
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+            if (m_running)
+            {
+                return;
+            }
+            tasks.swap(m_tasks);
+            m_runningIds.reserve(tasks.size());
+            for (const Task& task : tasks)
+            {
+                m_runningIds.push_back(task.id);
+            }
+            AZStd::sort(m_runningIds.begin(), m_runningIds.end());
+            m_running = true;
+        }
+
+        // Ids only grow, so the oldest task wins a tie
+        AZStd::sort(tasks.begin(), tasks.end(), [](const Task& left, const Task& right)
+            {
+                return left.priority < right.priority || (left.priority == right.priority && left.id < right.id);
+            });
+
+        uint32_t steps = 0;
+        auto elapsed = AZStd::chrono::steady_clock::now() - startTime;
+        for (Task& task : tasks)
+        {
+            if (steps > 0 && elapsed >= budget)
+            {
+                break;
+            }
+
+            CustomGem::GenerationStepResult result = CustomGem::GenerationStepResult::Continue;
+            while (result == CustomGem::GenerationStepResult::Continue && (steps == 0 || elapsed < budget) &&
+                !IsCanceledWhileRunning(task.id))
+            {
+                result = task.step();
+                ++steps;
+                elapsed = AZStd::chrono::steady_clock::now() - startTime;
+            }
+
+            if (result == CustomGem::GenerationStepResult::Done)
+            {
+                task.step = nullptr;
+            }
+        }
+
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        tasks.erase(AZStd::remove_if(tasks.begin(), tasks.end(), [this](const Task& task)
+            {
+                return !task.step ||
+                    AZStd::find(m_runningCanceled.begin(), m_runningCanceled.end(), task.id) != m_runningCanceled.end();
+            }), tasks.end());
+        for (Task& task : tasks)
+        {
+            auto priority = m_runningPriorities.find(task.id);
+            if (priority != m_runningPriorities.end())
+            {
+                task.priority = priority->second;
+            }
+        }
+
+        // Tasks queued by the steps go after the ones handed back
+        tasks.insert(tasks.end(), AZStd::make_move_iterator(m_tasks.begin()), AZStd::make_move_iterator(m_tasks.end()));
+        m_tasks.swap(tasks);
+        m_runningIds.clear();
+        m_runningPriorities.clear();
+        m_runningCanceled.clear();
+        m_running = false;
+
+        m_stats.queueDepth = m_tasks.size();
+        m_stats.lastSteps = steps;
+        m_stats.lastMilliseconds = AZStd::chrono::duration<float, AZStd::milli>(elapsed).count();
+        m_stats.totalSteps += steps;
+        if (steps > 0 && elapsed > budget)
+        {
+            ++m_stats.overruns;
+        }
+    }
+
+    bool GenerationScheduler::IsCanceledWhileRunning(CustomGem::GenerationTaskId id) const
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        return AZStd::find(m_runningCanceled.begin(), m_runningCanceled.end(), id) != m_runningCanceled.end();
+    }
+
+    void GenerationScheduler::Clear()
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        m_tasks.clear();
+        m_runningCanceled = m_runningIds;
+        m_stats.queueDepth = 0;
+    }
+
+    GenerationSchedulerStats GenerationScheduler::GetStats() const
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        return m_stats;
+    }
+} // namespace CustomCppToolGem
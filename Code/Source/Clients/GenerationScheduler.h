@@ -0,0 +1,67 @@
+#pragma once
+
+#include <CustomCppToolGem/ProceduralModel.h>
+
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/parallel/mutex.h>
+
+namespace CustomCppToolGem
+{
+    struct GenerationSchedulerStats
+    {
+        //! Tasks left queued after the last Run(), including the ones waiting
+        size_t queueDepth = 0;
+        //! Steps run and milliseconds spent by the last Run()
+        uint32_t lastSteps = 0;
+        float lastMilliseconds = 0.0f;
+        //! Run() calls that went past their budget
+        uint64_t overruns = 0;
+        uint64_t totalSteps = 0;
+    };
+
+    //! Priority queue of main thread work that is drained a slice at a time. Run() steps the most
+    //! urgent task (lowest priority value, then oldest) for as long as it continues and budget
+    //! remains, then moves on to the next one. At least one step runs per call, so a budget smaller
+    //! than any step still makes progress; such calls count as overruns.
+    //! Queue, Cancel and SetPriority may be called from any thread and from inside a step.
+    class GenerationScheduler
+    {
+    public:
+        CustomGem::GenerationTaskId Queue(CustomGem::GenerationStep step, float priority);
+
+        //! Returns false when id is not queued
+        bool Cancel(CustomGem::GenerationTaskId id);
+
+        void SetPriority(CustomGem::GenerationTaskId id, float priority);
+
+        //! Runs steps until budgetMilliseconds have passed or every task is done or waiting
+        void Run(float budgetMilliseconds);
+
+        //! Drops every queued task
+        void Clear();
+
+        GenerationSchedulerStats GetStats() const;
+
+    private:
+        bool IsCanceledWhileRunning(CustomGem::GenerationTaskId id) const;
+
+        struct Task
+        {
+            CustomGem::GenerationTaskId id = CustomGem::InvalidGenerationTaskId;
+            float priority = 0.0f;
+            CustomGem::GenerationStep step;
+        };
+
+        mutable AZStd::mutex m_mutex;
+        //! Queued tasks; empty while Run() holds them in its own list
+        AZStd::vector<Task> m_tasks;
+        //! Sorted ids of the tasks Run() holds, and requests for them applied when it hands them back
+        AZStd::vector<CustomGem::GenerationTaskId> m_runningIds;
+        AZStd::unordered_map<CustomGem::GenerationTaskId, float> m_runningPriorities;
+        AZStd::vector<CustomGem::GenerationTaskId> m_runningCanceled;
+        bool m_running = false;
+        CustomGem::GenerationTaskId m_nextId = 1;
+        GenerationSchedulerStats m_stats;
+    };
+} // namespace CustomCppToolGem
@@ -0,0 +1,122 @@
+#include "BufferPoolRegistry.h"
+
+#include <AzCore/Asset/AssetManager.h>
+
+#include <Atom/RPI.Reflect/ResourcePoolAssetCreator.h>
+
+namespace CustomGem
+{
+    using namespace AZ;
+    using namespace AZ::RPI;
+
+    BufferPoolRegistry& BufferPoolRegistry::Get()
+    {
+        static BufferPoolRegistry s_registry;
+        return s_registry;
+    }
+
+    BufferPoolRegistry::PoolKey BufferPoolRegistry::MakeKey(RHI::BufferBindFlags bindFlags, RHI::HeapMemoryLevel heapLevel)
+    {
+        return (static_cast<PoolKey>(bindFlags) << 32) | static_cast<PoolKey>(heapLevel);
+    }
+
+    Data::Asset<ResourcePoolAsset> BufferPoolRegistry::CreatePool(RHI::BufferBindFlags bindFlags, RHI::HeapMemoryLevel heapLevel)
+    {
+        const Data::AssetId poolId = Uuid::CreateRandom();
+        Data::Asset<ResourcePoolAsset> poolAsset = Data::AssetManager::Instance().CreateAsset(
+            poolId, azrtti_typeid<ResourcePoolAsset>(), Data::AssetLoadBehavior::PreLoad);
+
+        auto poolDesc = AZStd::make_unique<RHI::BufferPoolDescriptor>();
+        poolDesc->m_bindFlags = bindFlags;
+        poolDesc->m_heapMemoryLevel = heapLevel;
+
+        ResourcePoolAssetCreator poolCreator;
+        poolCreator.Begin(poolId);
+        poolCreator.SetPoolDescriptor(AZStd::move(poolDesc));
+        poolCreator.SetPoolName("ModelBuilderBufferPool");
+        poolCreator.End(poolAsset);
+
+        return poolAsset;
+    }
+
+    Data::Asset<ResourcePoolAsset> BufferPoolRegistry::Acquire(
+        RHI::BufferBindFlags bindFlags, RHI::HeapMemoryLevel heapLevel, uint64_t byteCount)
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+
+        PoolEntry& entry = m_pools[MakeKey(bindFlags, heapLevel)];
+        if (!entry.asset.IsReady())
+        {
+            entry.asset = CreatePool(bindFlags, heapLevel);
+            ++m_poolsCreated;
+        }
+
+        ++entry.bufferCount;
+        entry.byteCount += byteCount;
+        return entry.asset;
+    }
+
+    void BufferPoolRegistry::Release(const BufferAsset& bufferAsset)
+    {
+        const Data::AssetId poolId = bufferAsset.GetPoolAsset().GetId();
+        const uint64_t byteCount = bufferAsset.GetBufferDescriptor().m_byteCount;
+
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+
+        for (auto it = m_pools.begin(); it != m_pools.end(); ++it)
+        {
+            PoolEntry& entry = it->second;
+            if (entry.asset.GetId() != poolId)
+            {
+                continue;
+            }
+
+            AZ_Assert(entry.bufferCount > 0, "BufferPoolRegistry: released more buffers than were acquired");
+            entry.bufferCount -= AZStd::min<uint64_t>(entry.bufferCount, 1);
+            entry.byteCount -= AZStd::min(entry.byteCount, byteCount);
+
+            if (entry.bufferCount == 0)
+            {
+                m_pools.erase(it);
+            }
+            return;
+        }
+    }
+
+    uint32_t BufferPoolRegistry::ReleaseUnused()
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+
+        uint32_t released = 0;
+        for (auto it = m_pools.begin(); it != m_pools.end();)
+        {
+            // The registry's own handle is the only remaining reference
+            const Data::AssetData* data = it->second.asset.Get();
+            if (!data || data->GetUseCount() <= 1)
+            {
+                it = m_pools.erase(it);
+                ++released;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        return released;
+    }
+
+    BufferPoolStats BufferPoolRegistry::GetStats() const
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+
+        BufferPoolStats stats;
+        stats.livePools = static_cast<uint32_t>(m_pools.size());
+        stats.poolsCreated = m_poolsCreated;
+        for (const auto& pool : m_pools)
+        {
+            stats.liveBuffers += pool.second.bufferCount;
+            stats.liveBytes += pool.second.byteCount;
+        }
+        return stats;
+    }
+} // namespace CustomGem
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/parallel/mutex.h>
+
+#include <Atom/RHI.Reflect/BufferPoolDescriptor.h>
+#include <Atom/RPI.Reflect/Buffer/BufferAsset.h>
+#include <Atom/RPI.Reflect/ResourcePoolAsset.h>
+
+namespace CustomGem
+{
+    //! Snapshot of the pools owned by the registry.
+    struct BufferPoolStats
+    {
+        uint32_t livePools = 0;     // pools currently held by the registry
+        uint64_t liveBuffers = 0;   // buffers acquired and not yet released
+        uint64_t liveBytes = 0;     // bytes held by those buffers
+        uint64_t poolsCreated = 0;  // total pools created since startup
+    };
+
+    //! Shares ResourcePoolAssets between generated buffers.
+    //! Pools are keyed by bind flags and heap level, so every generated model with the same
+    //! buffer usage ends up in the same pool instead of creating one pool per stream.
+    class BufferPoolRegistry
+    {
+    public:
+        static BufferPoolRegistry& Get();
+
+        //! Returns the shared pool for the given usage, creating it on first use.
+        //! Each call adds one buffer reference of byteCount bytes to the pool; pair with Release().
+        AZ::Data::Asset<AZ::RPI::ResourcePoolAsset> Acquire(
+            AZ::RHI::BufferBindFlags bindFlags, AZ::RHI::HeapMemoryLevel heapLevel, uint64_t byteCount);
+
+        //! Drops a buffer reference taken by Acquire(). The pool is released from the registry
+        //! once its last buffer reference is gone.
+        void Release(const AZ::RPI::BufferAsset& bufferAsset);
+
+        //! Drops pools that are no longer referenced by any buffer asset, regardless of the
+        //! acquire/release bookkeeping. Returns the number of pools dropped.
+        uint32_t ReleaseUnused();
+
+        BufferPoolStats GetStats() const;
+
+    private:
+        using PoolKey = uint64_t;
+
+        struct PoolEntry
+        {
+            AZ::Data::Asset<AZ::RPI::ResourcePoolAsset> asset;
+            uint64_t bufferCount = 0;
+            uint64_t byteCount = 0;
+        };
+
+        static PoolKey MakeKey(AZ::RHI::BufferBindFlags bindFlags, AZ::RHI::HeapMemoryLevel heapLevel);
+        static AZ::Data::Asset<AZ::RPI::ResourcePoolAsset> CreatePool(
+            AZ::RHI::BufferBindFlags bindFlags, AZ::RHI::HeapMemoryLevel heapLevel);
+
+        mutable AZStd::mutex m_mutex;
+        AZStd::unordered_map<PoolKey, PoolEntry> m_pools;
+        uint64_t m_poolsCreated = 0;
+    };
+} // namespace CustomGem
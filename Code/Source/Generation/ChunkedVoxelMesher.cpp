@@ -0,0 +1,95 @@
+#include "ChunkedVoxelMesher.h"
+#include "MeshDataPool.h"
+
+#include <AzCore/Jobs/JobCompletion.h>
+#include <AzCore/Jobs/JobContext.h>
+#include <AzCore/Jobs/JobFunction.h>
+#include <AzCore/std/string/string.h>
+
+namespace CustomGem
+{
+    VoxelCoord ChunkedVoxelMesher::GetChunkCount(const VoxelVolume& volume, int chunkSize)
+    {
+        AZ_Assert(chunkSize > 0, "ChunkedVoxelMesher: chunk size must be positive");
+        return {
+            (volume.size.x + chunkSize - 1) / chunkSize,
+            (volume.size.y + chunkSize - 1) / chunkSize,
+            (volume.size.z + chunkSize - 1) / chunkSize };
+    }
+
+    void ChunkedVoxelMesher::BuildChunk(const VoxelVolume& volume, const ChunkedMeshSettings& settings, VoxelChunk& chunk)
+    {
+        const VoxelCoord regionMax = {
+            chunk.origin.x + settings.chunkSize,
+            chunk.origin.y + settings.chunkSize,
+            chunk.origin.z + settings.chunkSize };
+
+        // Storage handed back after the chunk's last upload is picked up again from the pool
+        if (chunk.mesh.GetCapacityBytes() == 0)
+        {
+            chunk.mesh = MeshDataPool::Get().Acquire();
+        }
+        chunk.mesh.Clear();
+        chunk.mesh.use16BitIndices = true;
+        chunk.stats = VoxelMesher::BuildRegion(volume, chunk.origin, regionMax, chunk.mesh, settings.meshSettings);
+
+        chunk.model.Reset();
+        if (settings.createModels && chunk.stats.quads > 0)
+        {
+            const AZStd::string name = AZStd::string::format("VoxelChunk_%d_%d_%d", chunk.coord.x, chunk.coord.y, chunk.coord.z);
+            chunk.model = ModelBuilder::CreateModel(AZ::Name(name), chunk.mesh, settings.modelSettings);
+        }
+    }
+
+    void ChunkedVoxelMesher::Build(const VoxelVolume& volume, const ChunkedMeshSettings& settings, AZStd::vector<VoxelChunk>& chunks)
+    {
+        const VoxelCoord count = GetChunkCount(volume, settings.chunkSize);
+        chunks.clear();
+        chunks.resize(static_cast<size_t>(count.x) * count.y * count.z);
+
+        for (int z = 0; z < count.z; ++z)
+        {
+            for (int y = 0; y < count.y; ++y)
+            {
+                for (int x = 0; x < count.x; ++x)
+                {
+                    VoxelChunk& chunk = chunks[(static_cast<size_t>(z) * count.y + y) * count.x + x];
+                    chunk.coord = { x, y, z };
+                    chunk.origin = { x * settings.chunkSize, y * settings.chunkSize, z * settings.chunkSize };
+                }
+            }
+        }
+
+        AZStd::vector<VoxelChunk*> pending;
+        pending.reserve(chunks.size());
+        for (VoxelChunk& chunk : chunks)
+        {
+            pending.push_back(&chunk);
+        }
+        BuildChunks(volume, settings, pending);
+    }
+
+    void ChunkedVoxelMesher::BuildChunks(const VoxelVolume& volume, const ChunkedMeshSettings& settings, AZStd::span<VoxelChunk* const> chunks)
+    {
+        if (chunks.size() == 1)
+        {
+            // Not worth a round trip through the job system
+            BuildChunk(volume, settings, *chunks[0]);
+            return;
+        }
+
+        AZ::JobCompletion completion(settings.jobContext);
+        for (VoxelChunk* chunk : chunks)
+        {
+            AZ::Job* job = AZ::CreateJobFunction(
+                [&volume, &settings, chunk]()
+                {
+                    BuildChunk(volume, settings, *chunk);
+                },
+                true, settings.jobContext);
+            job->SetDependent(&completion);
+            job->Start();
+        }
+        completion.StartAndWaitForCompletion();
+    }
+} // namespace CustomGem
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "ModelBuilder.h"
+#include "VoxelMesher.h"
+
+#include <AzCore/std/containers/span.h>
+#include <AzCore/std/containers/vector.h>
+
+namespace AZ
+{
+    class JobContext;
+}
+
+namespace CustomGem
+{
+    struct ChunkedMeshSettings
+    {
+        //! Edge length of a chunk in voxels
+        int chunkSize = 32;
+        VoxelMeshSettings meshSettings;
+        ModelBuildSettings modelSettings;
+        //! Build a ModelAsset for every non-empty chunk; when false only the MeshData is produced
+        bool createModels = true;
+        //! Job context to run on, nullptr uses the global context
+        AZ::JobContext* jobContext = nullptr;
+    };
+
+    //! One meshed chunk. The chunk covers [origin, origin + chunkSize) clamped to the volume.
+    struct VoxelChunk
+    {
+        VoxelCoord coord;   // chunk grid coordinate
+        VoxelCoord origin;  // first voxel of the chunk
+        MeshData mesh;
+        VoxelMeshStats stats;
+        AZ::Data::Asset<AZ::RPI::ModelAsset> model;
+    };
+
+    //! Splits a volume into fixed-size chunks and meshes every chunk on its own job.
+    //! Each chunk writes only to its own slot, so the output does not depend on the number of
+    //! worker threads or on the order the jobs run in.
+    struct ChunkedVoxelMesher
+    {
+        //! Number of chunks along each axis
+        static VoxelCoord GetChunkCount(const VoxelVolume& volume, int chunkSize);
+
+        //! Mesh all chunks of the volume. chunks is resized to one entry per chunk, x fastest.
+        static void Build(const VoxelVolume& volume, const ChunkedMeshSettings& settings, AZStd::vector<VoxelChunk>& chunks);
+
+        //! Mesh the given chunks in parallel. Each chunk must have its coord and origin set.
+        static void BuildChunks(const VoxelVolume& volume, const ChunkedMeshSettings& settings, AZStd::span<VoxelChunk* const> chunks);
+
+        //! Mesh (and optionally build the model of) one chunk on the calling thread.
+        static void BuildChunk(const VoxelVolume& volume, const ChunkedMeshSettings& settings, VoxelChunk& chunk);
+    };
+} // namespace CustomGem
@@ -0,0 +1,180 @@
+#include "MappedFile.h"
+
+#include <AzCore/IO/FileIO.h>
+
+#include <cstring>
+
+#if defined(AZ_PLATFORM_WINDOWS)
+#include <AzCore/PlatformIncl.h>
+#elif defined(AZ_PLATFORM_LINUX) || defined(AZ_PLATFORM_MAC)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace CustomGem
+{
+    namespace
+    {
+#if defined(AZ_PLATFORM_LINUX) || defined(AZ_PLATFORM_MAC)
+        //! [offset, offset + size) widened to whole pages, clamped to the mapping
+        bool GetPageRange(const uint8_t* data, uint64_t mappedSize, uint64_t offset, uint64_t size, void*& first, size_t& length)
+        {
+            if (!data || offset >= mappedSize)
+            {
+                return false;
+            }
+            const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+            const uint64_t begin = offset / pageSize * pageSize;
+            const uint64_t end = AZStd::min(offset + size, mappedSize);
+            first = const_cast<uint8_t*>(data + begin);
+            length = static_cast<size_t>(end - begin);
+            return length > 0;
+        }
+#endif
+    } // namespace
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other)
+    {
+        *this = AZStd::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other)
+    {
+        if (this != &other)
+        {
+            Close();
+            m_data = other.m_data;
+            m_size = other.m_size;
+            m_mapping = other.m_mapping;
+            other.m_data = nullptr;
+            other.m_size = 0;
+            other.m_mapping = nullptr;
+        }
+        return *this;
+    }
+
+    bool MappedFile::Open(const char* path)
+    {
+        Close();
+
+        char nativePath[AZ_MAX_PATH_LEN] = {};
+        AZ::IO::FileIOBase* fileIO = AZ::IO::FileIOBase::GetInstance();
+        if (!fileIO || !fileIO->ResolvePath(path, nativePath, AZ_ARRAY_SIZE(nativePath)))
+        {
+            azstrncpy(nativePath, AZ_ARRAY_SIZE(nativePath), path, strlen(path));
+        }
+
+#if defined(AZ_PLATFORM_WINDOWS)
+        HANDLE file = CreateFileA(
+            nativePath, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        LARGE_INTEGER size = {};
+        HANDLE mapping = nullptr;
+        if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+        {
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        }
+        // The mapping keeps the file open
+        CloseHandle(file);
+        if (!mapping)
+        {
+            return false;
+        }
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view)
+        {
+            CloseHandle(mapping);
+            return false;
+        }
+        m_mapping = mapping;
+        m_data = static_cast<const uint8_t*>(view);
+        m_size = static_cast<uint64_t>(size.QuadPart);
+        return true;
+#elif defined(AZ_PLATFORM_LINUX) || defined(AZ_PLATFORM_MAC)
+        const int file = open(nativePath, O_RDONLY | O_CLOEXEC);
+        if (file < 0)
+        {
+            return false;
+        }
+        struct stat info = {};
+        void* view = MAP_FAILED;
+        if (fstat(file, &info) == 0 && info.st_size > 0)
+        {
+            view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        }
+        // The mapping keeps the file open
+        close(file);
+        if (view == MAP_FAILED)
+        {
+            return false;
+        }
+        m_data = static_cast<const uint8_t*>(view);
+        m_size = static_cast<uint64_t>(info.st_size);
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void MappedFile::Close()
+    {
+        if (!m_data)
+        {
+            return;
+        }
+#if defined(AZ_PLATFORM_WINDOWS)
+        UnmapViewOfFile(m_data);
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+#elif defined(AZ_PLATFORM_LINUX) || defined(AZ_PLATFORM_MAC)
+        munmap(const_cast<uint8_t*>(m_data), static_cast<size_t>(m_size));
+#endif
+        m_data = nullptr;
+        m_size = 0;
+        m_mapping = nullptr;
+    }
+
+    void MappedFile::WillNeed(uint64_t offset, uint64_t size) const
+    {
+#if defined(AZ_PLATFORM_LINUX) || defined(AZ_PLATFORM_MAC)
+        void* first = nullptr;
+        size_t length = 0;
+        if (GetPageRange(m_data, m_size, offset, size, first, length))
+        {
+            madvise(first, length, MADV_WILLNEED);
+        }
+#else
+        // Windows reads ahead on its own for the sequential access the file was opened with
+        AZ_UNUSED(offset);
+        AZ_UNUSED(size);
+#endif
+    }
+
+    void MappedFile::DontNeed(uint64_t offset, uint64_t size) const
+    {
+#if defined(AZ_PLATFORM_WINDOWS)
+        // Unlocking pages that were never locked removes them from the working set
+        if (m_data && offset < m_size)
+        {
+            VirtualUnlock(const_cast<uint8_t*>(m_data + offset), static_cast<SIZE_T>(AZStd::min(size, m_size - offset)));
+        }
+#elif defined(AZ_PLATFORM_LINUX) || defined(AZ_PLATFORM_MAC)
+        void* first = nullptr;
+        size_t length = 0;
+        if (GetPageRange(m_data, m_size, offset, size, first, length))
+        {
+            madvise(first, length, MADV_DONTNEED);
+        }
+#endif
+    }
+} // namespace CustomGem
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <AzCore/std/containers/span.h>
+
+namespace CustomGem
+{
+    //! A whole file mapped read-only into memory. The pages are backed by the file itself, so a
+    //! mapping larger than RAM only costs what is resident at the time. Paths may use FileIO aliases.
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+        MappedFile(MappedFile&& other);
+        MappedFile& operator=(MappedFile&& other);
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        //! Maps path; false when it is missing, empty or cannot be mapped.
+        bool Open(const char* path);
+        void Close();
+
+        bool IsOpen() const { return m_data != nullptr; }
+        const uint8_t* GetData() const { return m_data; }
+        uint64_t GetSize() const { return m_size; }
+        AZStd::span<const uint8_t> GetBytes() const { return { m_data, static_cast<size_t>(m_size) }; }
+
+        //! Start paging in [offset, offset + size) ahead of reading it
+        void WillNeed(uint64_t offset, uint64_t size) const;
+        //! Drop the resident pages of [offset, offset + size), which are read again from the file if touched
+        void DontNeed(uint64_t offset, uint64_t size) const;
+
+    private:
+        const uint8_t* m_data = nullptr;
+        uint64_t m_size = 0;
+        //! File mapping handle on Windows
+        void* m_mapping = nullptr;
+    };
+} // namespace CustomGem
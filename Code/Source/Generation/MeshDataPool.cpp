@@ -0,0 +1,84 @@
+#include "MeshDataPool.h"
+
+#include <AzCore/std/algorithm.h>
+
+namespace CustomGem
+{
+    MeshDataPool& MeshDataPool::Get()
+    {
+        static MeshDataPool s_pool;
+        return s_pool;
+    }
+
+    MeshData MeshDataPool::Acquire()
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        if (m_meshes.empty())
+        {
+            ++m_created;
+            return MeshData();
+        }
+
+        MeshData mesh = AZStd::move(m_meshes.back());
+        m_meshes.pop_back();
+        m_pooledBytes -= mesh.GetCapacityBytes();
+        ++m_reused;
+        return mesh;
+    }
+
+    void MeshDataPool::Recycle(MeshData&& mesh)
+    {
+        MeshData recycled = AZStd::move(mesh);
+        recycled.Clear();
+        recycled.use16BitIndices = false;
+
+        const uint64_t bytes = recycled.GetCapacityBytes();
+        if (bytes == 0)
+        {
+            return;
+        }
+
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        auto it = AZStd::upper_bound(m_meshes.begin(), m_meshes.end(), bytes,
+            [](uint64_t value, const MeshData& pooled) { return value < pooled.GetCapacityBytes(); });
+        m_meshes.insert(it, AZStd::move(recycled));
+        m_pooledBytes += bytes;
+        Trim();
+    }
+
+    void MeshDataPool::Trim()
+    {
+        size_t dropped = 0;
+        while (m_pooledBytes > m_maxBytes && dropped < m_meshes.size())
+        {
+            m_pooledBytes -= m_meshes[dropped].GetCapacityBytes();
+            ++dropped;
+        }
+        m_meshes.erase(m_meshes.begin(), m_meshes.begin() + dropped);
+    }
+
+    void MeshDataPool::SetMaxBytes(uint64_t maxBytes)
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        m_maxBytes = maxBytes;
+        Trim();
+    }
+
+    void MeshDataPool::Clear()
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        m_meshes.clear();
+        m_pooledBytes = 0;
+    }
+
+    MeshDataPoolStats MeshDataPool::GetStats() const
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        MeshDataPoolStats stats;
+        stats.pooledMeshes = static_cast<uint32_t>(m_meshes.size());
+        stats.pooledBytes = m_pooledBytes;
+        stats.reused = m_reused;
+        stats.created = m_created;
+        return stats;
+    }
+} // namespace CustomGem
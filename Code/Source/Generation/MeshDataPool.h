@@ -0,0 +1,53 @@
+#pragma once
+
+#include "MeshUtils.h"
+
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/parallel/mutex.h>
+
+namespace CustomGem
+{
+    //! Snapshot of the mesh storage pool.
+    struct MeshDataPoolStats
+    {
+        uint32_t pooledMeshes = 0;  // meshes waiting to be reused
+        uint64_t pooledBytes = 0;   // capacity held by those meshes
+        uint64_t reused = 0;        // Acquire() calls served from the pool
+        uint64_t created = 0;       // Acquire() calls that started from empty storage
+    };
+
+    //! Recycles MeshData storage between generator runs. Meshes that are thrown away after upload
+    //! are handed back with Recycle() and come out of Acquire() cleared but with their capacity
+    //! intact, so remeshing the same chunks again fills existing allocations instead of growing
+    //! fresh vectors from zero.
+    class MeshDataPool
+    {
+    public:
+        static MeshDataPool& Get();
+
+        //! An empty mesh, reusing the largest pooled storage when there is any
+        MeshData Acquire();
+
+        //! Keep the storage of mesh for a later Acquire(). Storage beyond the size limit is freed.
+        void Recycle(MeshData&& mesh);
+
+        //! Capacity the pool may hold on to; 256 MiB by default.
+        void SetMaxBytes(uint64_t maxBytes);
+
+        //! Free all pooled storage.
+        void Clear();
+
+        MeshDataPoolStats GetStats() const;
+
+    private:
+        //! Drops the smallest meshes until the pool fits; requires m_mutex.
+        void Trim();
+
+        mutable AZStd::mutex m_mutex;
+        AZStd::vector<MeshData> m_meshes; // ascending capacity
+        uint64_t m_pooledBytes = 0;
+        uint64_t m_maxBytes = 256ull * 1024 * 1024;
+        uint64_t m_reused = 0;
+        uint64_t m_created = 0;
+    };
+} // namespace CustomGem
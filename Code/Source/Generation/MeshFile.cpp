@@ -0,0 +1,378 @@
+#include "MeshFile.h"
+
+#include <AzCore/Compression/compression.h>
+#include <AzCore/IO/FileIO.h>
+
+#include <cstddef>
+#include <cstring>
+
+namespace CustomGem
+{
+    using namespace AZ;
+
+    namespace
+    {
+        static_assert(sizeof(MeshFileStream) == 32, "MeshFileStream is part of the file format");
+        static_assert(sizeof(MeshFileHeader) == 264, "MeshFileHeader is part of the file format");
+
+        //! Element size of each stream, in file order
+        constexpr uint32_t StreamElementSizes[MeshFile::StreamCount] = {
+            sizeof(uint32_t), sizeof(uint16_t), sizeof(float), sizeof(float), sizeof(float), sizeof(float), sizeof(float) };
+
+        //! Each ZLib block starts with its stored and raw size; stored == raw means the block did not
+        //! shrink and is kept uncompressed
+        struct BlockHeader
+        {
+            uint32_t storedBytes = 0;
+            uint32_t rawBytes = 0;
+        };
+
+        constexpr uint64_t AlignUp(uint64_t value, uint64_t alignment)
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        //! The streams of mesh as raw bytes, in file order
+        void GetStreamBytes(const MeshStreams& mesh, AZStd::span<const uint8_t> (&bytes)[MeshFile::StreamCount])
+        {
+            auto asBytes = [](auto stream)
+            {
+                return AZStd::span<const uint8_t>(reinterpret_cast<const uint8_t*>(stream.data()), stream.size_bytes());
+            };
+            bytes[0] = asBytes(mesh.indices);
+            bytes[1] = asBytes(mesh.indices16);
+            bytes[2] = asBytes(mesh.positions);
+            bytes[3] = asBytes(mesh.normals);
+            bytes[4] = asBytes(mesh.tangents);
+            bytes[5] = asBytes(mesh.bitangents);
+            bytes[6] = asBytes(mesh.uvs);
+        }
+
+        //! Points the spans of mesh at the raw bytes of each stream
+        void SetStreamBytes(MeshStreams& mesh, const uint8_t* const (&bytes)[MeshFile::StreamCount], const MeshFileHeader& header)
+        {
+            auto view = [&](auto& stream, size_t index)
+            {
+                using Element = typename AZStd::remove_reference_t<decltype(stream)>::element_type;
+                stream = { reinterpret_cast<Element*>(bytes[index]), static_cast<size_t>(header.streams[index].elementCount) };
+            };
+            view(mesh.indices, 0);
+            view(mesh.indices16, 1);
+            view(mesh.positions, 2);
+            view(mesh.normals, 3);
+            view(mesh.tangents, 4);
+            view(mesh.bitangents, 5);
+            view(mesh.uvs, 6);
+        }
+
+        //! Closes a FileIO handle when it goes out of scope
+        class ScopedFile
+        {
+        public:
+            ScopedFile(const char* path, IO::OpenMode mode)
+            {
+                IO::FileIOBase::GetInstance()->Open(path, mode, m_handle);
+            }
+            ~ScopedFile()
+            {
+                if (m_handle != IO::InvalidHandle)
+                {
+                    IO::FileIOBase::GetInstance()->Close(m_handle);
+                }
+            }
+
+            bool IsOpen() const { return m_handle != IO::InvalidHandle; }
+            IO::HandleType Get() const { return m_handle; }
+
+        private:
+            IO::HandleType m_handle = IO::InvalidHandle;
+        };
+
+        bool IsValidHeader(const MeshFileHeader& header)
+        {
+            return header.magic == MeshFile::Magic && header.formatVersion == MeshFile::FormatVersion &&
+                header.headerBytes == sizeof(MeshFileHeader);
+        }
+
+        //! Writes bytes as ZLib blocks at the current file position. Returns the stored size, 0 on failure.
+        uint64_t WriteCompressed(
+            IO::FileIOBase* fileIO, IO::HandleType handle, AZStd::span<const uint8_t> bytes, uint32_t level,
+            AZStd::vector<uint8_t>& scratch)
+        {
+            ZLib zlib;
+            zlib.StartCompressor(level);
+            scratch.resize_no_construct(static_cast<size_t>(AZStd::min<uint64_t>(bytes.size(), MeshFile::CompressionBlockBytes)));
+
+            uint64_t storedBytes = 0;
+            bool written = true;
+            for (size_t first = 0; written && first < bytes.size(); first += MeshFile::CompressionBlockBytes)
+            {
+                const uint8_t* raw = bytes.data() + first;
+                BlockHeader block;
+                block.rawBytes = static_cast<uint32_t>(AZStd::min<uint64_t>(bytes.size() - first, MeshFile::CompressionBlockBytes));
+
+                // Output that fills the scratch block did not shrink; such blocks are stored raw
+                zlib.ResetCompressor();
+                unsigned int remaining = block.rawBytes;
+                const unsigned int compressed = zlib.Compress(raw, remaining, scratch.data(), block.rawBytes, ZLib::FT_FINISH);
+                const bool shrunk = remaining == 0 && compressed > 0 && compressed < block.rawBytes;
+                block.storedBytes = shrunk ? compressed : block.rawBytes;
+
+                written = fileIO->Write(handle, &block, sizeof(block)) &&
+                    fileIO->Write(handle, shrunk ? scratch.data() : raw, block.storedBytes);
+                storedBytes += sizeof(block) + block.storedBytes;
+            }
+            zlib.StopCompressor();
+            return written ? storedBytes : 0;
+        }
+
+        //! Inflates the ZLib blocks of one stream into out, which holds the raw size
+        bool ReadCompressed(AZStd::span<const uint8_t> stored, AZStd::span<uint8_t> out)
+        {
+            ZLib zlib;
+            zlib.StartDecompressor();
+
+            bool valid = true;
+            size_t read = 0;
+            size_t written = 0;
+            while (valid && read < stored.size())
+            {
+                BlockHeader block;
+                valid = stored.size() - read >= sizeof(block);
+                if (!valid)
+                {
+                    break;
+                }
+                memcpy(&block, stored.data() + read, sizeof(block));
+                read += sizeof(block);
+
+                valid = block.storedBytes <= stored.size() - read && block.rawBytes <= out.size() - written &&
+                    block.storedBytes <= block.rawBytes;
+                if (!valid)
+                {
+                    break;
+                }
+
+                if (block.storedBytes == block.rawBytes)
+                {
+                    memcpy(out.data() + written, stored.data() + read, block.rawBytes);
+                }
+                else
+                {
+                    zlib.ResetDecompressor();
+                    unsigned int inflatedBytes = block.rawBytes;
+                    zlib.Decompress(stored.data() + read, block.storedBytes, out.data() + written, inflatedBytes);
+                    valid = inflatedBytes == block.rawBytes;
+                }
+                read += block.storedBytes;
+                written += block.rawBytes;
+            }
+            zlib.StopDecompressor();
+            return valid && written == out.size();
+        }
+    } // namespace
+
+    uint64_t MeshFile::Write(const char* path, const MeshData& mesh, const MeshFileWriteSettings& settings)
+    {
+        return Write(path, mesh.GetStreams(), mesh.use16BitIndices, settings);
+    }
+
+    uint64_t MeshFile::Write(const char* path, const MeshStreams& mesh, bool use16BitIndices, const MeshFileWriteSettings& settings)
+    {
+        IO::FileIOBase* fileIO = IO::FileIOBase::GetInstance();
+        if (!fileIO)
+        {
+            return 0;
+        }
+
+        MeshFileHeader header;
+        header.magic = Magic;
+        header.formatVersion = FormatVersion;
+        header.headerBytes = sizeof(MeshFileHeader);
+        header.flags = use16BitIndices ? MeshFileHeader::Use16BitIndices : 0;
+        header.generatorVersion = settings.generatorVersion;
+        header.key = settings.key;
+        header.lastAccess = settings.lastAccess;
+
+        AZStd::span<const uint8_t> bytes[StreamCount];
+        GetStreamBytes(mesh, bytes);
+
+        ScopedFile file(path, IO::OpenMode::ModeWrite | IO::OpenMode::ModeBinary);
+        if (!file.IsOpen())
+        {
+            return 0;
+        }
+
+        // The header goes in last, once every stream's place and size are known
+        static constexpr uint8_t Padding[StreamAlignment] = {};
+        AZStd::vector<uint8_t> scratch;
+        uint64_t position = sizeof(MeshFileHeader);
+        bool written = static_cast<bool>(fileIO->Write(file.Get(), &header, sizeof(header)));
+        for (uint32_t i = 0; written && i < StreamCount; ++i)
+        {
+            MeshFileStream& stream = header.streams[i];
+            stream.offset = AlignUp(position, StreamAlignment);
+            stream.elementSize = StreamElementSizes[i];
+            stream.elementCount = bytes[i].size() / stream.elementSize;
+
+            written = position == stream.offset || fileIO->Write(file.Get(), Padding, stream.offset - position);
+            // Empty streams have no blocks to write and are always stored as is
+            if (written && settings.compression == MeshFileCompression::ZLib && !bytes[i].empty() &&
+                bytes[i].size() >= settings.minCompressBytes)
+            {
+                stream.compression = MeshFileCompression::ZLib;
+                stream.storedBytes = WriteCompressed(fileIO, file.Get(), bytes[i], settings.compressionLevel, scratch);
+                written = stream.storedBytes > 0;
+            }
+            else if (written)
+            {
+                stream.storedBytes = bytes[i].size();
+                written = stream.storedBytes == 0 || fileIO->Write(file.Get(), bytes[i].data(), stream.storedBytes);
+            }
+            position = stream.offset + stream.storedBytes;
+        }
+
+        written = written && fileIO->Seek(file.Get(), 0, IO::SeekType::SeekFromStart) &&
+            fileIO->Write(file.Get(), &header, sizeof(header));
+        return written ? position : 0;
+    }
+
+    bool MeshFile::ReadHeader(const char* path, MeshFileHeader& header)
+    {
+        IO::FileIOBase* fileIO = IO::FileIOBase::GetInstance();
+        if (!fileIO)
+        {
+            return false;
+        }
+        ScopedFile file(path, IO::OpenMode::ModeRead | IO::OpenMode::ModeBinary);
+        return file.IsOpen() && fileIO->Read(file.Get(), &header, sizeof(header), true) && IsValidHeader(header);
+    }
+
+    bool MeshFile::WriteLastAccess(const char* path, uint64_t lastAccess)
+    {
+        IO::FileIOBase* fileIO = IO::FileIOBase::GetInstance();
+        if (!fileIO)
+        {
+            return false;
+        }
+        ScopedFile file(path, IO::OpenMode::ModeUpdate | IO::OpenMode::ModeBinary);
+        return file.IsOpen() && fileIO->Seek(file.Get(), offsetof(MeshFileHeader, lastAccess), IO::SeekType::SeekFromStart) &&
+            fileIO->Write(file.Get(), &lastAccess, sizeof(lastAccess));
+    }
+
+    MappedMeshFile::~MappedMeshFile()
+    {
+        Close();
+    }
+
+    MappedMeshFile::MappedMeshFile(MappedMeshFile&& other)
+    {
+        *this = AZStd::move(other);
+    }
+
+    MappedMeshFile& MappedMeshFile::operator=(MappedMeshFile&& other)
+    {
+        if (this != &other)
+        {
+            Close();
+            m_header = other.m_header;
+            m_streams = other.m_streams;
+            m_inflated = AZStd::move(other.m_inflated);
+            m_file = AZStd::move(other.m_file);
+
+            other.m_header = {};
+            other.m_streams = {};
+        }
+        return *this;
+    }
+
+    bool MappedMeshFile::Open(const char* path)
+    {
+        Close();
+
+        if (!m_file.Open(path))
+        {
+            return false;
+        }
+        const uint8_t* data = m_file.GetData();
+        const uint64_t size = m_file.GetSize();
+        // Streams are mostly read front to back by the upload; start paging in ahead of it
+        m_file.WillNeed(0, size);
+
+        MeshFileHeader header;
+        bool valid = size >= sizeof(header);
+        if (valid)
+        {
+            memcpy(&header, data, sizeof(header));
+            valid = IsValidHeader(header);
+        }
+
+        // Reserved up front so inflating a stream never moves the ones before it
+        m_inflated.reserve(MeshFile::StreamCount);
+        const uint8_t* streamBytes[MeshFile::StreamCount] = {};
+        for (uint32_t i = 0; valid && i < MeshFile::StreamCount; ++i)
+        {
+            const MeshFileStream& stream = header.streams[i];
+            valid = stream.elementSize == StreamElementSizes[i] && stream.offset % MeshFile::StreamAlignment == 0 &&
+                stream.offset >= sizeof(header) && stream.offset <= size && stream.storedBytes <= size - stream.offset &&
+                stream.elementCount <= UINT64_MAX / stream.elementSize;
+            if (!valid)
+            {
+                break;
+            }
+
+            const uint64_t rawBytes = stream.elementCount * stream.elementSize;
+            const AZStd::span<const uint8_t> stored(data + stream.offset, static_cast<size_t>(stream.storedBytes));
+            if (stream.compression == MeshFileCompression::None)
+            {
+                valid = stream.storedBytes == rawBytes;
+                streamBytes[i] = stored.data();
+            }
+            else if (stream.compression == MeshFileCompression::ZLib)
+            {
+                m_inflated.push_back({});
+                AZStd::vector<uint8_t>& inflated = m_inflated.back();
+                inflated.resize_no_construct(static_cast<size_t>(rawBytes));
+                valid = ReadCompressed(stored, inflated);
+                streamBytes[i] = inflated.data();
+            }
+            else
+            {
+                valid = false;
+            }
+        }
+
+        if (!valid)
+        {
+            AZ_Warning("CustomGem", false, "%s is not a valid mesh file of format version %u", path, MeshFile::FormatVersion);
+            Close();
+            return false;
+        }
+
+        m_header = header;
+        SetStreamBytes(m_streams, streamBytes, m_header);
+        return true;
+    }
+
+    void MappedMeshFile::Close()
+    {
+        m_file.Close();
+        m_header = {};
+        m_streams = {};
+        m_inflated.clear();
+    }
+
+    void MappedMeshFile::CopyTo(MeshData& mesh) const
+    {
+        mesh.Clear();
+        mesh.use16BitIndices = Uses16BitIndices();
+        mesh.indices.assign(m_streams.indices.begin(), m_streams.indices.end());
+        mesh.indices16.assign(m_streams.indices16.begin(), m_streams.indices16.end());
+        mesh.positions.assign(m_streams.positions.begin(), m_streams.positions.end());
+        mesh.normals.assign(m_streams.normals.begin(), m_streams.normals.end());
+        mesh.tangents.assign(m_streams.tangents.begin(), m_streams.tangents.end());
+        mesh.bitangents.assign(m_streams.bitangents.begin(), m_streams.bitangents.end());
+        mesh.uvs.assign(m_streams.uvs.begin(), m_streams.uvs.end());
+    }
+
+} // namespace CustomGem
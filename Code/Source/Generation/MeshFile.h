@@ -0,0 +1,116 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "MeshUtils.h"
+
+#include <AzCore/std/containers/vector.h>
+
+namespace CustomGem
+{
+    enum class MeshFileCompression : uint32_t
+    {
+        None,
+        //! AZ::ZLib in independent blocks of MeshFile::CompressionBlockBytes
+        ZLib,
+    };
+
+    //! Where one stream lives in a mesh file.
+    struct MeshFileStream
+    {
+        uint64_t offset = 0;        // from the start of the file, a multiple of MeshFile::StreamAlignment
+        uint64_t storedBytes = 0;   // bytes in the file, compressed or not
+        uint64_t elementCount = 0;
+        uint32_t elementSize = 0;
+        MeshFileCompression compression = MeshFileCompression::None;
+    };
+
+    //! Fixed-size header at the start of every mesh file. All fields are little endian.
+    struct MeshFileHeader
+    {
+        static constexpr uint32_t Use16BitIndices = 1 << 0;
+
+        uint32_t magic = 0;
+        uint32_t formatVersion = 0;
+        uint32_t headerBytes = 0;
+        uint32_t flags = 0;
+        //! Caller defined: what produced the streams and a key for the content, 0 when unused
+        uint32_t generatorVersion = 0;
+        uint32_t reserved = 0;
+        uint64_t key = 0;
+        //! Caller defined; ModelDiskCache rewrites it in place on every hit
+        uint64_t lastAccess = 0;
+        MeshFileStream streams[7];  // indices, indices16, positions, normals, tangents, bitangents, uvs
+    };
+
+    struct MeshFileWriteSettings
+    {
+        MeshFileCompression compression = MeshFileCompression::None;
+        //! ZLib level, 1 (fastest) to 9 (smallest)
+        uint32_t compressionLevel = 6;
+        //! Streams below this size, and streams compression does not shrink, are stored as is
+        uint64_t minCompressBytes = 64 * 1024;
+        //! Copied into the header
+        uint32_t generatorVersion = 0;
+        uint64_t key = 0;
+        uint64_t lastAccess = 0;
+    };
+
+    //! Versioned binary container for the streams of a MeshData. Streams are stored back to back
+    //! in the order of MeshStreams, each starting on a StreamAlignment boundary, so an uncompressed
+    //! file can be mapped and its streams used in place without parsing. Paths may use FileIO aliases.
+    struct MeshFile
+    {
+        static constexpr uint32_t Magic = 0x464D4743; // "CGMF"
+        static constexpr uint32_t FormatVersion = 1;
+        static constexpr uint32_t StreamCount = 7;
+        static constexpr uint64_t StreamAlignment = 64;
+        static constexpr uint64_t CompressionBlockBytes = 16 * 1024 * 1024;
+
+        //! Writes mesh to path, replacing the file. Returns the file size, 0 on failure.
+        static uint64_t Write(const char* path, const MeshData& mesh, const MeshFileWriteSettings& settings = {});
+        static uint64_t Write(
+            const char* path, const MeshStreams& mesh, bool use16BitIndices, const MeshFileWriteSettings& settings = {});
+
+        //! Reads and checks only the header; false when the file is missing or not a mesh file of
+        //! this format version.
+        static bool ReadHeader(const char* path, MeshFileHeader& header);
+
+        //! Overwrites the lastAccess field of an existing file without touching the streams.
+        static bool WriteLastAccess(const char* path, uint64_t lastAccess);
+    };
+
+    //! A mesh file mapped read-only into memory. GetStreams() points straight into the mapping
+    //! for uncompressed streams, so reloading a large mesh costs page-ins rather than a copy;
+    //! compressed streams are inflated into buffers owned by this object when it opens.
+    //! The streams stay valid until Close() or destruction.
+    class MappedMeshFile
+    {
+    public:
+        MappedMeshFile() = default;
+        ~MappedMeshFile();
+        MappedMeshFile(MappedMeshFile&& other);
+        MappedMeshFile& operator=(MappedMeshFile&& other);
+        MappedMeshFile(const MappedMeshFile&) = delete;
+        MappedMeshFile& operator=(const MappedMeshFile&) = delete;
+
+        //! Maps path and validates the header and every stream range. Returns false, leaving the
+        //! object closed, on a missing, truncated or corrupt file.
+        bool Open(const char* path);
+        void Close();
+
+        bool IsOpen() const { return m_header.magic == MeshFile::Magic; }
+        const MeshFileHeader& GetHeader() const { return m_header; }
+        const MeshStreams& GetStreams() const { return m_streams; }
+        bool Uses16BitIndices() const { return (m_header.flags & MeshFileHeader::Use16BitIndices) != 0; }
+
+        //! Copies the streams into mesh, for callers that need to own or modify them.
+        void CopyTo(MeshData& mesh) const;
+
+    private:
+        MappedFile m_file;
+        MeshFileHeader m_header;
+        MeshStreams m_streams;
+        //! Inflated compressed streams
+        AZStd::vector<AZStd::vector<uint8_t>> m_inflated;
+    };
+} // namespace CustomGem
@@ -0,0 +1,1200 @@
+#include "MeshImporter.h"
+#include "MappedFile.h"
+
+#include <AzCore/Console/IConsole.h>
+#include <AzCore/Jobs/JobCompletion.h>
+#include <AzCore/Jobs/JobContext.h>
+#include <AzCore/Jobs/JobFunction.h>
+#include <AzCore/std/chrono/chrono.h>
+#include <AzCore/std/containers/fixed_vector.h>
+#include <AzCore/std/string/string.h>
+
+#include <cmath>
+#include <cstring>
+
+namespace CustomGem
+{
+    AZ_CVAR(bool, cg_meshImporterVerbose, false, nullptr, AZ::ConsoleFunctorFlags::Null,
+        "Log the vertex and triangle counts and throughput of every mesh import");
+
+    namespace
+    {
+        // ---- Text scanning ----
+
+        inline bool IsBlank(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+
+        inline bool IsDigit(char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        inline const char* SkipBlanks(const char* p, const char* end)
+        {
+            while (p != end && IsBlank(*p))
+            {
+                ++p;
+            }
+            return p;
+        }
+
+        //! End of the line starting at p, excluding the line break
+        inline const char* FindLineEnd(const char* p, const char* end)
+        {
+            const void* lineBreak = memchr(p, '\n', end - p);
+            return lineBreak ? static_cast<const char*>(lineBreak) : end;
+        }
+
+        inline double Pow10(int exponent)
+        {
+            static constexpr double Exact[] = {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+            return exponent < 23 ? Exact[exponent] : std::pow(10.0, exponent);
+        }
+
+        //! Parses a decimal number after optional blanks. Returns the end of the number, or nullptr when
+        //! there is none. The first 19 significant digits are used, which keeps the result within an ulp
+        //! of the correctly rounded float without falling back to strtod on unterminated text.
+        const char* ParseFloat(const char* p, const char* end, float& out)
+        {
+            p = SkipBlanks(p, end);
+            bool negative = false;
+            if (p != end && (*p == '-' || *p == '+'))
+            {
+                negative = *p == '-';
+                ++p;
+            }
+
+            uint64_t mantissa = 0;
+            int digits = 0;
+            int exponent = 0;
+            bool any = false;
+            for (; p != end && IsDigit(*p); ++p)
+            {
+                any = true;
+                if (digits < 19)
+                {
+                    mantissa = mantissa * 10 + (*p - '0');
+                    digits += mantissa != 0 ? 1 : 0;
+                }
+                else
+                {
+                    ++exponent;
+                }
+            }
+            if (p != end && *p == '.')
+            {
+                for (++p; p != end && IsDigit(*p); ++p)
+                {
+                    any = true;
+                    if (digits < 19)
+                    {
+                        mantissa = mantissa * 10 + (*p - '0');
+                        digits += mantissa != 0 ? 1 : 0;
+                        --exponent;
+                    }
+                }
+            }
+            if (!any)
+            {
+                return nullptr;
+            }
+
+            if (p != end && (*p == 'e' || *p == 'E'))
+            {
+                const char* e = p + 1;
+                bool negativeExponent = false;
+                if (e != end && (*e == '-' || *e == '+'))
+                {
+                    negativeExponent = *e == '-';
+                    ++e;
+                }
+                if (e != end && IsDigit(*e))
+                {
+                    int value = 0;
+                    for (; e != end && IsDigit(*e); ++e)
+                    {
+                        value = AZStd::min(value * 10 + (*e - '0'), 1000);
+                    }
+                    exponent += negativeExponent ? -value : value;
+                    p = e;
+                }
+            }
+
+            double value = static_cast<double>(mantissa);
+            if (mantissa != 0 && exponent != 0)
+            {
+                value = exponent < 0 ? value / Pow10(-exponent) : value * Pow10(exponent);
+            }
+            out = static_cast<float>(negative ? -value : value);
+            return p;
+        }
+
+        //! Parses a decimal integer; returns its end or nullptr
+        const char* ParseInt(const char* p, const char* end, int64_t& out)
+        {
+            bool negative = false;
+            if (p != end && (*p == '-' || *p == '+'))
+            {
+                negative = *p == '-';
+                ++p;
+            }
+            if (p == end || !IsDigit(*p))
+            {
+                return nullptr;
+            }
+            int64_t value = 0;
+            for (; p != end && IsDigit(*p); ++p)
+            {
+                value = AZStd::min<int64_t>(value * 10 + (*p - '0'), INT64_C(1) << 50);
+            }
+            out = negative ? -value : value;
+            return p;
+        }
+
+        //! [begin, end) offsets of chunks of about chunkBytes, each ending after a line break
+        AZStd::vector<AZStd::pair<uint64_t, uint64_t>> SplitLines(const char* text, uint64_t begin, uint64_t end, size_t chunkBytes)
+        {
+            AZStd::vector<AZStd::pair<uint64_t, uint64_t>> chunks;
+            while (begin < end)
+            {
+                uint64_t split = end;
+                if (end - begin > chunkBytes)
+                {
+                    const char* lineEnd = FindLineEnd(text + begin + chunkBytes, text + end);
+                    split = AZStd::min<uint64_t>(lineEnd - text + 1, end);
+                }
+                chunks.emplace_back(begin, split);
+                begin = split;
+            }
+            return chunks;
+        }
+
+        //! Runs job(i) for i in [0, count) on the job system and waits for all of them
+        template<typename Function>
+        void RunJobs(size_t count, AZ::JobContext* jobContext, const Function& job)
+        {
+            if (count == 1)
+            {
+                job(0);
+                return;
+            }
+            AZ::JobCompletion completion(jobContext);
+            for (size_t i = 0; i < count; ++i)
+            {
+                AZ::Job* parseJob = AZ::CreateJobFunction([&job, i]() { job(i); }, true, jobContext);
+                parseJob->SetDependent(&completion);
+                parseJob->Start();
+            }
+            completion.StartAndWaitForCompletion();
+        }
+
+        //! Parses chunks in windows of chunksInFlight: parse runs on the job system, then merge runs
+        //! on this thread in file order, then the window's pages are released.
+        template<typename Chunk, typename Parse, typename Merge>
+        bool ParseChunked(
+            const MappedFile& file,
+            const AZStd::vector<AZStd::pair<uint64_t, uint64_t>>& ranges,
+            const MeshImportSettings& settings,
+            const Parse& parse,
+            const Merge& merge)
+        {
+            const size_t window = AZStd::max<size_t>(settings.chunksInFlight, 1);
+            AZStd::vector<Chunk> chunks(AZStd::min(window, ranges.size()));
+            for (size_t first = 0; first < ranges.size(); first += window)
+            {
+                const size_t count = AZStd::min(window, ranges.size() - first);
+                const uint64_t windowBegin = ranges[first].first;
+                const uint64_t windowEnd = ranges[first + count - 1].second;
+                file.WillNeed(windowBegin, windowEnd - windowBegin);
+
+                RunJobs(count, settings.jobContext, [&](size_t i)
+                {
+                    chunks[i] = Chunk();
+                    parse(ranges[first + i].first, ranges[first + i].second, chunks[i]);
+                });
+                for (size_t i = 0; i < count; ++i)
+                {
+                    if (!merge(chunks[i]))
+                    {
+                        return false;
+                    }
+                    chunks[i] = Chunk();
+                }
+                file.DontNeed(windowBegin, windowEnd - windowBegin);
+            }
+            return true;
+        }
+
+        // ---- OBJ ----
+
+        //! Face corner references as written, resolved once the chunk's position in the file is known.
+        //! Absolute references are stored 0-based; negative (relative) ones as RelativeBias plus the
+        //! chunk-local index they point at, which is negative when they point into an earlier chunk.
+        constexpr int64_t MissingReference = -1;
+        constexpr int64_t RelativeBias = INT64_C(1) << 52;
+
+        struct ObjChunk
+        {
+            AZStd::vector<float> positions;
+            AZStd::vector<float> texcoords;
+            AZStd::vector<float> normals;
+            //! position, texcoord, normal reference of each triangle corner
+            AZStd::vector<int64_t> corners;
+            bool malformed = false;
+        };
+
+        struct CornerKey
+        {
+            static constexpr uint32_t Missing = UINT32_MAX;
+
+            uint32_t position = 0;
+            uint32_t texcoord = Missing;
+            uint32_t normal = Missing;
+
+            bool operator==(const CornerKey& other) const
+            {
+                return position == other.position && texcoord == other.texcoord && normal == other.normal;
+            }
+        };
+
+        //! Open addressing map from corner tuples to vertex indices
+        class CornerMap
+        {
+        public:
+            //! Vertex of key, or nextVertex when key is new
+            uint32_t FindOrAdd(const CornerKey& key, uint32_t nextVertex)
+            {
+                if ((m_count + 1) * 2 > m_slots.size())
+                {
+                    Grow();
+                }
+                size_t slot = Hash(key) & (m_slots.size() - 1);
+                while (m_slots[slot].vertex != Empty)
+                {
+                    if (m_slots[slot].key == key)
+                    {
+                        return m_slots[slot].vertex;
+                    }
+                    slot = (slot + 1) & (m_slots.size() - 1);
+                }
+                m_slots[slot] = { key, nextVertex };
+                ++m_count;
+                return nextVertex;
+            }
+
+        private:
+            static constexpr uint32_t Empty = UINT32_MAX;
+
+            struct Slot
+            {
+                CornerKey key;
+                uint32_t vertex = Empty;
+            };
+
+            static size_t Hash(const CornerKey& key)
+            {
+                uint64_t hash = key.position * 0x9E3779B97F4A7C15ull;
+                hash = (hash ^ key.texcoord) * 0xC2B2AE3D27D4EB4Full;
+                hash = (hash ^ key.normal) * 0x165667B19E3779F9ull;
+                return static_cast<size_t>(hash ^ (hash >> 29));
+            }
+
+            void Grow()
+            {
+                AZStd::vector<Slot> old = AZStd::move(m_slots);
+                m_slots = AZStd::vector<Slot>(AZStd::max<size_t>(old.size() * 2, 1024));
+                for (const Slot& entry : old)
+                {
+                    if (entry.vertex != Empty)
+                    {
+                        size_t slot = Hash(entry.key) & (m_slots.size() - 1);
+                        while (m_slots[slot].vertex != Empty)
+                        {
+                            slot = (slot + 1) & (m_slots.size() - 1);
+                        }
+                        m_slots[slot] = entry;
+                    }
+                }
+            }
+
+            AZStd::vector<Slot> m_slots;
+            size_t m_count = 0;
+        };
+
+        //! Parses one "a", "a/b", "a//c" or "a/b/c" corner of an f line
+        const char* ParseObjCorner(const char* p, const char* end, const ObjChunk& chunk, int64_t (&corner)[3])
+        {
+            const size_t localCounts[3] = { chunk.positions.size() / 3, chunk.texcoords.size() / 2, chunk.normals.size() / 3 };
+            for (int part = 0; part < 3; ++part)
+            {
+                corner[part] = MissingReference;
+                if (part > 0)
+                {
+                    if (p == end || *p != '/')
+                    {
+                        continue;
+                    }
+                    ++p;
+                }
+                int64_t value = 0;
+                const char* next = ParseInt(p, end, value);
+                if (!next)
+                {
+                    if (part == 0)
+                    {
+                        return nullptr;
+                    }
+                    continue;
+                }
+                p = next;
+                if (value > 0)
+                {
+                    corner[part] = value - 1;
+                }
+                else if (value < 0)
+                {
+                    corner[part] = RelativeBias + static_cast<int64_t>(localCounts[part]) + value;
+                }
+                else
+                {
+                    return nullptr;
+                }
+            }
+            return p;
+        }
+
+        void ParseObjChunk(const char* text, uint64_t begin, uint64_t end, ObjChunk& chunk)
+        {
+            // Grows to the largest face of the chunk, then is reused for every face
+            AZStd::vector<int64_t> polygon;
+            const char* p = text + begin;
+            const char* const chunkEnd = text + end;
+            while (p < chunkEnd)
+            {
+                const char* lineEnd = FindLineEnd(p, chunkEnd);
+                p = SkipBlanks(p, lineEnd);
+                if (lineEnd - p >= 2 && p[0] == 'v' && IsBlank(p[1]))
+                {
+                    float xyz[3] = {};
+                    const char* q = p + 1;
+                    for (float& value : xyz)
+                    {
+                        q = q ? ParseFloat(q, lineEnd, value) : nullptr;
+                    }
+                    chunk.malformed |= q == nullptr;
+                    chunk.positions.insert(chunk.positions.end(), xyz, xyz + 3);
+                }
+                else if (lineEnd - p >= 3 && p[0] == 'v' && p[1] == 't' && IsBlank(p[2]))
+                {
+                    float uv[2] = {};
+                    const char* q = ParseFloat(p + 2, lineEnd, uv[0]);
+                    chunk.malformed |= q == nullptr;
+                    if (q)
+                    {
+                        // v is optional
+                        ParseFloat(q, lineEnd, uv[1]);
+                    }
+                    chunk.texcoords.insert(chunk.texcoords.end(), uv, uv + 2);
+                }
+                else if (lineEnd - p >= 3 && p[0] == 'v' && p[1] == 'n' && IsBlank(p[2]))
+                {
+                    float xyz[3] = {};
+                    const char* q = p + 2;
+                    for (float& value : xyz)
+                    {
+                        q = q ? ParseFloat(q, lineEnd, value) : nullptr;
+                    }
+                    chunk.malformed |= q == nullptr;
+                    chunk.normals.insert(chunk.normals.end(), xyz, xyz + 3);
+                }
+                else if (lineEnd - p >= 2 && p[0] == 'f' && IsBlank(p[1]))
+                {
+                    polygon.clear();
+                    const char* q = SkipBlanks(p + 1, lineEnd);
+                    while (q != lineEnd)
+                    {
+                        int64_t corner[3];
+                        q = ParseObjCorner(q, lineEnd, chunk, corner);
+                        if (!q)
+                        {
+                            chunk.malformed = true;
+                            break;
+                        }
+                        polygon.insert(polygon.end(), corner, corner + 3);
+                        q = SkipBlanks(q, lineEnd);
+                    }
+
+                    // Fan the polygon into triangles around its first corner
+                    for (size_t corner = 2; q && corner < polygon.size() / 3; ++corner)
+                    {
+                        chunk.corners.insert(chunk.corners.end(), polygon.begin(), polygon.begin() + 3);
+                        chunk.corners.insert(chunk.corners.end(), polygon.begin() + (corner - 1) * 3, polygon.begin() + (corner + 1) * 3);
+                    }
+                }
+                p = lineEnd + 1;
+            }
+        }
+
+        bool ImportObj(const MappedFile& file, MeshData& mesh, const MeshImportSettings& settings, MeshImportStats& stats)
+        {
+            const char* text = reinterpret_cast<const char*>(file.GetData());
+            const auto ranges = SplitLines(text, 0, file.GetSize(), settings.chunkBytes);
+
+            AZStd::vector<float> positions;
+            AZStd::vector<float> texcoords;
+            AZStd::vector<float> normals;
+            AZStd::vector<CornerKey> vertices;
+            AZStd::vector<uint32_t> indices;
+            CornerMap corners;
+            bool malformed = false;
+
+            const bool parsed = ParseChunked<ObjChunk>(file, ranges, settings,
+                [text](uint64_t begin, uint64_t end, ObjChunk& chunk)
+                {
+                    ParseObjChunk(text, begin, end, chunk);
+                },
+                [&](ObjChunk& chunk)
+                {
+                    const int64_t bases[3] = {
+                        static_cast<int64_t>(positions.size() / 3),
+                        static_cast<int64_t>(texcoords.size() / 2),
+                        static_cast<int64_t>(normals.size() / 3) };
+                    positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+                    texcoords.insert(texcoords.end(), chunk.texcoords.begin(), chunk.texcoords.end());
+                    normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+                    malformed |= chunk.malformed;
+
+                    // Resolve and deduplicate the corners in file order
+                    for (size_t i = 0; i < chunk.corners.size(); i += 3)
+                    {
+                        uint32_t resolved[3];
+                        for (int part = 0; part < 3; ++part)
+                        {
+                            int64_t reference = chunk.corners[i + part];
+                            if (reference >= RelativeBias / 2)
+                            {
+                                reference = bases[part] + reference - RelativeBias;
+                            }
+                            if (reference >= static_cast<int64_t>(CornerKey::Missing) || (reference < 0 && reference != MissingReference))
+                            {
+                                return false;
+                            }
+                            resolved[part] = reference == MissingReference ? CornerKey::Missing : static_cast<uint32_t>(reference);
+                        }
+                        if (resolved[0] == CornerKey::Missing)
+                        {
+                            return false;
+                        }
+
+                        const CornerKey key = { resolved[0], resolved[1], resolved[2] };
+                        const uint32_t vertex = corners.FindOrAdd(key, static_cast<uint32_t>(vertices.size()));
+                        if (vertex == vertices.size())
+                        {
+                            if (vertices.size() == CornerKey::Missing - 1)
+                            {
+                                return false;
+                            }
+                            vertices.push_back(key);
+                        }
+                        indices.push_back(vertex);
+                    }
+                    return true;
+                });
+
+            AZ_Warning("CustomGem", !malformed, "Skipped malformed OBJ lines");
+            stats.sourceVertices = positions.size() / 3;
+            stats.corners = indices.size();
+            if (!parsed)
+            {
+                AZ_Warning("CustomGem", false, "OBJ face references a vertex that does not exist");
+                return false;
+            }
+
+            // Forward references are legal in practice, so ranges are checked once everything is read
+            const size_t counts[3] = { positions.size() / 3, texcoords.size() / 2, normals.size() / 3 };
+            bool allTexcoords = !vertices.empty();
+            bool allNormals = !vertices.empty();
+            bool anyTexcoords = false;
+            for (const CornerKey& vertex : vertices)
+            {
+                if (vertex.position >= counts[0] ||
+                    (vertex.texcoord != CornerKey::Missing && vertex.texcoord >= counts[1]) ||
+                    (vertex.normal != CornerKey::Missing && vertex.normal >= counts[2]))
+                {
+                    AZ_Warning("CustomGem", false, "OBJ face references a vertex that does not exist");
+                    return false;
+                }
+                allTexcoords &= vertex.texcoord != CornerKey::Missing;
+                anyTexcoords |= vertex.texcoord != CornerKey::Missing;
+                allNormals &= vertex.normal != CornerKey::Missing;
+            }
+
+            mesh.positions.resize_no_construct(vertices.size() * 3);
+            for (size_t v = 0; v < vertices.size(); ++v)
+            {
+                memcpy(mesh.positions.data() + v * 3, positions.data() + vertices[v].position * 3, sizeof(float) * 3);
+            }
+            positions = {};
+            if (anyTexcoords)
+            {
+                // Corners without a uv get (0, 0)
+                mesh.uvs.resize(vertices.size() * 2, 0.0f);
+                for (size_t v = 0; v < vertices.size(); ++v)
+                {
+                    if (vertices[v].texcoord != CornerKey::Missing)
+                    {
+                        memcpy(mesh.uvs.data() + v * 2, texcoords.data() + vertices[v].texcoord * 2, sizeof(float) * 2);
+                    }
+                }
+                AZ_Warning("CustomGem", allTexcoords, "Some OBJ face corners have no uv, they get (0, 0)");
+            }
+            if (allNormals)
+            {
+                mesh.normals.resize_no_construct(vertices.size() * 3);
+                for (size_t v = 0; v < vertices.size(); ++v)
+                {
+                    memcpy(mesh.normals.data() + v * 3, normals.data() + vertices[v].normal * 3, sizeof(float) * 3);
+                }
+            }
+            mesh.indices = AZStd::move(indices);
+            return true;
+        }
+
+        // ---- PLY ----
+
+        enum class PlyType : uint8_t
+        {
+            Int8,
+            Uint8,
+            Int16,
+            Uint16,
+            Int32,
+            Uint32,
+            Float32,
+            Float64,
+            Invalid,
+        };
+
+        enum class PlyFormat : uint8_t
+        {
+            Ascii,
+            BinaryLittleEndian,
+            BinaryBigEndian,
+        };
+
+        struct PlyProperty
+        {
+            AZStd::string name;
+            PlyType type = PlyType::Invalid;
+            //! Count type of list properties, Invalid for scalars
+            PlyType countType = PlyType::Invalid;
+            //! Byte offset in a binary record of an element without lists
+            uint32_t offset = 0;
+        };
+
+        struct PlyElement
+        {
+            AZStd::string name;
+            uint64_t count = 0;
+            AZStd::vector<PlyProperty> properties;
+            //! Record size when the element has no list properties, 0 otherwise
+            uint32_t stride = 0;
+
+            int FindProperty(AZStd::initializer_list<const char*> names) const
+            {
+                for (const char* name : names)
+                {
+                    for (size_t i = 0; i < properties.size(); ++i)
+                    {
+                        if (properties[i].name == name)
+                        {
+                            return static_cast<int>(i);
+                        }
+                    }
+                }
+                return -1;
+            }
+        };
+
+        PlyType ParsePlyType(AZStd::string_view name)
+        {
+            static constexpr AZStd::pair<const char*, PlyType> Names[] = {
+                { "char", PlyType::Int8 }, { "int8", PlyType::Int8 }, { "uchar", PlyType::Uint8 }, { "uint8", PlyType::Uint8 },
+                { "short", PlyType::Int16 }, { "int16", PlyType::Int16 }, { "ushort", PlyType::Uint16 }, { "uint16", PlyType::Uint16 },
+                { "int", PlyType::Int32 }, { "int32", PlyType::Int32 }, { "uint", PlyType::Uint32 }, { "uint32", PlyType::Uint32 },
+                { "float", PlyType::Float32 }, { "float32", PlyType::Float32 }, { "double", PlyType::Float64 }, { "float64", PlyType::Float64 } };
+            for (const auto& [typeName, type] : Names)
+            {
+                if (name == typeName)
+                {
+                    return type;
+                }
+            }
+            return PlyType::Invalid;
+        }
+
+        inline uint32_t GetPlyTypeSize(PlyType type)
+        {
+            static constexpr uint32_t Sizes[] = { 1, 1, 2, 2, 4, 4, 4, 8, 0 };
+            return Sizes[static_cast<int>(type)];
+        }
+
+        //! Reads one binary value as double, swapping big endian data
+        inline double ReadPlyValue(const uint8_t* p, PlyType type, bool bigEndian)
+        {
+            uint8_t bytes[8];
+            const uint32_t size = GetPlyTypeSize(type);
+            for (uint32_t i = 0; i < size; ++i)
+            {
+                bytes[i] = bigEndian ? p[size - 1 - i] : p[i];
+            }
+            switch (type)
+            {
+            case PlyType::Int8: { int8_t v; memcpy(&v, bytes, 1); return v; }
+            case PlyType::Uint8: return bytes[0];
+            case PlyType::Int16: { int16_t v; memcpy(&v, bytes, 2); return v; }
+            case PlyType::Uint16: { uint16_t v; memcpy(&v, bytes, 2); return v; }
+            case PlyType::Int32: { int32_t v; memcpy(&v, bytes, 4); return v; }
+            case PlyType::Uint32: { uint32_t v; memcpy(&v, bytes, 4); return v; }
+            case PlyType::Float32: { float v; memcpy(&v, bytes, 4); return v; }
+            case PlyType::Float64: { double v; memcpy(&v, bytes, 8); return v; }
+            default: return 0.0;
+            }
+        }
+
+        struct PlyHeader
+        {
+            PlyFormat format = PlyFormat::Ascii;
+            AZStd::vector<PlyElement> elements;
+            uint64_t bodyOffset = 0;
+        };
+
+        bool ParsePlyHeader(const char* text, uint64_t size, PlyHeader& header)
+        {
+            const char* p = text;
+            const char* end = text + size;
+            bool first = true;
+            while (p < end)
+            {
+                const char* lineEnd = FindLineEnd(p, end);
+                AZStd::fixed_vector<AZStd::string_view, 6> words;
+                for (const char* q = SkipBlanks(p, lineEnd); q < lineEnd && words.size() < words.capacity(); q = SkipBlanks(q, lineEnd))
+                {
+                    const char* wordEnd = q;
+                    while (wordEnd < lineEnd && !IsBlank(*wordEnd))
+                    {
+                        ++wordEnd;
+                    }
+                    words.emplace_back(q, wordEnd - q);
+                    q = wordEnd;
+                }
+                p = lineEnd + 1;
+
+                if (first)
+                {
+                    if (words.empty() || words[0] != "ply")
+                    {
+                        return false;
+                    }
+                    first = false;
+                }
+                else if (words.empty() || words[0] == "comment" || words[0] == "obj_info")
+                {
+                    continue;
+                }
+                else if (words[0] == "format" && words.size() >= 2)
+                {
+                    if (words[1] == "ascii")
+                    {
+                        header.format = PlyFormat::Ascii;
+                    }
+                    else if (words[1] == "binary_little_endian")
+                    {
+                        header.format = PlyFormat::BinaryLittleEndian;
+                    }
+                    else if (words[1] == "binary_big_endian")
+                    {
+                        header.format = PlyFormat::BinaryBigEndian;
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                }
+                else if (words[0] == "element" && words.size() >= 3)
+                {
+                    PlyElement element;
+                    element.name = words[1];
+                    int64_t count = 0;
+                    if (!ParseInt(words[2].data(), words[2].data() + words[2].size(), count) || count < 0)
+                    {
+                        return false;
+                    }
+                    element.count = static_cast<uint64_t>(count);
+                    header.elements.push_back(AZStd::move(element));
+                }
+                else if (words[0] == "property" && !header.elements.empty())
+                {
+                    PlyProperty property;
+                    if (words.size() >= 5 && words[1] == "list")
+                    {
+                        property.countType = ParsePlyType(words[2]);
+                        property.type = ParsePlyType(words[3]);
+                        property.name = words[4];
+                        if (property.countType == PlyType::Invalid || property.countType == PlyType::Float32 ||
+                            property.countType == PlyType::Float64)
+                        {
+                            return false;
+                        }
+                    }
+                    else if (words.size() >= 3)
+                    {
+                        property.type = ParsePlyType(words[1]);
+                        property.name = words[2];
+                    }
+                    if (property.type == PlyType::Invalid)
+                    {
+                        return false;
+                    }
+                    header.elements.back().properties.push_back(AZStd::move(property));
+                }
+                else if (words[0] == "end_header")
+                {
+                    header.bodyOffset = p - text;
+                    break;
+                }
+            }
+            if (header.bodyOffset == 0)
+            {
+                return false;
+            }
+
+            for (PlyElement& element : header.elements)
+            {
+                uint32_t offset = 0;
+                bool hasList = false;
+                for (PlyProperty& property : element.properties)
+                {
+                    property.offset = offset;
+                    offset += GetPlyTypeSize(property.type);
+                    hasList |= property.countType != PlyType::Invalid;
+                }
+                element.stride = hasList ? 0 : offset;
+            }
+            return true;
+        }
+
+        //! Where the vertex properties the mesh uses sit in a vertex record
+        struct PlyVertexLayout
+        {
+            int position[3] = { -1, -1, -1 };
+            int normal[3] = { -1, -1, -1 };
+            int uv[2] = { -1, -1 };
+
+            bool HasNormals() const { return normal[0] >= 0 && normal[1] >= 0 && normal[2] >= 0; }
+            bool HasUvs() const { return uv[0] >= 0 && uv[1] >= 0; }
+        };
+
+        PlyVertexLayout GetPlyVertexLayout(const PlyElement& vertex)
+        {
+            PlyVertexLayout layout;
+            layout.position[0] = vertex.FindProperty({ "x" });
+            layout.position[1] = vertex.FindProperty({ "y" });
+            layout.position[2] = vertex.FindProperty({ "z" });
+            layout.normal[0] = vertex.FindProperty({ "nx" });
+            layout.normal[1] = vertex.FindProperty({ "ny" });
+            layout.normal[2] = vertex.FindProperty({ "nz" });
+            layout.uv[0] = vertex.FindProperty({ "u", "s", "texture_u", "texture_s" });
+            layout.uv[1] = vertex.FindProperty({ "v", "t", "texture_v", "texture_t" });
+            return layout;
+        }
+
+        //! Output of one PLY chunk
+        struct PlyChunk
+        {
+            AZStd::vector<float> positions;
+            AZStd::vector<float> normals;
+            AZStd::vector<float> uvs;
+            AZStd::vector<uint32_t> indices;
+            size_t records = 0;
+            bool malformed = false;
+        };
+
+        //! Appends the used properties of one vertex, values[i] being property i
+        void AppendPlyVertex(const PlyVertexLayout& layout, const float* values, PlyChunk& chunk)
+        {
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                chunk.positions.push_back(values[layout.position[axis]]);
+            }
+            if (layout.HasNormals())
+            {
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    chunk.normals.push_back(values[layout.normal[axis]]);
+                }
+            }
+            if (layout.HasUvs())
+            {
+                chunk.uvs.push_back(values[layout.uv[0]]);
+                chunk.uvs.push_back(values[layout.uv[1]]);
+            }
+        }
+
+        //! Fans a polygon into triangles
+        void AppendPlyPolygon(AZStd::span<const int64_t> polygon, uint64_t vertexCount, PlyChunk& chunk)
+        {
+            for (int64_t index : polygon)
+            {
+                if (index < 0 || static_cast<uint64_t>(index) >= vertexCount)
+                {
+                    chunk.malformed = true;
+                    return;
+                }
+            }
+            for (size_t corner = 2; corner < polygon.size(); ++corner)
+            {
+                chunk.indices.push_back(static_cast<uint32_t>(polygon[0]));
+                chunk.indices.push_back(static_cast<uint32_t>(polygon[corner - 1]));
+                chunk.indices.push_back(static_cast<uint32_t>(polygon[corner]));
+            }
+        }
+
+        //! Parses the ascii lines of one element chunk; vertices when layout is set, faces otherwise
+        void ParsePlyAsciiChunk(
+            const char* text, uint64_t begin, uint64_t end, const PlyElement& element, const PlyVertexLayout* layout,
+            int faceList, uint64_t vertexCount, PlyChunk& chunk)
+        {
+            AZStd::vector<float> values(element.properties.size(), 0.0f);
+            AZStd::vector<int64_t> polygon;
+            const char* p = text + begin;
+            const char* const chunkEnd = text + end;
+            while (p < chunkEnd)
+            {
+                const char* lineEnd = FindLineEnd(p, chunkEnd);
+                const char* q = p;
+                for (size_t i = 0; q && i < element.properties.size(); ++i)
+                {
+                    const PlyProperty& property = element.properties[i];
+                    if (property.countType == PlyType::Invalid)
+                    {
+                        q = ParseFloat(q, lineEnd, values[i]);
+                        continue;
+                    }
+
+                    int64_t count = 0;
+                    q = ParseInt(SkipBlanks(q, lineEnd), lineEnd, count);
+                    q = count >= 0 ? q : nullptr;
+                    polygon.clear();
+                    for (int64_t item = 0; q && item < count; ++item)
+                    {
+                        int64_t value = 0;
+                        q = ParseInt(SkipBlanks(q, lineEnd), lineEnd, value);
+                        if (static_cast<int>(i) == faceList)
+                        {
+                            polygon.push_back(value);
+                        }
+                    }
+                    if (q && static_cast<int>(i) == faceList)
+                    {
+                        AppendPlyPolygon(polygon, vertexCount, chunk);
+                    }
+                }
+                if (!q)
+                {
+                    chunk.malformed = true;
+                }
+                else if (layout)
+                {
+                    AppendPlyVertex(*layout, values.data(), chunk);
+                }
+                ++chunk.records;
+                p = lineEnd + 1;
+            }
+        }
+
+        //! Binary vertex records [first, first + count) of a fixed-stride element
+        void ParsePlyBinaryVertices(
+            const uint8_t* records, uint64_t first, uint64_t count, const PlyElement& element, const PlyVertexLayout& layout,
+            bool bigEndian, PlyChunk& chunk)
+        {
+            AZStd::vector<float> values(element.properties.size(), 0.0f);
+            chunk.positions.reserve(count * 3);
+            for (uint64_t record = first; record < first + count; ++record)
+            {
+                const uint8_t* data = records + record * element.stride;
+                for (size_t i = 0; i < element.properties.size(); ++i)
+                {
+                    values[i] = static_cast<float>(ReadPlyValue(data + element.properties[i].offset, element.properties[i].type, bigEndian));
+                }
+                AppendPlyVertex(layout, values.data(), chunk);
+                ++chunk.records;
+            }
+        }
+
+        //! Walks binary records with list properties from p; returns the end, or nullptr when the data runs out.
+        //! The list property faceList of each record is fanned into triangles when it is set.
+        const uint8_t* ParsePlyBinaryLists(
+            const uint8_t* p, const uint8_t* end, const PlyElement& element, int faceList, uint64_t vertexCount,
+            bool bigEndian, PlyChunk& chunk)
+        {
+            AZStd::vector<int64_t> polygon;
+            for (uint64_t record = 0; record < element.count; ++record)
+            {
+                for (size_t i = 0; i < element.properties.size(); ++i)
+                {
+                    const PlyProperty& property = element.properties[i];
+                    if (property.countType == PlyType::Invalid)
+                    {
+                        if (static_cast<uint64_t>(end - p) < GetPlyTypeSize(property.type))
+                        {
+                            return nullptr;
+                        }
+                        p += GetPlyTypeSize(property.type);
+                        continue;
+                    }
+                    if (static_cast<uint64_t>(end - p) < GetPlyTypeSize(property.countType))
+                    {
+                        return nullptr;
+                    }
+                    // Signed and float count types can hold values no list can have
+                    const double countValue = ReadPlyValue(p, property.countType, bigEndian);
+                    if (!(countValue >= 0.0 && countValue <= static_cast<double>(UINT32_MAX)))
+                    {
+                        return nullptr;
+                    }
+                    const uint64_t count = static_cast<uint64_t>(countValue);
+                    p += GetPlyTypeSize(property.countType);
+                    const uint32_t itemSize = GetPlyTypeSize(property.type);
+                    if (static_cast<uint64_t>(end - p) < count * itemSize)
+                    {
+                        return nullptr;
+                    }
+                    if (static_cast<int>(i) == faceList)
+                    {
+                        polygon.clear();
+                        for (uint64_t item = 0; item < count; ++item)
+                        {
+                            polygon.push_back(static_cast<int64_t>(ReadPlyValue(p + item * itemSize, property.type, bigEndian)));
+                        }
+                        AppendPlyPolygon(polygon, vertexCount, chunk);
+                    }
+                    p += count * itemSize;
+                }
+            }
+            chunk.records += element.count;
+            return p;
+        }
+
+        bool ImportPly(const MappedFile& file, MeshData& mesh, const MeshImportSettings& settings, MeshImportStats& stats)
+        {
+            const char* text = reinterpret_cast<const char*>(file.GetData());
+            PlyHeader header;
+            if (!ParsePlyHeader(text, file.GetSize(), header))
+            {
+                AZ_Warning("CustomGem", false, "Not a PLY file or unsupported PLY header");
+                return false;
+            }
+
+            const PlyElement* vertexElement = nullptr;
+            for (const PlyElement& element : header.elements)
+            {
+                vertexElement = element.name == "vertex" ? &element : vertexElement;
+            }
+            if (!vertexElement)
+            {
+                AZ_Warning("CustomGem", false, "PLY file has no vertex element");
+                return false;
+            }
+            const PlyVertexLayout layout = GetPlyVertexLayout(*vertexElement);
+            if (layout.position[0] < 0 || layout.position[1] < 0 || layout.position[2] < 0 ||
+                (header.format != PlyFormat::Ascii && vertexElement->stride == 0))
+            {
+                AZ_Warning("CustomGem", false, "PLY vertex element has no x y z or has list properties");
+                return false;
+            }
+
+            bool malformed = false;
+            auto merge = [&](PlyChunk& chunk)
+            {
+                mesh.positions.insert(mesh.positions.end(), chunk.positions.begin(), chunk.positions.end());
+                mesh.normals.insert(mesh.normals.end(), chunk.normals.begin(), chunk.normals.end());
+                mesh.uvs.insert(mesh.uvs.end(), chunk.uvs.begin(), chunk.uvs.end());
+                mesh.indices.insert(mesh.indices.end(), chunk.indices.begin(), chunk.indices.end());
+                malformed |= chunk.malformed;
+                return true;
+            };
+
+            const bool bigEndian = header.format == PlyFormat::BinaryBigEndian;
+            const uint64_t size = file.GetSize();
+            uint64_t offset = header.bodyOffset;
+            for (const PlyElement& element : header.elements)
+            {
+                const bool isVertex = &element == vertexElement;
+                const int faceList = element.name == "face" ? element.FindProperty({ "vertex_indices", "vertex_index" }) : -1;
+
+                if (header.format == PlyFormat::Ascii)
+                {
+                    // The element ends after count lines
+                    uint64_t elementEnd = offset;
+                    for (uint64_t line = 0; line < element.count && elementEnd < size; ++line)
+                    {
+                        elementEnd = FindLineEnd(text + elementEnd, text + size) - text + 1;
+                    }
+                    elementEnd = AZStd::min(elementEnd, size);
+                    if (isVertex || faceList >= 0)
+                    {
+                        ParseChunked<PlyChunk>(file, SplitLines(text, offset, elementEnd, settings.chunkBytes), settings,
+                            [&](uint64_t begin, uint64_t end, PlyChunk& chunk)
+                            {
+                                ParsePlyAsciiChunk(
+                                    text, begin, end, element, isVertex ? &layout : nullptr, faceList, vertexElement->count, chunk);
+                            },
+                            merge);
+                    }
+                    offset = elementEnd;
+                }
+                else if (element.stride > 0)
+                {
+                    if (element.count > (size - offset) / element.stride)
+                    {
+                        AZ_Warning("CustomGem", false, "PLY file is truncated or has an invalid list count");
+                        return false;
+                    }
+                    if (isVertex)
+                    {
+                        // Fixed-size records split into ranges of about chunkBytes each
+                        const uint64_t perChunk = AZStd::max<uint64_t>(settings.chunkBytes / element.stride, 1);
+                        AZStd::vector<AZStd::pair<uint64_t, uint64_t>> ranges;
+                        for (uint64_t first = 0; first < element.count; first += perChunk)
+                        {
+                            const uint64_t last = AZStd::min(first + perChunk, element.count);
+                            ranges.emplace_back(offset + first * element.stride, offset + last * element.stride);
+                        }
+                        const uint8_t* records = file.GetData() + offset;
+                        ParseChunked<PlyChunk>(file, ranges, settings,
+                            [&](uint64_t begin, uint64_t end, PlyChunk& chunk)
+                            {
+                                ParsePlyBinaryVertices(records, (begin - offset) / element.stride, (end - begin) / element.stride,
+                                    element, layout, bigEndian, chunk);
+                            },
+                            merge);
+                    }
+                    offset += element.count * element.stride;
+                }
+                else
+                {
+                    // Records with lists have no fixed size; faces are read in one pass
+                    PlyChunk chunk;
+                    const uint8_t* end = ParsePlyBinaryLists(
+                        file.GetData() + offset, file.GetData() + size, element, faceList, vertexElement->count, bigEndian, chunk);
+                    if (!end)
+                    {
+                        AZ_Warning("CustomGem", false, "PLY file is truncated or has an invalid list count");
+                        return false;
+                    }
+                    merge(chunk);
+                    offset = end - file.GetData();
+                }
+            }
+
+            AZ_Warning("CustomGem", !malformed, "Skipped malformed PLY records");
+            const size_t vertexCount = mesh.positions.size() / 3;
+            stats.sourceVertices = vertexCount;
+            stats.corners = mesh.indices.size();
+            if (vertexCount != vertexElement->count)
+            {
+                AZ_Warning("CustomGem", false, "PLY file is truncated");
+                return false;
+            }
+            if (!layout.HasNormals())
+            {
+                mesh.normals.clear();
+            }
+            if (!layout.HasUvs())
+            {
+                mesh.uvs.clear();
+            }
+            return true;
+        }
+
+        MeshImportFormat DetectFormat(AZStd::string_view path)
+        {
+            const size_t dot = path.find_last_of('.');
+            AZStd::string extension(dot == AZStd::string_view::npos ? AZStd::string_view() : path.substr(dot + 1));
+            AZStd::to_lower(extension.begin(), extension.end());
+            if (extension == "obj")
+            {
+                return MeshImportFormat::Obj;
+            }
+            if (extension == "ply")
+            {
+                return MeshImportFormat::Ply;
+            }
+            return MeshImportFormat::Auto;
+        }
+    } // namespace
+
+    bool MeshImporter::Import(const char* path, MeshData& mesh, const MeshImportSettings& settings, MeshImportStats* outStats)
+    {
+        const auto startTime = AZStd::chrono::steady_clock::now();
+        mesh.Clear();
+        mesh.use16BitIndices = false;
+
+        MeshImportStats stats;
+        const MeshImportFormat format = settings.format == MeshImportFormat::Auto ? DetectFormat(path) : settings.format;
+        if (format == MeshImportFormat::Auto)
+        {
+            AZ_Warning("CustomGem", false, "Cannot tell the mesh format of %s from its extension", path);
+            return false;
+        }
+
+        MappedFile file;
+        if (!file.Open(path))
+        {
+            AZ_Warning("CustomGem", false, "Cannot open %s", path);
+            return false;
+        }
+        stats.fileBytes = file.GetSize();
+
+        const bool imported = format == MeshImportFormat::Obj ? ImportObj(file, mesh, settings, stats) : ImportPly(file, mesh, settings, stats);
+        file.Close();
+        if (!imported)
+        {
+            AZ_Warning("CustomGem", false, "Failed to import %s", path);
+            mesh.Clear();
+            return false;
+        }
+
+        const size_t vertexCount = mesh.GetVertexCount();
+        if (mesh.normals.size() != vertexCount * 3 && settings.generateNormals)
+        {
+            MeshUtils::GenerateNormals(mesh);
+            stats.generatedNormals = true;
+        }
+        if (mesh.normals.size() == vertexCount * 3 && settings.generateTangents)
+        {
+            MeshUtils::GenerateTangents(mesh);
+            stats.generatedTangents = true;
+        }
+        mesh.NarrowIndices();
+
+        stats.vertices = vertexCount;
+        stats.triangles = mesh.GetIndexCount() / 3;
+        stats.seconds = AZStd::chrono::duration<double>(AZStd::chrono::steady_clock::now() - startTime).count();
+        if (cg_meshImporterVerbose)
+        {
+            AZ_Printf("CustomGem", "Imported %s: %zu vertices, %zu triangles, %.1f MB/s\n",
+                path, stats.vertices, stats.triangles, stats.GetMegabytesPerSecond());
+        }
+        if (outStats)
+        {
+            *outStats = stats;
+        }
+        return true;
+    }
+} // namespace CustomGem
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "MeshUtils.h"
+
+namespace AZ
+{
+    class JobContext;
+}
+
+namespace CustomGem
+{
+    enum class MeshImportFormat : uint8_t
+    {
+        //! Picked from the file extension
+        Auto,
+        Obj,
+        Ply,
+    };
+
+    struct MeshImportSettings
+    {
+        MeshImportFormat format = MeshImportFormat::Auto;
+        //! Bytes of text one job parses; chunks end on line breaks
+        size_t chunkBytes = 4 * 1024 * 1024;
+        //! Chunks parsed at once before their output is merged and their pages of the mapping are
+        //! released. Parse buffers and the resident part of the file stay around
+        //! chunkBytes x chunksInFlight, however large the file is.
+        uint32_t chunksInFlight = 16;
+        //! Fill in the streams the file does not provide
+        bool generateNormals = true;
+        bool generateTangents = true;
+        //! Job context to run on, nullptr uses the global context
+        AZ::JobContext* jobContext = nullptr;
+    };
+
+    struct MeshImportStats
+    {
+        uint64_t fileBytes = 0;
+        //! OBJ "v" lines or PLY vertex elements
+        size_t sourceVertices = 0;
+        //! Face corners before OBJ vertex tuples are deduplicated
+        size_t corners = 0;
+        size_t vertices = 0;
+        size_t triangles = 0;
+        bool generatedNormals = false;
+        bool generatedTangents = false;
+        double seconds = 0.0;
+
+        double GetMegabytesPerSecond() const { return seconds > 0.0 ? fileBytes / (1024.0 * 1024.0) / seconds : 0.0; }
+    };
+
+    //! Reads triangle meshes from Wavefront OBJ and PLY (ascii, binary little and big endian) files
+    //! into a MeshData for ModelBuilder::CreateModel. The file is mapped rather than read and parsed
+    //! in chunks on the job system, in file order windows of chunksInFlight chunks.
+    //! OBJ: v, vt, vn and f lines, with negative indices and polygons of any size fanned into
+    //! triangles. Every distinct position/uv/normal tuple of the faces becomes one vertex.
+    //! PLY: the vertex element (x y z, nx ny nz, u v / s t / texture_u texture_v) and the face
+    //! element's vertex_indices list; other elements and properties are skipped.
+    //! Malformed ascii lines are skipped with a warning; binary PLY records cannot be resynced, so a
+    //! truncated file or a negative list count fails the import. cg_meshImporterVerbose logs the
+    //! counts and throughput of every import.
+    struct MeshImporter
+    {
+        //! Returns false with a warning when the file cannot be read or is malformed; mesh is then empty.
+        static bool Import(
+            const char* path, MeshData& mesh, const MeshImportSettings& settings = {}, MeshImportStats* stats = nullptr);
+    };
+} // namespace CustomGem
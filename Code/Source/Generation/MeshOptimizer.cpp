@@ -0,0 +1,655 @@
+#include "MeshOptimizer.h"
+
+#include <AzCore/Math/MathUtils.h>
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/containers/fixed_vector.h>
+#include <AzCore/std/sort.h>
+
+#include <cmath>
+#include <cstring>
+
+namespace CustomGem
+{
+    namespace
+    {
+        constexpr uint32_t InvalidIndex = 0xFFFFFFFFu;
+
+        //! One attribute stream taking part in the weld
+        struct WeldStream
+        {
+            AZStd::vector<float>* data;
+            uint32_t components;
+            float epsilon;
+        };
+
+        inline uint32_t HashCell(float value, float epsilon)
+        {
+            if (epsilon > 0.0f)
+            {
+                // Cells are counted in 64 bits, so coordinates far beyond value / epsilon = 2^31 still
+                // get distinct cells. Past +-2^62 cells, and for NaN, the cell is clamped; those values
+                // only need a consistent hash, the comparison decides whether they match.
+                constexpr double CellLimit = 4611686018427387904.0;
+                const double cell = std::floor(static_cast<double>(value) / epsilon);
+                const int64_t index = cell == cell ? static_cast<int64_t>(AZ::GetClamp(cell, -CellLimit, CellLimit)) : 0;
+                const uint64_t bits = static_cast<uint64_t>(index);
+                return static_cast<uint32_t>(bits ^ (bits >> 32));
+            }
+
+            // Exact mode; fold -0 onto +0
+            const float v = value == 0.0f ? 0.0f : value;
+            uint32_t bits;
+            memcpy(&bits, &v, sizeof(bits));
+            return bits;
+        }
+
+        inline uint32_t HashPosition(const float* p, float epsilon)
+        {
+            uint32_t h = HashCell(p[0], epsilon) * 73856093u;
+            h ^= HashCell(p[1], epsilon) * 19349663u;
+            h ^= HashCell(p[2], epsilon) * 83492791u;
+            // Final avalanche so the low bits used by the table are well mixed
+            h ^= h >> 16;
+            h *= 0x7feb352du;
+            h ^= h >> 15;
+            return h;
+        }
+
+        //! Tom Forsyth, "Linear-Speed Vertex Cache Optimisation"
+        namespace Forsyth
+        {
+            constexpr uint32_t CacheSize = 32;
+            constexpr uint32_t MaxValence = 32;
+            constexpr float CacheDecayPower = 1.5f;
+            constexpr float LastTriangleScore = 0.75f;
+            constexpr float ValenceBoostScale = 2.0f;
+            constexpr float ValenceBoostPower = 0.5f;
+
+            struct ScoreTables
+            {
+                float cache[CacheSize + 3];
+                float valence[MaxValence + 1];
+
+                ScoreTables()
+                {
+                    for (uint32_t i = 0; i < CacheSize + 3; ++i)
+                    {
+                        if (i >= CacheSize)
+                        {
+                            cache[i] = 0.0f;
+                        }
+                        else if (i < 3)
+                        {
+                            // The last triangle's vertices get a fixed score so it is not simply repeated
+                            cache[i] = LastTriangleScore;
+                        }
+                        else
+                        {
+                            const float scaler = 1.0f / static_cast<float>(CacheSize - 3);
+                            cache[i] = std::pow(1.0f - static_cast<float>(i - 3) * scaler, CacheDecayPower);
+                        }
+                    }
+
+                    valence[0] = 0.0f;
+                    for (uint32_t i = 1; i <= MaxValence; ++i)
+                    {
+                        valence[i] = ValenceBoostScale * std::pow(static_cast<float>(i), -ValenceBoostPower);
+                    }
+                }
+            };
+
+            inline float VertexScore(const ScoreTables& tables, int32_t cachePosition, uint32_t remaining)
+            {
+                if (remaining == 0)
+                {
+                    return -1.0f;
+                }
+
+                const float cacheScore = cachePosition >= 0 ? tables.cache[cachePosition] : 0.0f;
+                return cacheScore + tables.valence[AZStd::min(remaining, MaxValence)];
+            }
+        } // namespace Forsyth
+
+        inline bool NearlyEqual(const float* a, const float* b, uint32_t components, float epsilon)
+        {
+            for (uint32_t c = 0; c < components; ++c)
+            {
+                if (std::fabs(a[c] - b[c]) > epsilon)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    } // namespace
+
+    WeldStats MeshOptimizer::WeldVertices(MeshData& mesh, const WeldSettings& settings)
+    {
+        WeldStats stats;
+        const size_t vertexCount = mesh.GetVertexCount();
+        stats.verticesBefore = vertexCount;
+        stats.verticesAfter = vertexCount;
+        if (vertexCount == 0)
+        {
+            return stats;
+        }
+
+        AZ_Assert(vertexCount < InvalidIndex, "WeldVertices: too many vertices");
+
+        // Position is always compared; other streams only when present and not skipped
+        AZStd::fixed_vector<WeldStream, 5> streams;
+        streams.push_back({ &mesh.positions, 3, AZStd::max(settings.positionEpsilon, 0.0f) });
+        AZStd::fixed_vector<WeldStream, 5> passive;
+        auto addStream = [&](AZStd::vector<float>& data, uint32_t components, float epsilon)
+        {
+            if (data.size() != vertexCount * components)
+            {
+                return;
+            }
+            (epsilon < 0.0f ? passive : streams).push_back({ &data, components, epsilon });
+        };
+        addStream(mesh.normals, 3, settings.normalEpsilon);
+        addStream(mesh.tangents, 4, settings.tangentEpsilon);
+        addStream(mesh.bitangents, 3, settings.bitangentEpsilon);
+        addStream(mesh.uvs, 2, settings.uvEpsilon);
+
+        // Open addressing table of compacted vertex indices, at most half full
+        size_t tableSize = 1;
+        while (tableSize < vertexCount * 2)
+        {
+            tableSize <<= 1;
+        }
+        const size_t tableMask = tableSize - 1;
+        AZStd::vector<uint32_t> table(tableSize, InvalidIndex);
+        AZStd::vector<uint32_t> remap(vertexCount);
+
+        // Unique vertices are moved down to slot 'unique' as they are found. That slot is never
+        // ahead of the vertex being read, so the data of vertex i is still intact when it is
+        // visited, and table entries always point at compacted data.
+        uint32_t unique = 0;
+        for (size_t i = 0; i < vertexCount; ++i)
+        {
+            const float* position = mesh.positions.data() + i * 3;
+            size_t slot = HashPosition(position, settings.positionEpsilon) & tableMask;
+
+            uint32_t match = InvalidIndex;
+            for (; table[slot] != InvalidIndex; slot = (slot + 1) & tableMask)
+            {
+                const uint32_t candidate = table[slot];
+                bool equal = true;
+                for (const WeldStream& stream : streams)
+                {
+                    const float* data = stream.data->data();
+                    if (!NearlyEqual(data + static_cast<size_t>(candidate) * stream.components, data + i * stream.components, stream.components, stream.epsilon))
+                    {
+                        equal = false;
+                        break;
+                    }
+                }
+
+                if (equal)
+                {
+                    match = candidate;
+                    break;
+                }
+            }
+
+            if (match != InvalidIndex)
+            {
+                remap[i] = match;
+                continue;
+            }
+
+            table[slot] = unique;
+            remap[i] = unique;
+            if (unique != i)
+            {
+                for (const WeldStream& stream : streams)
+                {
+                    float* data = stream.data->data();
+                    memcpy(data + static_cast<size_t>(unique) * stream.components, data + i * stream.components, sizeof(float) * stream.components);
+                }
+                for (const WeldStream& stream : passive)
+                {
+                    float* data = stream.data->data();
+                    memcpy(data + static_cast<size_t>(unique) * stream.components, data + i * stream.components, sizeof(float) * stream.components);
+                }
+            }
+            ++unique;
+        }
+
+        for (uint32_t& index : mesh.indices)
+        {
+            index = remap[index];
+        }
+        for (uint16_t& index : mesh.indices16)
+        {
+            index = static_cast<uint16_t>(remap[index]);
+        }
+
+        for (const WeldStream& stream : streams)
+        {
+            stream.data->resize(static_cast<size_t>(unique) * stream.components);
+        }
+        for (const WeldStream& stream : passive)
+        {
+            stream.data->resize(static_cast<size_t>(unique) * stream.components);
+        }
+
+        stats.verticesAfter = unique;
+        return stats;
+    }
+
+    VertexCacheStats MeshOptimizer::AnalyzeVertexCache(AZStd::span<const uint32_t> indices, size_t vertexCount, uint32_t cacheSize)
+    {
+        VertexCacheStats stats;
+        if (indices.size() < 3 || vertexCount == 0 || cacheSize == 0)
+        {
+            return stats;
+        }
+
+        // FIFO cache: a vertex is resident while fewer than cacheSize misses happened since it was loaded
+        AZStd::vector<uint32_t> loadedAt(vertexCount, 0);
+        AZStd::vector<bool> referenced(vertexCount, false);
+        uint32_t misses = 0;
+        size_t referencedCount = 0;
+        for (uint32_t index : indices)
+        {
+            if (!referenced[index])
+            {
+                referenced[index] = true;
+                ++referencedCount;
+            }
+
+            if (loadedAt[index] == 0 || misses + 1 - loadedAt[index] > cacheSize)
+            {
+                ++misses;
+                loadedAt[index] = misses;
+            }
+        }
+
+        stats.acmr = static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+        stats.atvr = static_cast<float>(misses) / static_cast<float>(referencedCount);
+        return stats;
+    }
+
+    void MeshOptimizer::OptimizeVertexCache(AZStd::span<uint32_t> indices, size_t vertexCount)
+    {
+        using namespace Forsyth;
+        static const ScoreTables s_tables;
+
+        const size_t triangleCount = indices.size() / 3;
+        if (triangleCount < 2)
+        {
+            return;
+        }
+
+        // Vertex -> triangle adjacency; the first 'remaining[v]' entries of each range are the triangles still to emit
+        AZStd::vector<uint32_t> remaining(vertexCount, 0);
+        for (size_t i = 0; i < triangleCount * 3; ++i)
+        {
+            ++remaining[indices[i]];
+        }
+
+        AZStd::vector<uint32_t> adjacencyOffset(vertexCount + 1, 0);
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            adjacencyOffset[v + 1] = adjacencyOffset[v] + remaining[v];
+        }
+
+        AZStd::vector<uint32_t> adjacency(triangleCount * 3);
+        {
+            AZStd::vector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+                }
+            }
+        }
+
+        AZStd::vector<int32_t> cachePosition(vertexCount, -1);
+        AZStd::vector<float> vertexScore(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            vertexScore[v] = VertexScore(s_tables, -1, remaining[v]);
+        }
+
+        AZStd::vector<float> triangleScore(triangleCount);
+        AZStd::vector<bool> emitted(triangleCount, false);
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+        }
+
+        AZStd::vector<uint32_t> output;
+        output.reserve(triangleCount * 3);
+
+        // Cache holds CacheSize entries plus room for the 3 vertices pushed in by the new triangle
+        uint32_t cache[CacheSize + 3];
+        uint32_t cacheCount = 0;
+        uint32_t newCache[CacheSize + 3];
+
+        uint32_t bestTriangle = InvalidIndex;
+        {
+            float bestScore = -1.0f;
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                if (triangleScore[t] > bestScore)
+                {
+                    bestScore = triangleScore[t];
+                    bestTriangle = static_cast<uint32_t>(t);
+                }
+            }
+        }
+
+        size_t scanCursor = 0;
+        for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount)
+        {
+            if (bestTriangle == InvalidIndex)
+            {
+                // Nothing in the cache touches a pending triangle, continue with the next one in input order
+                while (emitted[scanCursor])
+                {
+                    ++scanCursor;
+                }
+                bestTriangle = static_cast<uint32_t>(scanCursor);
+            }
+
+            const uint32_t* triangle = &indices[bestTriangle * 3];
+            emitted[bestTriangle] = true;
+            output.insert(output.end(), triangle, triangle + 3);
+
+            // Drop the triangle from its vertices' pending lists
+            for (size_t k = 0; k < 3; ++k)
+            {
+                const uint32_t v = triangle[k];
+                uint32_t* begin = adjacency.data() + adjacencyOffset[v];
+                uint32_t* end = begin + remaining[v];
+                uint32_t* found = AZStd::find(begin, end, bestTriangle);
+                AZ_Assert(found != end, "OptimizeVertexCache: adjacency out of sync");
+                *found = *(end - 1);
+                --remaining[v];
+            }
+
+            // New cache: the triangle's vertices first, then the previous contents in order
+            uint32_t newCount = 0;
+            for (size_t k = 0; k < 3; ++k)
+            {
+                newCache[newCount++] = triangle[k];
+            }
+            for (uint32_t i = 0; i < cacheCount; ++i)
+            {
+                const uint32_t v = cache[i];
+                if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+                {
+                    newCache[newCount++] = v;
+                }
+            }
+
+            // Rescore every vertex whose position changed and the pending triangles using it
+            for (uint32_t i = 0; i < newCount; ++i)
+            {
+                const uint32_t v = newCache[i];
+                cachePosition[v] = i < CacheSize ? static_cast<int32_t>(i) : -1;
+
+                const float score = VertexScore(s_tables, cachePosition[v], remaining[v]);
+                const float delta = score - vertexScore[v];
+                vertexScore[v] = score;
+
+                const uint32_t* begin = adjacency.data() + adjacencyOffset[v];
+                for (const uint32_t* it = begin; it != begin + remaining[v]; ++it)
+                {
+                    triangleScore[*it] += delta;
+                }
+            }
+
+            cacheCount = AZStd::min(newCount, CacheSize);
+            for (uint32_t i = 0; i < cacheCount; ++i)
+            {
+                cache[i] = newCache[i];
+            }
+
+            // Next triangle: the best pending one among those touching the cache
+            bestTriangle = InvalidIndex;
+            float bestScore = -1.0f;
+            for (uint32_t i = 0; i < cacheCount; ++i)
+            {
+                const uint32_t v = cache[i];
+                const uint32_t* begin = adjacency.data() + adjacencyOffset[v];
+                for (const uint32_t* it = begin; it != begin + remaining[v]; ++it)
+                {
+                    if (triangleScore[*it] > bestScore)
+                    {
+                        bestScore = triangleScore[*it];
+                        bestTriangle = *it;
+                    }
+                }
+            }
+        }
+
+        AZStd::copy(output.begin(), output.end(), indices.begin());
+    }
+
+    void MeshOptimizer::OptimizeOverdraw(
+        AZStd::span<uint32_t> indices, AZStd::span<const float> positions, float threshold, uint32_t cacheSize)
+    {
+        const size_t triangleCount = indices.size() / 3;
+        const size_t vertexCount = positions.size() / 3;
+        if (triangleCount < 2 || vertexCount == 0)
+        {
+            return;
+        }
+
+        const float meshAcmr = AnalyzeVertexCache(indices, vertexCount, cacheSize).acmr;
+
+        // 1) Cluster boundaries. A triangle that misses on all three vertices starts a new cluster
+        //    for free; inside a run, split once the run is at least as cache friendly as the
+        //    threshold allows so sorting the pieces cannot hurt the ACMR beyond it.
+        AZStd::vector<uint32_t> clusterStarts;
+        {
+            AZStd::vector<uint32_t> loadedAt(vertexCount, 0);
+            uint32_t misses = 0;
+            uint32_t runTriangles = 0;
+            uint32_t runMisses = 0;
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                uint32_t triangleMisses = 0;
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    const uint32_t index = indices[t * 3 + k];
+                    if (loadedAt[index] == 0 || misses + 1 - loadedAt[index] > cacheSize)
+                    {
+                        ++misses;
+                        ++triangleMisses;
+                        loadedAt[index] = misses;
+                    }
+                }
+
+                const bool hardBoundary = triangleMisses == 3;
+                const bool softBoundary = runTriangles > 0 &&
+                    static_cast<float>(runMisses) / static_cast<float>(runTriangles) <= meshAcmr * threshold &&
+                    triangleMisses > 1;
+                if (t == 0 || hardBoundary || softBoundary)
+                {
+                    clusterStarts.push_back(static_cast<uint32_t>(t));
+                    runTriangles = 0;
+                    runMisses = 0;
+                }
+                ++runTriangles;
+                runMisses += triangleMisses;
+            }
+        }
+
+        if (clusterStarts.size() < 2)
+        {
+            return;
+        }
+
+        // 2) Sort key per cluster: how far its area weighted centroid sits out along its average normal
+        auto position = [&positions](uint32_t index)
+        {
+            return AZ::Vector3(positions[index * 3], positions[index * 3 + 1], positions[index * 3 + 2]);
+        };
+
+        const size_t clusterCount = clusterStarts.size();
+        AZStd::vector<AZ::Vector3> clusterCentroid(clusterCount, AZ::Vector3::CreateZero());
+        AZStd::vector<AZ::Vector3> clusterNormal(clusterCount, AZ::Vector3::CreateZero());
+        AZ::Vector3 meshCentroid = AZ::Vector3::CreateZero();
+        float meshArea = 0.0f;
+
+        for (size_t c = 0; c < clusterCount; ++c)
+        {
+            const size_t begin = clusterStarts[c];
+            const size_t end = c + 1 < clusterCount ? clusterStarts[c + 1] : triangleCount;
+            float clusterArea = 0.0f;
+            for (size_t t = begin; t < end; ++t)
+            {
+                const AZ::Vector3 p0 = position(indices[t * 3]);
+                const AZ::Vector3 p1 = position(indices[t * 3 + 1]);
+                const AZ::Vector3 p2 = position(indices[t * 3 + 2]);
+                const AZ::Vector3 cross = (p1 - p0).Cross(p2 - p0);
+                const float area = cross.GetLength();
+                const AZ::Vector3 centroid = (p0 + p1 + p2) * (1.0f / 3.0f);
+
+                clusterCentroid[c] += centroid * area;
+                clusterNormal[c] += cross;
+                clusterArea += area;
+            }
+
+            meshCentroid += clusterCentroid[c];
+            meshArea += clusterArea;
+            clusterCentroid[c] *= clusterArea > 0.0f ? 1.0f / clusterArea : 0.0f;
+        }
+        meshCentroid *= meshArea > 0.0f ? 1.0f / meshArea : 0.0f;
+
+        AZStd::vector<float> sortKey(clusterCount);
+        AZStd::vector<uint32_t> order(clusterCount);
+        for (size_t c = 0; c < clusterCount; ++c)
+        {
+            const float normalLength = clusterNormal[c].GetLength();
+            const AZ::Vector3 normal = normalLength > 0.0f ? clusterNormal[c] * (1.0f / normalLength) : AZ::Vector3::CreateZero();
+            sortKey[c] = (clusterCentroid[c] - meshCentroid).Dot(normal);
+            order[c] = static_cast<uint32_t>(c);
+        }
+
+        // 3) Outward facing clusters first; they are the most likely occluders
+        AZStd::stable_sort(order.begin(), order.end(), [&sortKey](uint32_t a, uint32_t b) { return sortKey[a] > sortKey[b]; });
+
+        AZStd::vector<uint32_t> output;
+        output.reserve(triangleCount * 3);
+        for (uint32_t c : order)
+        {
+            const size_t begin = clusterStarts[c];
+            const size_t end = c + 1 < clusterCount ? clusterStarts[c + 1] : triangleCount;
+            output.insert(output.end(), indices.begin() + begin * 3, indices.begin() + end * 3);
+        }
+
+        // 4) Cluster joints can still cost misses the split estimate did not see; keep the input
+        //    order when the sorted list ends up beyond the threshold
+        if (AnalyzeVertexCache(output, vertexCount, cacheSize).acmr > meshAcmr * threshold)
+        {
+            return;
+        }
+        AZStd::copy(output.begin(), output.end(), indices.begin());
+    }
+
+    void MeshOptimizer::OptimizeVertexFetch(MeshData& mesh)
+    {
+        const size_t vertexCount = mesh.GetVertexCount();
+        if (vertexCount == 0)
+        {
+            return;
+        }
+
+        const bool uses16BitIndices = mesh.use16BitIndices;
+        mesh.WidenIndices();
+
+        AZStd::vector<uint32_t> remap(vertexCount, InvalidIndex);
+        uint32_t next = 0;
+        for (uint32_t& index : mesh.indices)
+        {
+            if (remap[index] == InvalidIndex)
+            {
+                remap[index] = next++;
+            }
+            index = remap[index];
+        }
+        for (uint32_t& target : remap)
+        {
+            if (target == InvalidIndex)
+            {
+                target = next++;
+            }
+        }
+
+        auto permute = [&remap, vertexCount](AZStd::vector<float>& data, size_t components)
+        {
+            if (data.size() != vertexCount * components)
+            {
+                return;
+            }
+
+            AZStd::vector<float> reordered(data.size());
+            for (size_t v = 0; v < vertexCount; ++v)
+            {
+                memcpy(reordered.data() + static_cast<size_t>(remap[v]) * components, data.data() + v * components, sizeof(float) * components);
+            }
+            data.swap(reordered);
+        };
+        permute(mesh.positions, 3);
+        permute(mesh.normals, 3);
+        permute(mesh.tangents, 4);
+        permute(mesh.bitangents, 3);
+        permute(mesh.uvs, 2);
+
+        if (uses16BitIndices)
+        {
+            mesh.NarrowIndices();
+        }
+    }
+
+    OptimizeStats MeshOptimizer::Optimize(MeshData& mesh, const OptimizeSettings& settings)
+    {
+        OptimizeStats stats;
+        if (settings.weld)
+        {
+            stats.weld = WeldVertices(mesh, settings.weldSettings);
+        }
+
+        // The reordering stages work on 32-bit indices
+        const bool uses16BitIndices = mesh.use16BitIndices;
+        mesh.WidenIndices();
+
+        const size_t vertexCount = mesh.GetVertexCount();
+        const AZStd::span<uint32_t> indices(mesh.indices.data(), mesh.indices.size());
+
+        stats.initial = AnalyzeVertexCache(indices, vertexCount, settings.cacheSize);
+
+        if (settings.vertexCache)
+        {
+            OptimizeVertexCache(indices, vertexCount);
+        }
+        stats.afterVertexCache = AnalyzeVertexCache(indices, vertexCount, settings.cacheSize);
+
+        if (settings.overdraw)
+        {
+            OptimizeOverdraw(indices, mesh.positions, settings.overdrawThreshold, settings.cacheSize);
+        }
+        stats.afterOverdraw = AnalyzeVertexCache(indices, vertexCount, settings.cacheSize);
+
+        // Fetch order follows the final triangle order and does not change the cache metrics
+        if (settings.vertexFetch)
+        {
+            OptimizeVertexFetch(mesh);
+        }
+
+        if (uses16BitIndices)
+        {
+            mesh.NarrowIndices();
+        }
+        return stats;
+    }
+} // namespace CustomGem
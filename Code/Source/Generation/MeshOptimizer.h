@@ -0,0 +1,84 @@
+#pragma once
+
+#include "MeshUtils.h"
+
+namespace CustomGem
+{
+    //! Tolerances used to decide whether two vertices are the same.
+    //! An epsilon of 0 requires an exact match, a negative epsilon skips the attribute, in which
+    //! case the merged vertex keeps the attribute of the first vertex seen.
+    struct WeldSettings
+    {
+        float positionEpsilon = 1e-5f;
+        float normalEpsilon = 1e-3f;
+        float tangentEpsilon = 1e-3f;
+        float bitangentEpsilon = 1e-3f;
+        float uvEpsilon = 1e-5f;
+    };
+
+    struct WeldStats
+    {
+        size_t verticesBefore = 0;
+        size_t verticesAfter = 0;
+    };
+
+    //! Post-transform vertex cache efficiency of an index buffer, from a simulated FIFO cache.
+    struct VertexCacheStats
+    {
+        float acmr = 0.0f;  // average cache miss ratio: transformed vertices per triangle (0.5 .. 3)
+        float atvr = 0.0f;  // average transform to vertex ratio: transformed vertices per referenced vertex (1 is ideal)
+    };
+
+    //! Optional pre-upload pipeline, run in the order the stages are listed.
+    struct OptimizeSettings
+    {
+        bool weld = false;
+        WeldSettings weldSettings;
+        //! Reorder triangles for post-transform cache hits (Forsyth)
+        bool vertexCache = true;
+        //! Reorder cache friendly triangle clusters front to back to cut overdraw.
+        //! Clusters are only split where that costs no more than overdrawThreshold x the ACMR.
+        bool overdraw = false;
+        float overdrawThreshold = 1.05f;
+        //! Reorder vertices by first use for fetch locality
+        bool vertexFetch = true;
+        //! FIFO size used for the reported metrics
+        uint32_t cacheSize = 16;
+    };
+
+    struct OptimizeStats
+    {
+        WeldStats weld;
+        VertexCacheStats initial;
+        VertexCacheStats afterVertexCache;
+        VertexCacheStats afterOverdraw;
+    };
+
+    struct MeshOptimizer
+    {
+        //! Merge duplicate vertices, remap the indices and compact all attribute streams in one pass.
+        //! Vertices are hashed on their position snapped to a positionEpsilon grid, so two vertices
+        //! closer than epsilon that land in different grid cells stay separate.
+        //! Extra memory is about 12 bytes per vertex and the compaction happens in place.
+        static WeldStats WeldVertices(MeshData& mesh, const WeldSettings& settings = {});
+
+        //! Run the enabled stages of settings on mesh and collect the metrics of every stage.
+        static OptimizeStats Optimize(MeshData& mesh, const OptimizeSettings& settings = {});
+
+        //! Simulate a FIFO post-transform cache of cacheSize entries over the triangle list.
+        static VertexCacheStats AnalyzeVertexCache(AZStd::span<const uint32_t> indices, size_t vertexCount, uint32_t cacheSize = 16);
+
+        //! Reorder triangles for post-transform cache locality (Forsyth, linear speed).
+        static void OptimizeVertexCache(AZStd::span<uint32_t> indices, size_t vertexCount);
+
+        //! Split a cache optimized triangle list into clusters and sort them so the outward facing
+        //! clusters draw first. The sorted order is measured again and dropped in favour of the
+        //! input order when its ACMR exceeds threshold x the input ACMR.
+        static void OptimizeOverdraw(
+            AZStd::span<uint32_t> indices, AZStd::span<const float> positions, float threshold, uint32_t cacheSize = 16);
+
+        //! Renumber vertices in the order the index buffer first uses them and permute all streams.
+        //! Unreferenced vertices move to the end.
+        static void OptimizeVertexFetch(MeshData& mesh);
+    };
+} // namespace CustomGem
@@ -0,0 +1,453 @@
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/sort.h>
+
+#include <cmath>
+
+namespace CustomGem
+{
+    namespace
+    {
+        //! Sum of area weighted plane quadrics; symmetric 4x4, upper triangle stored
+        struct Quadric
+        {
+            double a00 = 0.0, a01 = 0.0, a02 = 0.0, a03 = 0.0;
+            double a11 = 0.0, a12 = 0.0, a13 = 0.0;
+            double a22 = 0.0, a23 = 0.0;
+            double a33 = 0.0;
+            double weight = 0.0;
+
+            void AddPlane(double a, double b, double c, double d, double w)
+            {
+                a00 += w * a * a; a01 += w * a * b; a02 += w * a * c; a03 += w * a * d;
+                a11 += w * b * b; a12 += w * b * c; a13 += w * b * d;
+                a22 += w * c * c; a23 += w * c * d;
+                a33 += w * d * d;
+                weight += w;
+            }
+
+            void Add(const Quadric& other)
+            {
+                a00 += other.a00; a01 += other.a01; a02 += other.a02; a03 += other.a03;
+                a11 += other.a11; a12 += other.a12; a13 += other.a13;
+                a22 += other.a22; a23 += other.a23;
+                a33 += other.a33;
+                weight += other.weight;
+            }
+
+            //! Mean squared distance of p to the accumulated planes
+            double Evaluate(const float* p) const
+            {
+                const double x = p[0];
+                const double y = p[1];
+                const double z = p[2];
+                const double error = a00 * x * x + 2.0 * a01 * x * y + 2.0 * a02 * x * z + 2.0 * a03 * x
+                    + a11 * y * y + 2.0 * a12 * y * z + 2.0 * a13 * y
+                    + a22 * z * z + 2.0 * a23 * z
+                    + a33;
+                return weight > 0.0 ? AZStd::max(error, 0.0) / weight : 0.0;
+            }
+        };
+
+        struct Collapse
+        {
+            uint32_t from;
+            uint32_t to;
+            double cost;
+        };
+
+        inline AZ::Vector3 GetPosition(const AZStd::vector<float>& positions, uint32_t index)
+        {
+            return AZ::Vector3(positions[index * 3], positions[index * 3 + 1], positions[index * 3 + 2]);
+        }
+
+        inline bool SamePosition(const float* a, const float* b)
+        {
+            return a[0] == b[0] && a[1] == b[1] && a[2] == b[2];
+        }
+
+        //! Stream of a mesh with its component count, skipped when it does not cover every vertex
+        struct VertexStream
+        {
+            const float* data;
+            size_t components;
+        };
+
+        //! Merge vertices that repeat a position with the very same attributes, as meshes built
+        //! from separate quads do, and rewrite indices to the merged vertices. Then lock vertices on
+        //! open or non-manifold edges and positions that still carry more than one attribute set
+        //! (uv seams, hard normals). Edges are compared by position so seams do not read as borders.
+        AZStd::vector<bool> MergeDuplicatesAndFindLockedVertices(const MeshData& mesh, AZStd::vector<uint32_t>& indices)
+        {
+            const size_t vertexCount = mesh.GetVertexCount();
+            const AZStd::vector<float>& positions = mesh.positions;
+
+            AZStd::vector<VertexStream> attributes;
+            auto addStream = [&attributes, vertexCount](const AZStd::vector<float>& data, size_t components)
+            {
+                if (data.size() == vertexCount * components)
+                {
+                    attributes.push_back({ data.data(), components });
+                }
+            };
+            addStream(mesh.normals, 3);
+            addStream(mesh.tangents, 4);
+            addStream(mesh.bitangents, 3);
+            addStream(mesh.uvs, 2);
+
+            auto sameAttributes = [&attributes](uint32_t a, uint32_t b)
+            {
+                for (const VertexStream& stream : attributes)
+                {
+                    const float* pa = stream.data + a * stream.components;
+                    const float* pb = stream.data + b * stream.components;
+                    if (!AZStd::equal(pa, pa + stream.components, pb))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            };
+
+            // Sort by position, then by attributes, so equal vertices end up next to each other
+            AZStd::vector<uint32_t> sorted(vertexCount);
+            for (size_t v = 0; v < vertexCount; ++v)
+            {
+                sorted[v] = static_cast<uint32_t>(v);
+            }
+            AZStd::sort(sorted.begin(), sorted.end(), [&positions, &attributes](uint32_t a, uint32_t b)
+            {
+                const float* pa = &positions[a * 3];
+                const float* pb = &positions[b * 3];
+                if (!SamePosition(pa, pb))
+                {
+                    return AZStd::lexicographical_compare(pa, pa + 3, pb, pb + 3);
+                }
+                for (const VertexStream& stream : attributes)
+                {
+                    const float* sa = stream.data + a * stream.components;
+                    const float* sb = stream.data + b * stream.components;
+                    if (!AZStd::equal(sa, sa + stream.components, sb))
+                    {
+                        return AZStd::lexicographical_compare(sa, sa + stream.components, sb, sb + stream.components);
+                    }
+                }
+                return a < b;
+            });
+
+            // Group vertices by exact position and count the distinct attribute sets per group
+            AZStd::vector<uint32_t> merged(vertexCount);
+            AZStd::vector<uint32_t> group(vertexCount);
+            AZStd::vector<uint32_t> groupAttributeSets;
+            for (size_t i = 0; i < vertexCount; ++i)
+            {
+                const uint32_t v = sorted[i];
+                if (i == 0 || !SamePosition(&positions[v * 3], &positions[sorted[i - 1] * 3]))
+                {
+                    groupAttributeSets.push_back(1);
+                    merged[v] = v;
+                }
+                else if (sameAttributes(v, sorted[i - 1]))
+                {
+                    merged[v] = merged[sorted[i - 1]];
+                }
+                else
+                {
+                    ++groupAttributeSets.back();
+                    merged[v] = v;
+                }
+                group[v] = static_cast<uint32_t>(groupAttributeSets.size() - 1);
+            }
+
+            for (uint32_t& index : indices)
+            {
+                index = merged[index];
+            }
+
+            // Count the triangles on every position edge; anything but 2 is a border
+            AZStd::vector<uint64_t> edges;
+            edges.reserve(indices.size());
+            for (size_t t = 0; t + 2 < indices.size(); t += 3)
+            {
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    const uint64_t a = group[indices[t + k]];
+                    const uint64_t b = group[indices[t + (k + 1) % 3]];
+                    edges.push_back(a < b ? (a << 32) | b : (b << 32) | a);
+                }
+            }
+            AZStd::sort(edges.begin(), edges.end());
+
+            AZStd::vector<bool> lockedGroup(groupAttributeSets.size(), false);
+            for (size_t i = 0; i < edges.size();)
+            {
+                size_t end = i + 1;
+                while (end < edges.size() && edges[end] == edges[i])
+                {
+                    ++end;
+                }
+                if (end - i != 2)
+                {
+                    lockedGroup[edges[i] >> 32] = true;
+                    lockedGroup[edges[i] & 0xFFFFFFFFu] = true;
+                }
+                i = end;
+            }
+
+            AZStd::vector<bool> locked(vertexCount);
+            for (size_t v = 0; v < vertexCount; ++v)
+            {
+                locked[v] = groupAttributeSets[group[v]] > 1 || lockedGroup[group[v]];
+            }
+            return locked;
+        }
+
+        //! Whether moving 'from' onto 'to' flips or badly rotates any remaining triangle around 'from'
+        bool CollapseFlips(
+            const AZStd::vector<float>& positions,
+            const AZStd::vector<uint32_t>& indices,
+            const uint32_t* adjacencyBegin,
+            const uint32_t* adjacencyEnd,
+            uint32_t from,
+            uint32_t to)
+        {
+            const AZ::Vector3 target = GetPosition(positions, to);
+            for (const uint32_t* it = adjacencyBegin; it != adjacencyEnd; ++it)
+            {
+                const uint32_t* triangle = &indices[*it * 3];
+                if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+                {
+                    continue; // collapses to a degenerate triangle and is removed
+                }
+
+                AZ::Vector3 corners[3];
+                AZ::Vector3 moved[3];
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    corners[k] = GetPosition(positions, triangle[k]);
+                    moved[k] = triangle[k] == from ? target : corners[k];
+                }
+
+                const AZ::Vector3 before = (corners[1] - corners[0]).Cross(corners[2] - corners[0]);
+                const AZ::Vector3 after = (moved[1] - moved[0]).Cross(moved[2] - moved[0]);
+                if (before.Dot(after) < 0.25f * before.GetLength() * after.GetLength() || after.GetLength() == 0.0f)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void TrimStream(AZStd::vector<float>& data, size_t vertexCount, size_t components)
+        {
+            if (!data.empty())
+            {
+                data.resize(vertexCount * components);
+            }
+        }
+    } // namespace
+
+    SimplifyStats MeshSimplifier::Simplify(const MeshData& source, MeshData& output, const SimplifySettings& settings)
+    {
+        SimplifyStats stats;
+
+        output.Clear();
+        output.use16BitIndices = false;
+        output.indices.assign(source.indices.begin(), source.indices.end());
+        output.indices.insert(output.indices.end(), source.indices16.begin(), source.indices16.end());
+        output.positions = source.positions;
+        output.normals = source.normals;
+        output.tangents = source.tangents;
+        output.bitangents = source.bitangents;
+        output.uvs = source.uvs;
+
+        AZStd::vector<uint32_t>& indices = output.indices;
+        const AZStd::vector<float>& positions = output.positions;
+        const size_t vertexCount = output.GetVertexCount();
+
+        size_t triangleCount = indices.size() / 3;
+        stats.trianglesBefore = triangleCount;
+        const size_t targetTriangles = static_cast<size_t>(static_cast<float>(triangleCount) * AZStd::max(settings.triangleRatio, 0.0f));
+
+        // Error limit in squared distance, relative to the largest extent of the bounds
+        float extent = 0.0f;
+        if (vertexCount > 0)
+        {
+            float boundsMin[3] = { positions[0], positions[1], positions[2] };
+            float boundsMax[3] = { positions[0], positions[1], positions[2] };
+            for (size_t v = 1; v < vertexCount; ++v)
+            {
+                for (size_t c = 0; c < 3; ++c)
+                {
+                    boundsMin[c] = AZStd::min(boundsMin[c], positions[v * 3 + c]);
+                    boundsMax[c] = AZStd::max(boundsMax[c], positions[v * 3 + c]);
+                }
+            }
+            extent = AZStd::max(boundsMax[0] - boundsMin[0], AZStd::max(boundsMax[1] - boundsMin[1], boundsMax[2] - boundsMin[2]));
+        }
+        const double errorLimit = static_cast<double>(settings.maxError) * extent * settings.maxError * extent;
+
+        const AZStd::vector<bool> locked = MergeDuplicatesAndFindLockedVertices(output, indices);
+
+        AZStd::vector<Quadric> quadrics(vertexCount);
+        for (size_t t = 0; t < triangleCount; ++t)
+        {
+            const uint32_t* triangle = &indices[t * 3];
+            const AZ::Vector3 p0 = GetPosition(positions, triangle[0]);
+            const AZ::Vector3 cross = (GetPosition(positions, triangle[1]) - p0).Cross(GetPosition(positions, triangle[2]) - p0);
+            const float length = cross.GetLength();
+            if (length == 0.0f)
+            {
+                continue;
+            }
+
+            const AZ::Vector3 normal = cross * (1.0f / length);
+            const double d = -normal.Dot(p0);
+            for (size_t k = 0; k < 3; ++k)
+            {
+                quadrics[triangle[k]].AddPlane(normal.GetX(), normal.GetY(), normal.GetZ(), d, length * 0.5);
+            }
+        }
+
+        AZStd::vector<uint32_t> adjacencyOffset(vertexCount + 1);
+        AZStd::vector<uint32_t> adjacency;
+        AZStd::vector<Collapse> collapses;
+        AZStd::vector<uint32_t> remap(vertexCount);
+        AZStd::vector<bool> touched(vertexCount);
+        double maxCost = 0.0;
+
+        // Each pass applies the cheapest independent collapses, then rebuilds the topology
+        while (triangleCount > targetTriangles)
+        {
+            AZStd::fill(adjacencyOffset.begin(), adjacencyOffset.end(), 0u);
+            for (size_t i = 0; i < triangleCount * 3; ++i)
+            {
+                ++adjacencyOffset[indices[i] + 1];
+            }
+            for (size_t v = 0; v < vertexCount; ++v)
+            {
+                adjacencyOffset[v + 1] += adjacencyOffset[v];
+            }
+            adjacency.resize(triangleCount * 3);
+            {
+                AZStd::vector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+                for (size_t i = 0; i < triangleCount * 3; ++i)
+                {
+                    adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+                }
+            }
+
+            collapses.clear();
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    const uint32_t a = indices[t * 3 + k];
+                    const uint32_t b = indices[t * 3 + (k + 1) % 3];
+                    if (!locked[a])
+                    {
+                        collapses.push_back({ a, b, quadrics[a].Evaluate(&positions[b * 3]) });
+                    }
+                    if (!locked[b])
+                    {
+                        collapses.push_back({ b, a, quadrics[b].Evaluate(&positions[a * 3]) });
+                    }
+                }
+            }
+            AZStd::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+            for (size_t v = 0; v < vertexCount; ++v)
+            {
+                remap[v] = static_cast<uint32_t>(v);
+            }
+            AZStd::fill(touched.begin(), touched.end(), false);
+
+            const size_t budget = triangleCount - targetTriangles;
+            size_t removed = 0;
+            size_t applied = 0;
+            for (const Collapse& collapse : collapses)
+            {
+                if (collapse.cost > errorLimit || removed >= budget)
+                {
+                    break;
+                }
+                if (touched[collapse.from] || touched[collapse.to])
+                {
+                    continue;
+                }
+
+                const uint32_t* begin = adjacency.data() + adjacencyOffset[collapse.from];
+                const uint32_t* end = adjacency.data() + adjacencyOffset[collapse.from + 1];
+                if (CollapseFlips(positions, indices, begin, end, collapse.from, collapse.to))
+                {
+                    continue;
+                }
+
+                // Freeze the one-ring so later collapses in this pass see valid geometry
+                for (const uint32_t* it = begin; it != end; ++it)
+                {
+                    const uint32_t* triangle = &indices[*it * 3];
+                    bool hasTarget = false;
+                    for (size_t k = 0; k < 3; ++k)
+                    {
+                        touched[triangle[k]] = true;
+                        hasTarget |= triangle[k] == collapse.to;
+                    }
+                    removed += hasTarget ? 1 : 0;
+                }
+
+                remap[collapse.from] = collapse.to;
+                quadrics[collapse.to].Add(quadrics[collapse.from]);
+                maxCost = AZStd::max(maxCost, collapse.cost);
+                ++applied;
+            }
+
+            if (applied == 0)
+            {
+                break;
+            }
+
+            size_t write = 0;
+            for (size_t t = 0; t < triangleCount; ++t)
+            {
+                const uint32_t a = remap[indices[t * 3]];
+                const uint32_t b = remap[indices[t * 3 + 1]];
+                const uint32_t c = remap[indices[t * 3 + 2]];
+                if (a != b && b != c && a != c)
+                {
+                    indices[write++] = a;
+                    indices[write++] = b;
+                    indices[write++] = c;
+                }
+            }
+            indices.resize(write);
+            triangleCount = write / 3;
+        }
+
+        // Drop the vertices nothing references any more
+        MeshOptimizer::OptimizeVertexFetch(output);
+        uint32_t referenced = 0;
+        for (uint32_t index : indices)
+        {
+            referenced = AZStd::max(referenced, index + 1);
+        }
+        TrimStream(output.positions, referenced, 3);
+        TrimStream(output.normals, referenced, 3);
+        TrimStream(output.tangents, referenced, 4);
+        TrimStream(output.bitangents, referenced, 3);
+        TrimStream(output.uvs, referenced, 2);
+
+        if (source.use16BitIndices)
+        {
+            output.NarrowIndices();
+        }
+
+        stats.trianglesAfter = triangleCount;
+        stats.verticesAfter = referenced;
+        stats.error = extent > 0.0f ? static_cast<float>(std::sqrt(maxCost)) / extent : 0.0f;
+        return stats;
+    }
+} // namespace CustomGem
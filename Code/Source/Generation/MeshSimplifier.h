@@ -0,0 +1,37 @@
+#pragma once
+
+#include "MeshUtils.h"
+
+namespace CustomGem
+{
+    //! Stop conditions of MeshSimplifier::Simplify; simplification ends at whichever is hit first.
+    struct SimplifySettings
+    {
+        //! Target triangle count as a fraction of the input triangle count
+        float triangleRatio = 0.5f;
+        //! Largest allowed collapse error, relative to the extent of the mesh bounds (0.01 = 1%)
+        float maxError = 1.0f;
+    };
+
+    struct SimplifyStats
+    {
+        size_t trianglesBefore = 0;
+        size_t trianglesAfter = 0;
+        size_t verticesAfter = 0;
+        //! Largest collapse error that was accepted, relative to the mesh extent
+        float error = 0.0f;
+    };
+
+    //! Quadric error metric (Garland-Heckbert) mesh simplification by half-edge collapses.
+    //! Vertices are only ever moved onto a neighbouring vertex, so every attribute of the output is
+    //! an attribute of the input. Vertices that repeat a position with equal attributes, like the
+    //! corners of meshes built from separate quads, are merged first. Vertices on open borders and
+    //! positions that carry different attributes (UV seams, hard normals) are locked, which keeps
+    //! seams and creases intact.
+    struct MeshSimplifier
+    {
+        //! Simplify source into output. Output gets compacted streams and 32-bit or, if source used
+        //! them, 16-bit indices.
+        static SimplifyStats Simplify(const MeshData& source, MeshData& output, const SimplifySettings& settings = {});
+    };
+} // namespace CustomGem
@@ -0,0 +1,507 @@
+#include "MeshStatistics.h"
+
+#include <AzCore/Jobs/JobCompletion.h>
+#include <AzCore/Jobs/JobContext.h>
+#include <AzCore/Jobs/JobFunction.h>
+#include <AzCore/std/parallel/thread.h>
+
+#include <cstring>
+
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+#include <emmintrin.h>
+#include <immintrin.h>
+#elif AZ_TRAIT_USE_PLATFORM_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace CustomGem
+{
+    namespace
+    {
+        // A float is NaN or infinite when all exponent bits are set
+        constexpr uint32_t ExponentMask = 0x7F800000u;
+
+        inline bool IsFinite(float value)
+        {
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            return (bits & ExponentMask) != ExponentMask;
+        }
+
+        //! Per-level kernels. Bounds takes packed xyz floats (a multiple of 3), skips non-finite
+        //! components, widens mins/maxs and returns the number of non-finite floats it skipped.
+        struct StatisticsKernels
+        {
+            size_t (*bounds)(const float* data, size_t count, float* mins, float* maxs);
+            size_t (*countNonFinite)(const float* data, size_t count);
+            uint32_t (*maxIndex)(const uint32_t* data, size_t count);
+            uint32_t (*maxIndex16)(const uint16_t* data, size_t count);
+        };
+
+        size_t BoundsScalar(const float* data, size_t count, float* mins, float* maxs)
+        {
+            size_t nonFinite = 0;
+            for (size_t i = 0; i + 2 < count; i += 3)
+            {
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    const float value = data[i + axis];
+                    if (!IsFinite(value))
+                    {
+                        ++nonFinite;
+                        continue;
+                    }
+                    mins[axis] = AZStd::min(mins[axis], value);
+                    maxs[axis] = AZStd::max(maxs[axis], value);
+                }
+            }
+            return nonFinite;
+        }
+
+        size_t CountNonFiniteScalar(const float* data, size_t count)
+        {
+            size_t nonFinite = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                nonFinite += IsFinite(data[i]) ? 0 : 1;
+            }
+            return nonFinite;
+        }
+
+        template<typename T>
+        uint32_t MaxIndexScalar(const T* data, size_t count)
+        {
+            T maxIndex = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                maxIndex = AZStd::max(maxIndex, data[i]);
+            }
+            return maxIndex;
+        }
+
+        //! Folds lane accumulators of packed xyz data into mins/maxs; lane p holds axis p % 3
+        //! because every kernel reads whole vertices per iteration.
+        void FoldBoundsLanes(const float* laneMins, const float* laneMaxs, size_t laneCount, float* mins, float* maxs)
+        {
+            for (size_t lane = 0; lane < laneCount; ++lane)
+            {
+                mins[lane % 3] = AZStd::min(mins[lane % 3], laneMins[lane]);
+                maxs[lane % 3] = AZStd::max(maxs[lane % 3], laneMaxs[lane]);
+            }
+        }
+
+        constexpr StatisticsKernels ScalarKernels = {
+            &BoundsScalar, &CountNonFiniteScalar, &MaxIndexScalar<uint32_t>, &MaxIndexScalar<uint16_t> };
+
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+        //! All-ones in the lanes of v that are NaN or infinite
+        inline __m128i NonFiniteMask(__m128 v)
+        {
+            const __m128i exponent = _mm_set1_epi32(static_cast<int>(ExponentMask));
+            return _mm_cmpeq_epi32(_mm_and_si128(_mm_castps_si128(v), exponent), exponent);
+        }
+
+        inline size_t SumLanes(__m128i counts)
+        {
+            uint32_t lanes[4];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), counts);
+            return static_cast<size_t>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+        }
+
+        // 4 vertices per iteration as [x y z x] [y z x y] [z x y z]; no shuffles until the fold
+        size_t BoundsSse2(const float* data, size_t count, float* mins, float* maxs)
+        {
+            const __m128 highest = _mm_set1_ps(FLT_MAX);
+            const __m128 lowest = _mm_set1_ps(-FLT_MAX);
+            __m128 laneMins[3] = { highest, highest, highest };
+            __m128 laneMaxs[3] = { lowest, lowest, lowest };
+            __m128i nonFinite = _mm_setzero_si128();
+
+            size_t i = 0;
+            for (; i + 12 <= count; i += 12)
+            {
+                for (int j = 0; j < 3; ++j)
+                {
+                    const __m128 v = _mm_loadu_ps(data + i + j * 4);
+                    const __m128i bad = NonFiniteMask(v);
+                    const __m128 skip = _mm_castsi128_ps(bad);
+                    nonFinite = _mm_sub_epi32(nonFinite, bad);
+                    laneMins[j] = _mm_min_ps(laneMins[j], _mm_or_ps(_mm_and_ps(skip, highest), _mm_andnot_ps(skip, v)));
+                    laneMaxs[j] = _mm_max_ps(laneMaxs[j], _mm_or_ps(_mm_and_ps(skip, lowest), _mm_andnot_ps(skip, v)));
+                }
+            }
+
+            float foldMins[12];
+            float foldMaxs[12];
+            for (int j = 0; j < 3; ++j)
+            {
+                _mm_storeu_ps(foldMins + j * 4, laneMins[j]);
+                _mm_storeu_ps(foldMaxs + j * 4, laneMaxs[j]);
+            }
+            FoldBoundsLanes(foldMins, foldMaxs, 12, mins, maxs);
+            return SumLanes(nonFinite) + BoundsScalar(data + i, count - i, mins, maxs);
+        }
+
+        size_t CountNonFiniteSse2(const float* data, size_t count)
+        {
+            __m128i nonFinite = _mm_setzero_si128();
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                nonFinite = _mm_sub_epi32(nonFinite, NonFiniteMask(_mm_loadu_ps(data + i)));
+            }
+            return SumLanes(nonFinite) + CountNonFiniteScalar(data + i, count - i);
+        }
+
+        // SSE2 has no unsigned 32-bit max; flipping the sign bit maps it onto the signed compare
+        uint32_t MaxIndexSse2(const uint32_t* data, size_t count)
+        {
+            const __m128i bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+            __m128i maxBiased = bias;
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), bias);
+                const __m128i greater = _mm_cmpgt_epi32(v, maxBiased);
+                maxBiased = _mm_or_si128(_mm_and_si128(greater, v), _mm_andnot_si128(greater, maxBiased));
+            }
+
+            uint32_t lanes[4];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), _mm_xor_si128(maxBiased, bias));
+            const uint32_t vectorMax = AZStd::max(AZStd::max(lanes[0], lanes[1]), AZStd::max(lanes[2], lanes[3]));
+            return AZStd::max(vectorMax, MaxIndexScalar(data + i, count - i));
+        }
+
+        // Same bias trick on the signed 16-bit max SSE2 does have
+        uint32_t MaxIndex16Sse2(const uint16_t* data, size_t count)
+        {
+            const __m128i bias = _mm_set1_epi16(static_cast<short>(0x8000));
+            __m128i maxBiased = bias;
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                maxBiased = _mm_max_epi16(maxBiased, _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), bias));
+            }
+
+            uint16_t lanes[8];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), _mm_xor_si128(maxBiased, bias));
+            return AZStd::max(MaxIndexScalar(lanes, 8), MaxIndexScalar(data + i, count - i));
+        }
+
+        constexpr StatisticsKernels Sse2Kernels = { &BoundsSse2, &CountNonFiniteSse2, &MaxIndexSse2, &MaxIndex16Sse2 };
+
+        CUSTOMGEM_TARGET_AVX2 inline __m256i NonFiniteMask8(__m256 v)
+        {
+            const __m256i exponent = _mm256_set1_epi32(static_cast<int>(ExponentMask));
+            return _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_castps_si256(v), exponent), exponent);
+        }
+
+        CUSTOMGEM_TARGET_AVX2 inline size_t SumLanes8(__m256i counts)
+        {
+            uint32_t lanes[8];
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), counts);
+            size_t sum = 0;
+            for (uint32_t lane : lanes)
+            {
+                sum += lane;
+            }
+            return sum;
+        }
+
+        // 8 vertices per iteration in three ymm registers, the lane pattern repeating every 3 lanes
+        CUSTOMGEM_TARGET_AVX2 size_t BoundsAvx2(const float* data, size_t count, float* mins, float* maxs)
+        {
+            const __m256 highest = _mm256_set1_ps(FLT_MAX);
+            const __m256 lowest = _mm256_set1_ps(-FLT_MAX);
+            __m256 laneMins[3] = { highest, highest, highest };
+            __m256 laneMaxs[3] = { lowest, lowest, lowest };
+            __m256i nonFinite = _mm256_setzero_si256();
+
+            size_t i = 0;
+            for (; i + 24 <= count; i += 24)
+            {
+                for (int j = 0; j < 3; ++j)
+                {
+                    const __m256 v = _mm256_loadu_ps(data + i + j * 8);
+                    const __m256i bad = NonFiniteMask8(v);
+                    const __m256 skip = _mm256_castsi256_ps(bad);
+                    nonFinite = _mm256_sub_epi32(nonFinite, bad);
+                    laneMins[j] = _mm256_min_ps(laneMins[j], _mm256_blendv_ps(v, highest, skip));
+                    laneMaxs[j] = _mm256_max_ps(laneMaxs[j], _mm256_blendv_ps(v, lowest, skip));
+                }
+            }
+
+            float foldMins[24];
+            float foldMaxs[24];
+            for (int j = 0; j < 3; ++j)
+            {
+                _mm256_storeu_ps(foldMins + j * 8, laneMins[j]);
+                _mm256_storeu_ps(foldMaxs + j * 8, laneMaxs[j]);
+            }
+            const size_t vectorNonFinite = SumLanes8(nonFinite);
+            // The scalar tail is compiled for the baseline, leave the upper halves clean for it
+            _mm256_zeroupper();
+            FoldBoundsLanes(foldMins, foldMaxs, 24, mins, maxs);
+            return vectorNonFinite + BoundsScalar(data + i, count - i, mins, maxs);
+        }
+
+        CUSTOMGEM_TARGET_AVX2 size_t CountNonFiniteAvx2(const float* data, size_t count)
+        {
+            __m256i nonFinite = _mm256_setzero_si256();
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                nonFinite = _mm256_sub_epi32(nonFinite, NonFiniteMask8(_mm256_loadu_ps(data + i)));
+            }
+            const size_t vectorNonFinite = SumLanes8(nonFinite);
+            _mm256_zeroupper();
+            return vectorNonFinite + CountNonFiniteScalar(data + i, count - i);
+        }
+
+        CUSTOMGEM_TARGET_AVX2 uint32_t MaxIndexAvx2(const uint32_t* data, size_t count)
+        {
+            __m256i maxIndex = _mm256_setzero_si256();
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                maxIndex = _mm256_max_epu32(maxIndex, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+            }
+            uint32_t lanes[8];
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), maxIndex);
+            _mm256_zeroupper();
+            return AZStd::max(MaxIndexScalar(lanes, 8), MaxIndexScalar(data + i, count - i));
+        }
+
+        CUSTOMGEM_TARGET_AVX2 uint32_t MaxIndex16Avx2(const uint16_t* data, size_t count)
+        {
+            __m256i maxIndex = _mm256_setzero_si256();
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                maxIndex = _mm256_max_epu16(maxIndex, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+            }
+            uint16_t lanes[16];
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), maxIndex);
+            _mm256_zeroupper();
+            return AZStd::max(MaxIndexScalar(lanes, 16), MaxIndexScalar(data + i, count - i));
+        }
+
+        constexpr StatisticsKernels Avx2Kernels = { &BoundsAvx2, &CountNonFiniteAvx2, &MaxIndexAvx2, &MaxIndex16Avx2 };
+#endif
+
+#if AZ_TRAIT_USE_PLATFORM_SIMD_NEON
+        inline uint32x4_t NonFiniteMaskNeon(float32x4_t v)
+        {
+            const uint32x4_t exponent = vdupq_n_u32(ExponentMask);
+            return vceqq_u32(vandq_u32(vreinterpretq_u32_f32(v), exponent), exponent);
+        }
+
+        inline size_t SumLanesNeon(uint32x4_t counts)
+        {
+            uint32_t lanes[4];
+            vst1q_u32(lanes, counts);
+            return static_cast<size_t>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+        }
+
+        // Same lane layout as the SSE2 kernel
+        size_t BoundsNeon(const float* data, size_t count, float* mins, float* maxs)
+        {
+            const float32x4_t highest = vdupq_n_f32(FLT_MAX);
+            const float32x4_t lowest = vdupq_n_f32(-FLT_MAX);
+            float32x4_t laneMins[3] = { highest, highest, highest };
+            float32x4_t laneMaxs[3] = { lowest, lowest, lowest };
+            uint32x4_t nonFinite = vdupq_n_u32(0);
+
+            size_t i = 0;
+            for (; i + 12 <= count; i += 12)
+            {
+                for (int j = 0; j < 3; ++j)
+                {
+                    const float32x4_t v = vld1q_f32(data + i + j * 4);
+                    const uint32x4_t bad = NonFiniteMaskNeon(v);
+                    nonFinite = vsubq_u32(nonFinite, bad);
+                    laneMins[j] = vminq_f32(laneMins[j], vbslq_f32(bad, highest, v));
+                    laneMaxs[j] = vmaxq_f32(laneMaxs[j], vbslq_f32(bad, lowest, v));
+                }
+            }
+
+            float foldMins[12];
+            float foldMaxs[12];
+            for (int j = 0; j < 3; ++j)
+            {
+                vst1q_f32(foldMins + j * 4, laneMins[j]);
+                vst1q_f32(foldMaxs + j * 4, laneMaxs[j]);
+            }
+            FoldBoundsLanes(foldMins, foldMaxs, 12, mins, maxs);
+            return SumLanesNeon(nonFinite) + BoundsScalar(data + i, count - i, mins, maxs);
+        }
+
+        size_t CountNonFiniteNeon(const float* data, size_t count)
+        {
+            uint32x4_t nonFinite = vdupq_n_u32(0);
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                nonFinite = vsubq_u32(nonFinite, NonFiniteMaskNeon(vld1q_f32(data + i)));
+            }
+            return SumLanesNeon(nonFinite) + CountNonFiniteScalar(data + i, count - i);
+        }
+
+        uint32_t MaxIndexNeon(const uint32_t* data, size_t count)
+        {
+            uint32x4_t maxIndex = vdupq_n_u32(0);
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                maxIndex = vmaxq_u32(maxIndex, vld1q_u32(data + i));
+            }
+            uint32_t lanes[4];
+            vst1q_u32(lanes, maxIndex);
+            return AZStd::max(MaxIndexScalar(lanes, 4), MaxIndexScalar(data + i, count - i));
+        }
+
+        uint32_t MaxIndex16Neon(const uint16_t* data, size_t count)
+        {
+            uint16x8_t maxIndex = vdupq_n_u16(0);
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                maxIndex = vmaxq_u16(maxIndex, vld1q_u16(data + i));
+            }
+            uint16_t lanes[8];
+            vst1q_u16(lanes, maxIndex);
+            return AZStd::max(MaxIndexScalar(lanes, 8), MaxIndexScalar(data + i, count - i));
+        }
+
+        constexpr StatisticsKernels NeonKernels = { &BoundsNeon, &CountNonFiniteNeon, &MaxIndexNeon, &MaxIndex16Neon };
+#endif
+
+        const StatisticsKernels& GetKernels(SimdLevel level)
+        {
+            switch (ClampSimdLevel(level))
+            {
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+            case SimdLevel::Avx2:
+                return Avx2Kernels;
+            case SimdLevel::Sse2:
+                return Sse2Kernels;
+#endif
+#if AZ_TRAIT_USE_PLATFORM_SIMD_NEON
+            case SimdLevel::Neon:
+                return NeonKernels;
+#endif
+            default:
+                return ScalarKernels;
+            }
+        }
+
+        //! Elements [first, first + count) of stream, clamped to its size
+        template<typename T>
+        AZStd::span<const T> Slice(AZStd::span<const T> stream, size_t first, size_t count)
+        {
+            first = AZStd::min(first, stream.size());
+            return stream.subspan(first, AZStd::min(count, stream.size() - first));
+        }
+
+        //! Part `part` of `partCount` equal vertex (and index) ranges of mesh
+        MeshStreams SliceStreams(const MeshStreams& mesh, size_t part, size_t partCount)
+        {
+            const size_t vertexCount = mesh.positions.size() / 3;
+            const size_t indexCount = mesh.indices.size() + mesh.indices16.size();
+            const size_t vertexFirst = vertexCount * part / partCount;
+            const size_t vertices = vertexCount * (part + 1) / partCount - vertexFirst;
+            const size_t indexFirst = indexCount * part / partCount;
+            const size_t indices = indexCount * (part + 1) / partCount - indexFirst;
+
+            MeshStreams slice;
+            slice.indices = Slice(mesh.indices, indexFirst, indices);
+            slice.indices16 = Slice(mesh.indices16, indexFirst, indices);
+            slice.positions = Slice(mesh.positions, vertexFirst * 3, vertices * 3);
+            slice.normals = Slice(mesh.normals, vertexFirst * 3, vertices * 3);
+            slice.tangents = Slice(mesh.tangents, vertexFirst * 4, vertices * 4);
+            slice.bitangents = Slice(mesh.bitangents, vertexFirst * 3, vertices * 3);
+            slice.uvs = Slice(mesh.uvs, vertexFirst * 2, vertices * 2);
+            return slice;
+        }
+
+        MeshStreamStats ComputeSerial(const MeshStreams& mesh, const StatisticsKernels& kernels)
+        {
+            MeshStreamStats stats;
+            stats.nonFinitePositions = kernels.bounds(
+                mesh.positions.data(), mesh.positions.size() - mesh.positions.size() % 3, stats.boundsMin, stats.boundsMax);
+            for (AZStd::span<const float> stream : { mesh.normals, mesh.tangents, mesh.bitangents, mesh.uvs })
+            {
+                stats.nonFiniteAttributes += kernels.countNonFinite(stream.data(), stream.size());
+            }
+            stats.maxIndex = AZStd::max(
+                kernels.maxIndex(mesh.indices.data(), mesh.indices.size()),
+                kernels.maxIndex16(mesh.indices16.data(), mesh.indices16.size()));
+            return stats;
+        }
+    } // namespace
+
+    void MeshStreamStats::Merge(const MeshStreamStats& other)
+    {
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            boundsMin[axis] = AZStd::min(boundsMin[axis], other.boundsMin[axis]);
+            boundsMax[axis] = AZStd::max(boundsMax[axis], other.boundsMax[axis]);
+        }
+        nonFinitePositions += other.nonFinitePositions;
+        nonFiniteAttributes += other.nonFiniteAttributes;
+        maxIndex = AZStd::max(maxIndex, other.maxIndex);
+    }
+
+    MeshStreamStats MeshStatistics::Compute(const MeshStreams& mesh, const MeshStatisticsSettings& settings)
+    {
+        const StatisticsKernels& kernels = GetKernels(settings.level);
+        const size_t vertexCount = mesh.positions.size() / 3;
+
+        size_t partCount = 1;
+        if (settings.verticesPerJob > 0)
+        {
+            const size_t threads = AZStd::max<size_t>(AZStd::thread::hardware_concurrency(), 1);
+            partCount = AZStd::min((vertexCount + settings.verticesPerJob - 1) / settings.verticesPerJob, threads);
+        }
+
+        MeshStreamStats stats;
+        if (partCount <= 1)
+        {
+            stats = ComputeSerial(mesh, kernels);
+        }
+        else
+        {
+            AZStd::vector<MeshStreamStats> parts(partCount);
+            AZ::JobCompletion completion(settings.jobContext);
+            for (size_t part = 0; part < partCount; ++part)
+            {
+                AZ::Job* job = AZ::CreateJobFunction(
+                    [&mesh, &kernels, &parts, part, partCount]()
+                    {
+                        parts[part] = ComputeSerial(SliceStreams(mesh, part, partCount), kernels);
+                    },
+                    true, settings.jobContext);
+                job->SetDependent(&completion);
+                job->Start();
+            }
+            completion.StartAndWaitForCompletion();
+
+            for (const MeshStreamStats& part : parts)
+            {
+                stats.Merge(part);
+            }
+        }
+
+        stats.vertexCount = vertexCount;
+        stats.indexCount = mesh.indices.size() + mesh.indices16.size();
+        return stats;
+    }
+
+    uint32_t MeshStatistics::ComputeMaxIndex(const MeshStreams& mesh, SimdLevel level)
+    {
+        const StatisticsKernels& kernels = GetKernels(level);
+        return AZStd::max(
+            kernels.maxIndex(mesh.indices.data(), mesh.indices.size()),
+            kernels.maxIndex16(mesh.indices16.data(), mesh.indices16.size()));
+    }
+} // namespace CustomGem
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "MeshUtils.h"
+#include "SimdDispatch.h"
+
+#include <AzCore/Math/Aabb.h>
+
+#include <cfloat>
+
+namespace AZ
+{
+    class JobContext;
+}
+
+namespace CustomGem
+{
+    struct MeshStatisticsSettings
+    {
+        //! Kernel to run, clamped to what the CPU supports
+        SimdLevel level = GetSimdLevel();
+        //! Vertices per job when the pass is split across the job system; 0 keeps it on the calling thread
+        size_t verticesPerJob = 1 << 20;
+        //! Job context to run on, nullptr uses the global context
+        AZ::JobContext* jobContext = nullptr;
+    };
+
+    //! Bounds and validation results of one MeshStreams pass.
+    struct MeshStreamStats
+    {
+        size_t vertexCount = 0;
+        size_t indexCount = 0;
+        //! Bounds over the finite position components; an axis without any keeps min > max
+        float boundsMin[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+        float boundsMax[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+        //! NaN or infinite floats in the position stream and in all other float streams
+        size_t nonFinitePositions = 0;
+        size_t nonFiniteAttributes = 0;
+        //! Largest index in the 32-bit or 16-bit index stream
+        uint32_t maxIndex = 0;
+
+        bool HasValidIndices() const { return indexCount == 0 || maxIndex < vertexCount; }
+        bool IsValid() const { return nonFinitePositions == 0 && nonFiniteAttributes == 0 && HasValidIndices(); }
+
+        //! Bounds as an Aabb, null when no position is finite
+        AZ::Aabb GetAabb() const
+        {
+            if (boundsMin[0] > boundsMax[0] || boundsMin[1] > boundsMax[1] || boundsMin[2] > boundsMax[2])
+            {
+                return AZ::Aabb::CreateNull();
+            }
+            return AZ::Aabb::CreateFromMinMax(
+                AZ::Vector3(boundsMin[0], boundsMin[1], boundsMin[2]), AZ::Vector3(boundsMax[0], boundsMax[1], boundsMax[2]));
+        }
+
+        //! Fold in the stats of another part of the same mesh. Counts add up, vertexCount and
+        //! indexCount are left to the caller.
+        void Merge(const MeshStreamStats& other);
+    };
+
+    //! One read-only pass over the streams of a mesh: position bounds, NaN/Inf detection in every
+    //! float stream and the index range check, with the SIMD kernels of SimdDispatch.
+    struct MeshStatistics
+    {
+        //! Meshes above settings.verticesPerJob are split into that many vertices (and the matching
+        //! share of indices) per job and merged on the calling thread.
+        static MeshStreamStats Compute(const MeshStreams& mesh, const MeshStatisticsSettings& settings = {});
+
+        //! Only the index pass of Compute: the largest index in the 32-bit or 16-bit index stream.
+        static uint32_t ComputeMaxIndex(const MeshStreams& mesh, SimdLevel level = GetSimdLevel());
+    };
+} // namespace CustomGem
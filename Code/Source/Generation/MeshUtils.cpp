@@ -0,0 +1,372 @@
+#include "MeshUtils.h"
+#include <algorithm>
+
+#include <AzCore/std/containers/unordered_map.h>
+
+#include <cmath>
+#include <cstring>
+
+namespace CustomGem
+{
+    void MeshUtils::ComputeUvRect(const CustomGem::UVIndex& uv, float& u0, float& v0, float& u1, float& v1)
+    {
+        // Guard against invalid input; fall back to full range
+        if (uv.segment <= 1)
+        {
+            u0 = 0.0f; v0 = 0.0f; u1 = 1.0f; v1 = 1.0f;
+            return;
+        }
+
+        const int seg = uv.segment;
+        const int tiles = seg * seg;
+        int idx = uv.index;
+
+        if (idx < 0) idx = 0;
+        if (idx >= tiles) idx = tiles - 1; // clamp
+
+        const int row = idx / seg; // 0 .. seg-1
+        const int col = idx % seg; // 0 .. seg-1
+
+        const float step = 1.0f / static_cast<float>(seg);
+        u0 = col * step;
+        v0 = row * step;
+        u1 = u0 + step;
+        v1 = v0 + step;
+    }
+
+    void MeshUtils::ComputeUvRect(const CustomGem::UVIndex& uv, float repeatU, float repeatV, float& u0, float& v0, float& u1, float& v1)
+    {
+        ComputeUvRect(uv, u0, v0, u1, v1);
+        u1 = u0 + (u1 - u0) * repeatU;
+        v1 = v0 + (v1 - v0) * repeatV;
+    }
+
+    void MeshUtils::PushVertex(MeshData& m,
+                        const AZ::Vector3& p,
+                        const AZ::Vector3& n,
+                        const AZ::Vector3& t,
+                        const AZ::Vector3& b,
+                        float u, float v)
+    {
+        m.positions.insert(m.positions.end(), { p.GetX(), p.GetY(), p.GetZ() });
+        m.normals.insert(m.normals.end(),   { n.GetX(), n.GetY(), n.GetZ() });
+        // Tangent with handedness w=1
+        m.tangents.insert(m.tangents.end(), { t.GetX(), t.GetY(), t.GetZ(), 1.0f });
+        m.bitangents.insert(m.bitangents.end(), { b.GetX(), b.GetY(), b.GetZ() });
+        m.uvs.insert(m.uvs.end(), { u, v });
+    }
+    
+    void MeshUtils::PushQuad(MeshData& mesh, const AZ::Vector3& corner, int orientation, UVIndex uv)
+    {
+        PushQuad(mesh, corner, orientation, uv, 1.0f, 1.0f);
+    }
+
+    void MeshUtils::PushQuad(MeshData& mesh, const AZ::Vector3& corner, int orientation, UVIndex uv, float width, float height)
+    {
+        QuadDesc quad;
+        quad.corner = corner;
+        quad.orientation = orientation;
+        quad.uv = uv;
+        quad.width = width;
+        quad.height = height;
+        PushQuads(mesh, AZStd::span<const QuadDesc>(&quad, 1));
+    }
+
+    QuadWriter MeshUtils::BeginQuads(MeshData& mesh, size_t quadCount)
+    {
+        const size_t base = mesh.GetVertexCount();
+        AZ_Assert(mesh.normals.size() == base * 3 && mesh.tangents.size() == base * 4 &&
+            mesh.bitangents.size() == base * 3 && mesh.uvs.size() == base * 2,
+            "PushQuads: mesh streams are out of step");
+
+        const size_t vertexCount = base + quadCount * 4;
+        if (mesh.use16BitIndices && vertexCount > MeshData::MaxIndex16 + 1)
+        {
+            mesh.WidenIndices();
+        }
+        const size_t indexBase = mesh.GetIndexCount();
+        const size_t indexCount = indexBase + quadCount * 6;
+        mesh.Reserve(vertexCount, indexCount);
+
+        mesh.positions.resize_no_construct(vertexCount * 3);
+        mesh.normals.resize_no_construct(vertexCount * 3);
+        mesh.tangents.resize_no_construct(vertexCount * 4);
+        mesh.bitangents.resize_no_construct(vertexCount * 3);
+        mesh.uvs.resize_no_construct(vertexCount * 2);
+
+        QuadWriter out;
+        out.positions = mesh.positions.data() + base * 3;
+        out.normals = mesh.normals.data() + base * 3;
+        out.tangents = mesh.tangents.data() + base * 4;
+        out.bitangents = mesh.bitangents.data() + base * 3;
+        out.uvs = mesh.uvs.data() + base * 2;
+        if (mesh.use16BitIndices)
+        {
+            mesh.indices16.resize_no_construct(indexCount);
+            out.indices16 = mesh.indices16.data() + indexBase;
+        }
+        else
+        {
+            mesh.indices.resize_no_construct(indexCount);
+            out.indices = mesh.indices.data() + indexBase;
+        }
+        out.nextVertex = static_cast<uint32_t>(base);
+        return out;
+    }
+
+    void MeshUtils::PushQuads(MeshData& mesh, AZStd::span<const QuadDesc> quads)
+    {
+        if (quads.empty())
+        {
+            return;
+        }
+
+        QuadWriter out = BeginQuads(mesh, quads.size());
+        for (const QuadDesc& quad : quads)
+        {
+            // The runtime orientation picks one of the specialized writers
+            switch (static_cast<Face>(quad.orientation))
+            {
+            case Face::PosZ: WriteQuad<Face::PosZ>(out, quad.corner, quad.uv, quad.width, quad.height); break;
+            case Face::NegZ: WriteQuad<Face::NegZ>(out, quad.corner, quad.uv, quad.width, quad.height); break;
+            case Face::NegX: WriteQuad<Face::NegX>(out, quad.corner, quad.uv, quad.width, quad.height); break;
+            case Face::PosX: WriteQuad<Face::PosX>(out, quad.corner, quad.uv, quad.width, quad.height); break;
+            case Face::PosY: WriteQuad<Face::PosY>(out, quad.corner, quad.uv, quad.width, quad.height); break;
+            case Face::NegY: WriteQuad<Face::NegY>(out, quad.corner, quad.uv, quad.width, quad.height); break;
+            default:
+                AZ_Assert(false, "PushQuad: orientation out of range [0..5]");
+                WriteQuad<Face::PosZ>(out, quad.corner, quad.uv, quad.width, quad.height);
+                break;
+            }
+        }
+    }
+
+    void MeshUtils::PushQuad(MeshData& mesh, const AZ::Vector3& corner, int orientation) {
+        PushQuad(mesh, corner, orientation, {1, 0});
+    }
+
+    namespace
+    {
+        //! Calls triangle(a, b, c) for every triangle whose corners are all valid vertices
+        template<typename Function>
+        void ForEachTriangle(const MeshData& mesh, Function&& triangle)
+        {
+            const size_t vertexCount = mesh.GetVertexCount();
+            auto visit = [&](const auto& indices)
+            {
+                for (size_t i = 0; i + 2 < indices.size(); i += 3)
+                {
+                    const uint32_t a = indices[i + 0];
+                    const uint32_t b = indices[i + 1];
+                    const uint32_t c = indices[i + 2];
+                    if (a < vertexCount && b < vertexCount && c < vertexCount)
+                    {
+                        triangle(a, b, c);
+                    }
+                }
+            };
+            if (mesh.use16BitIndices)
+            {
+                visit(mesh.indices16);
+            }
+            else
+            {
+                visit(mesh.indices);
+            }
+        }
+
+        struct PositionKey
+        {
+            uint32_t bits[3];
+
+            bool operator==(const PositionKey& other) const
+            {
+                return bits[0] == other.bits[0] && bits[1] == other.bits[1] && bits[2] == other.bits[2];
+            }
+        };
+
+        struct PositionKeyHash
+        {
+            size_t operator()(const PositionKey& key) const
+            {
+                uint64_t hash = key.bits[0] * 0x9E3779B97F4A7C15ull;
+                hash = (hash ^ key.bits[1]) * 0xC2B2AE3D27D4EB4Full;
+                hash = (hash ^ key.bits[2]) * 0x165667B19E3779F9ull;
+                return static_cast<size_t>(hash ^ (hash >> 29));
+            }
+        };
+
+        inline void Cross(const float* a, const float* b, float* out)
+        {
+            out[0] = a[1] * b[2] - a[2] * b[1];
+            out[1] = a[2] * b[0] - a[0] * b[2];
+            out[2] = a[0] * b[1] - a[1] * b[0];
+        }
+
+        inline float Dot(const float* a, const float* b)
+        {
+            return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+        }
+
+        //! Normalizes v in place; false, leaving v alone, when it is too short to have a direction
+        inline bool Normalize(float* v)
+        {
+            const float length = std::sqrt(Dot(v, v));
+            if (!(length > 1e-20f))
+            {
+                return false;
+            }
+            for (int i = 0; i < 3; ++i)
+            {
+                v[i] /= length;
+            }
+            return true;
+        }
+    } // namespace
+
+    void MeshUtils::GenerateNormals(MeshData& mesh)
+    {
+        const size_t vertexCount = mesh.GetVertexCount();
+        const float* positions = mesh.positions.data();
+
+        // One accumulator per distinct position
+        AZStd::vector<uint32_t> slotOf(vertexCount);
+        AZStd::unordered_map<PositionKey, uint32_t, PositionKeyHash> slots;
+        slots.reserve(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            PositionKey key;
+            memcpy(key.bits, positions + v * 3, sizeof(key.bits));
+            slotOf[v] = slots.emplace(key, static_cast<uint32_t>(slots.size())).first->second;
+        }
+
+        AZStd::vector<float> sums(slots.size() * 3, 0.0f);
+        ForEachTriangle(mesh, [&](uint32_t a, uint32_t b, uint32_t c)
+        {
+            const float* pa = positions + a * 3;
+            const float* pb = positions + b * 3;
+            const float* pc = positions + c * 3;
+            const float ab[3] = { pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2] };
+            const float ac[3] = { pc[0] - pa[0], pc[1] - pa[1], pc[2] - pa[2] };
+            // Twice the triangle area long, which weights the sum by area
+            float normal[3];
+            Cross(ab, ac, normal);
+            for (uint32_t vertex : { a, b, c })
+            {
+                float* sum = sums.data() + slotOf[vertex] * 3;
+                sum[0] += normal[0];
+                sum[1] += normal[1];
+                sum[2] += normal[2];
+            }
+        });
+
+        mesh.normals.resize_no_construct(vertexCount * 3);
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            float normal[3] = { sums[slotOf[v] * 3 + 0], sums[slotOf[v] * 3 + 1], sums[slotOf[v] * 3 + 2] };
+            if (!Normalize(normal))
+            {
+                normal[0] = 0.0f;
+                normal[1] = 0.0f;
+                normal[2] = 1.0f;
+            }
+            memcpy(mesh.normals.data() + v * 3, normal, sizeof(normal));
+        }
+    }
+
+    void MeshUtils::GenerateTangents(MeshData& mesh)
+    {
+        const size_t vertexCount = mesh.GetVertexCount();
+        AZ_Assert(mesh.normals.size() == vertexCount * 3, "GenerateTangents: the mesh needs normals");
+        if (mesh.normals.size() != vertexCount * 3)
+        {
+            return;
+        }
+        const bool hasUvs = mesh.uvs.size() == vertexCount * 2;
+        const float* positions = mesh.positions.data();
+        const float* uvs = mesh.uvs.data();
+
+        // Directions of growing u and growing v, summed over the triangles of each vertex
+        AZStd::vector<float> uDirections(vertexCount * 3, 0.0f);
+        AZStd::vector<float> vDirections(vertexCount * 3, 0.0f);
+        if (hasUvs)
+        {
+            ForEachTriangle(mesh, [&](uint32_t a, uint32_t b, uint32_t c)
+            {
+                const float* pa = positions + a * 3;
+                const float* pb = positions + b * 3;
+                const float* pc = positions + c * 3;
+                const float e1[3] = { pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2] };
+                const float e2[3] = { pc[0] - pa[0], pc[1] - pa[1], pc[2] - pa[2] };
+                const float du1 = uvs[b * 2 + 0] - uvs[a * 2 + 0];
+                const float dv1 = uvs[b * 2 + 1] - uvs[a * 2 + 1];
+                const float du2 = uvs[c * 2 + 0] - uvs[a * 2 + 0];
+                const float dv2 = uvs[c * 2 + 1] - uvs[a * 2 + 1];
+                const float determinant = du1 * dv2 - du2 * dv1;
+                if (std::fabs(determinant) < 1e-20f)
+                {
+                    return;
+                }
+                const float scale = 1.0f / determinant;
+                float uDirection[3];
+                float vDirection[3];
+                for (int i = 0; i < 3; ++i)
+                {
+                    uDirection[i] = (e1[i] * dv2 - e2[i] * dv1) * scale;
+                    vDirection[i] = (e2[i] * du1 - e1[i] * du2) * scale;
+                }
+                for (uint32_t vertex : { a, b, c })
+                {
+                    for (int i = 0; i < 3; ++i)
+                    {
+                        uDirections[vertex * 3 + i] += uDirection[i];
+                        vDirections[vertex * 3 + i] += vDirection[i];
+                    }
+                }
+            });
+        }
+
+        mesh.tangents.resize_no_construct(vertexCount * 4);
+        mesh.bitangents.resize_no_construct(vertexCount * 3);
+        for (size_t v = 0; v < vertexCount; ++v)
+        {
+            const float* normal = mesh.normals.data() + v * 3;
+            const float* uDirection = uDirections.data() + v * 3;
+
+            // Gram-Schmidt against the normal; fall back to whichever axis is furthest from it
+            const float along = Dot(normal, uDirection);
+            float tangent[3] = { uDirection[0] - normal[0] * along, uDirection[1] - normal[1] * along, uDirection[2] - normal[2] * along };
+            if (!Normalize(tangent))
+            {
+                const float axis[3] = { std::fabs(normal[0]) < 0.9f ? 1.0f : 0.0f, std::fabs(normal[0]) < 0.9f ? 0.0f : 1.0f, 0.0f };
+                const float axisAlong = Dot(normal, axis);
+                for (int i = 0; i < 3; ++i)
+                {
+                    tangent[i] = axis[i] - normal[i] * axisAlong;
+                }
+                if (!Normalize(tangent))
+                {
+                    tangent[0] = 1.0f;
+                    tangent[1] = 0.0f;
+                    tangent[2] = 0.0f;
+                }
+            }
+
+            float bitangent[3];
+            Cross(normal, tangent, bitangent);
+            const float handedness = Dot(bitangent, vDirections.data() + v * 3) < 0.0f ? -1.0f : 1.0f;
+            for (int i = 0; i < 3; ++i)
+            {
+                bitangent[i] *= handedness;
+            }
+
+            float* outTangent = mesh.tangents.data() + v * 4;
+            outTangent[0] = tangent[0];
+            outTangent[1] = tangent[1];
+            outTangent[2] = tangent[2];
+            outTangent[3] = handedness;
+            memcpy(mesh.bitangents.data() + v * 3, bitangent, sizeof(bitangent));
+        }
+    }
+
+}
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <CustomCppToolGem/MeshData.h>
+
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/containers/array.h>
+#include <AzCore/std/containers/span.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/Math/Vector2.h>
+#include <AzCore/Math/Vector3.h>
+
+namespace CustomGem
+{
+    struct UVIndex {
+        int segment;
+        int index;
+    };
+
+    //! Quad orientations; the values match the int orientation PushQuad takes
+    enum class Face : uint8_t
+    {
+        PosZ = 0,
+        NegZ = 1,
+        NegX = 2,
+        PosX = 3,
+        PosY = 4,
+        NegY = 5,
+    };
+
+    constexpr int FaceCount = 6;
+
+    //! Frame of one face. Tangent and bitangent point along the positive world axes of the face's
+    //! plane so uvs grow with world coordinates; where tangent x bitangent points away from the
+    //! normal, flip swaps the index order to keep triangles counter-clockwise around the normal.
+    struct FaceBasis
+    {
+        int normalAxis;     // axis the face looks along
+        int direction;      // +1 or -1 along normalAxis
+        int tangentAxis;    // quad width runs along this axis
+        int bitangentAxis;  // quad height runs along this axis
+        float normal[3];
+        float tangent[3];
+        float bitangent[3];
+        bool flip;
+    };
+
+    constexpr FaceBasis MakeFaceBasis(Face face)
+    {
+        FaceBasis basis = {};
+        switch (face)
+        {
+        case Face::PosZ: basis.normalAxis = 2; basis.direction =  1; break;
+        case Face::NegZ: basis.normalAxis = 2; basis.direction = -1; break;
+        case Face::NegX: basis.normalAxis = 0; basis.direction = -1; break;
+        case Face::PosX: basis.normalAxis = 0; basis.direction =  1; break;
+        case Face::PosY: basis.normalAxis = 1; basis.direction =  1; break;
+        case Face::NegY: basis.normalAxis = 1; basis.direction = -1; break;
+        }
+
+        // XY plane: +X, +Y; YZ plane: +Z, +Y; ZX plane: +X, +Z
+        basis.tangentAxis = basis.normalAxis == 0 ? 2 : 0;
+        basis.bitangentAxis = basis.normalAxis == 1 ? 2 : 1;
+        basis.normal[basis.normalAxis] = static_cast<float>(basis.direction);
+        basis.tangent[basis.tangentAxis] = 1.0f;
+        basis.bitangent[basis.bitangentAxis] = 1.0f;
+
+        const float* t = basis.tangent;
+        const float* b = basis.bitangent;
+        const float cross[3] = { t[1] * b[2] - t[2] * b[1], t[2] * b[0] - t[0] * b[2], t[0] * b[1] - t[1] * b[0] };
+        basis.flip = cross[0] * basis.normal[0] + cross[1] * basis.normal[1] + cross[2] * basis.normal[2] < 0.0f;
+        return basis;
+    }
+
+    //! Bases of all faces, indexed by Face
+    inline constexpr FaceBasis FaceBases[FaceCount] = {
+        MakeFaceBasis(Face::PosZ), MakeFaceBasis(Face::NegZ), MakeFaceBasis(Face::NegX),
+        MakeFaceBasis(Face::PosX), MakeFaceBasis(Face::PosY), MakeFaceBasis(Face::NegY),
+    };
+
+    static_assert(!FaceBases[0].flip && FaceBases[1].flip && !FaceBases[2].flip &&
+        FaceBases[3].flip && FaceBases[4].flip && !FaceBases[5].flip, "Face winding table is off");
+
+    //! Write cursors into mesh streams that were sized for a number of new quads, see MeshUtils::BeginQuads
+    struct QuadWriter
+    {
+        float* positions = nullptr;
+        float* normals = nullptr;
+        float* tangents = nullptr;
+        float* bitangents = nullptr;
+        float* uvs = nullptr;
+        uint32_t* indices = nullptr;    // one of indices / indices16 is set
+        uint16_t* indices16 = nullptr;
+        uint32_t nextVertex = 0;
+    };
+
+    //! One quad for MeshUtils::PushQuads, with the parameters of the matching PushQuad call
+    struct QuadDesc
+    {
+        AZ::Vector3 corner = AZ::Vector3::CreateZero();
+        int orientation = 0;
+        UVIndex uv = { 1, 0 };
+        float width = 1.0f;
+        float height = 1.0f;
+    };
+
+    struct MeshUtils
+    {
+
+        //! Append a quad defined corner and plane
+        //! @param mesh Target mesh data to append to
+        //! @param corner The top left corner of the quad
+        //! @param orientation 0..5 => (+Z), (-Z), (-X), (+X), (+Y), (-Y)
+        //! @param uv segment and index to locate uv
+        //! The quad will be on the plane always be 1x1
+        static void PushQuad(MeshData& mesh, const AZ::Vector3& corner, int orientation, UVIndex uv);
+        // Overloaded for 0.0-1.0 UV
+        static void PushQuad(MeshData& mesh, const AZ::Vector3& corner, int orientation);
+        //! Append a width x height quad, width along the face tangent and height along the bitangent.
+        //! The uv tile repeats width x height times across the quad, see ComputeUvRect.
+        static void PushQuad(MeshData& mesh, const AZ::Vector3& corner, int orientation, UVIndex uv, float width, float height);
+        //! Append many quads at once. Every stream is resized a single time and written in place,
+        //! and the index stream is widened up front when the quads push it past 16-bit range.
+        //! The mesh must carry all vertex streams, as meshes built with PushQuad/PushVertex do.
+        static void PushQuads(MeshData& mesh, AZStd::span<const QuadDesc> quads);
+
+        //! PushQuad with the face fixed at compile time. Basis, winding and the axes the quad
+        //! extends along are constants, so the vertices are written without any lookups.
+        template<Face F>
+        static void PushQuad(MeshData& mesh, const AZ::Vector3& corner, UVIndex uv = { 1, 0 }, float width = 1.0f, float height = 1.0f);
+
+        //! Grow every stream of mesh by quadCount quads and return cursors to the new space.
+        //! Exactly quadCount quads must be written through WriteQuad before the mesh is used again.
+        static QuadWriter BeginQuads(MeshData& mesh, size_t quadCount);
+
+        //! Write one quad of face F at the writer's cursors and advance them
+        template<Face F>
+        static void WriteQuad(QuadWriter& out, const AZ::Vector3& corner, UVIndex uv, float width, float height);
+
+        static void PushVertex(MeshData& m,
+                               const AZ::Vector3& p,
+                               const AZ::Vector3& n,
+                               const AZ::Vector3& t,
+                               const AZ::Vector3& b,
+                               float u, float v);
+
+        static void ComputeUvRect(const CustomGem::UVIndex& uv, float& u0, float& v0, float& u1, float& v1);
+        //! Uv rect for a tile repeated repeatU x repeatV times.
+        //! Without an atlas (segment <= 1) the rect is [0, repeatU] x [0, repeatV] and relies on a wrapping sampler.
+        //! With an atlas the rect starts at the tile origin and extends repeatU/repeatV tile widths, so
+        //! the material has to wrap the coordinates inside the tile (frac(uv * segment)).
+        static void ComputeUvRect(const CustomGem::UVIndex& uv, float repeatU, float repeatV, float& u0, float& v0, float& u1, float& v1);
+
+        //! Replace the normals with area-weighted smooth normals of the triangles around each vertex.
+        //! Vertices with bitwise equal positions share one normal, so uv seams stay smooth.
+        static void GenerateNormals(MeshData& mesh);
+        //! Replace tangents and bitangents with per-vertex ones following the uv gradients of the
+        //! triangles around each vertex, orthogonalized against the normal, with the handedness in
+        //! the tangent's w. Vertices without usable uvs get an arbitrary tangent perpendicular to
+        //! the normal. Requires normals.
+        static void GenerateTangents(MeshData& mesh);
+    };
+
+    template<Face F>
+    void MeshUtils::PushQuad(MeshData& mesh, const AZ::Vector3& corner, UVIndex uv, float width, float height)
+    {
+        QuadWriter out = BeginQuads(mesh, 1);
+        WriteQuad<F>(out, corner, uv, width, height);
+    }
+
+    template<Face F>
+    void MeshUtils::WriteQuad(QuadWriter& out, const AZ::Vector3& corner, UVIndex uv, float width, float height)
+    {
+        constexpr FaceBasis Basis = FaceBases[static_cast<int>(F)];
+
+        // Corners LL, LR (+T), UR (+T +B), UL (+B), expanding from 'corner'
+        float* p = out.positions;
+        for (int i = 0; i < 4; ++i)
+        {
+            p[i * 3 + 0] = corner.GetX();
+            p[i * 3 + 1] = corner.GetY();
+            p[i * 3 + 2] = corner.GetZ();
+        }
+        p[3 + Basis.tangentAxis] += width;
+        p[6 + Basis.tangentAxis] += width;
+        p[6 + Basis.bitangentAxis] += height;
+        p[9 + Basis.bitangentAxis] += height;
+        out.positions += 12;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            out.normals[0] = Basis.normal[0];
+            out.normals[1] = Basis.normal[1];
+            out.normals[2] = Basis.normal[2];
+            // Tangent with handedness w=1
+            out.tangents[0] = Basis.tangent[0];
+            out.tangents[1] = Basis.tangent[1];
+            out.tangents[2] = Basis.tangent[2];
+            out.tangents[3] = 1.0f;
+            out.bitangents[0] = Basis.bitangent[0];
+            out.bitangents[1] = Basis.bitangent[1];
+            out.bitangents[2] = Basis.bitangent[2];
+            out.normals += 3;
+            out.tangents += 4;
+            out.bitangents += 3;
+        }
+
+        // u along +T, v along +B
+        float u0, v0, u1, v1;
+        ComputeUvRect(uv, width, height, u0, v0, u1, v1);
+        out.uvs[0] = u0; out.uvs[1] = v0;
+        out.uvs[2] = u1; out.uvs[3] = v0;
+        out.uvs[4] = u1; out.uvs[5] = v1;
+        out.uvs[6] = u0; out.uvs[7] = v1;
+        out.uvs += 8;
+
+        // CCW around N: LL, LR, UR and LL, UR, UL, or the mirrored order where the basis is flipped
+        const uint32_t base = out.nextVertex;
+        constexpr AZStd::array<uint32_t, 6> Order = Basis.flip
+            ? AZStd::array<uint32_t, 6>{ 0, 2, 1, 0, 3, 2 }
+            : AZStd::array<uint32_t, 6>{ 0, 1, 2, 0, 2, 3 };
+        if (out.indices16)
+        {
+            for (int i = 0; i < 6; ++i)
+            {
+                out.indices16[i] = static_cast<uint16_t>(base + Order[i]);
+            }
+            out.indices16 += 6;
+        }
+        else
+        {
+            for (int i = 0; i < 6; ++i)
+            {
+                out.indices[i] = base + Order[i];
+            }
+            out.indices += 6;
+        }
+        out.nextVertex += 4;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,1252 @@
+#include "ModelBuilder.h"
+#include "BufferPoolRegistry.h"
+#include "MeshFile.h"
+#include "MeshStatistics.h"
+#include "ModelCache.h"
+#include "ModelDiskCache.h"
+#include "VertexCompression.h"
+
+#include <AzCore/Asset/AssetManager.h>
+#include <AzCore/Console/IConsole.h>
+#include <AzCore/Math/Vector3.h>
+#include <AzCore/std/chrono/chrono.h>
+#include <AzCore/std/containers/fixed_vector.h>
+#include <AzCore/std/containers/unordered_set.h>
+#include <AzCore/std/string/string.h>
+
+#include <cstring>
+
+#if defined(AZ_PLATFORM_WINDOWS)
+#include <AzCore/PlatformIncl.h>
+#include <psapi.h>
+#elif defined(AZ_PLATFORM_LINUX) || defined(AZ_PLATFORM_MAC)
+#include <sys/resource.h>
+#endif
+
+#include <Atom/RHI.Reflect/BufferPoolDescriptor.h>
+#include <Atom/RPI.Reflect/Buffer/BufferAsset.h>
+#include <Atom/RPI.Reflect/Buffer/BufferAssetCreator.h>
+#include <Atom/RPI.Reflect/Model/ModelLodAsset.h>
+#include <Atom/RPI.Reflect/Model/ModelLodAssetCreator.h>
+#include <Atom/RPI.Reflect/Model/ModelAssetCreator.h>
+
+namespace CustomGem
+{
+    using namespace AZ;
+    using namespace AZ::RPI;
+
+    AZ_CVAR(bool, cg_modelBuilderVerbose, false, nullptr, AZ::ConsoleFunctorFlags::Null,
+        "Log the optimizer and LOD statistics of every model build");
+
+    namespace
+    {
+        //! Adds the time until it goes out of scope to *seconds, when seconds is set
+        class ScopedPhaseTimer
+        {
+        public:
+            explicit ScopedPhaseTimer(double* seconds)
+                : m_seconds(seconds)
+            {
+                if (m_seconds)
+                {
+                    m_startTime = AZStd::chrono::steady_clock::now();
+                }
+            }
+
+            ~ScopedPhaseTimer()
+            {
+                if (m_seconds)
+                {
+                    *m_seconds += AZStd::chrono::duration<double>(AZStd::chrono::steady_clock::now() - m_startTime).count();
+                }
+            }
+
+        private:
+            double* m_seconds;
+            AZStd::chrono::steady_clock::time_point m_startTime;
+        };
+
+        //! Returns every buffer of a model to the pool registry
+        void ReleaseBuffers(const ModelAsset& model)
+        {
+            // A buffer may back several views, only release each one once
+            AZStd::unordered_set<Data::AssetId> released;
+            auto releaseBuffer = [&released](const Data::Asset<BufferAsset>& buffer)
+            {
+                if (buffer.IsReady() && released.insert(buffer.GetId()).second)
+                {
+                    BufferPoolRegistry::Get().Release(*buffer.Get());
+                }
+            };
+
+            for (const Data::Asset<ModelLodAsset>& lod : model.GetLodAssets())
+            {
+                if (!lod.IsReady())
+                {
+                    continue;
+                }
+
+                for (const ModelLodAsset::Mesh& mesh : lod->GetMeshes())
+                {
+                    releaseBuffer(mesh.GetIndexBufferAssetView().GetBufferAsset());
+                    for (const ModelLodAsset::Mesh::StreamBufferInfo& stream : mesh.GetStreamBufferInfoList())
+                    {
+                        releaseBuffer(stream.m_bufferAssetView.GetBufferAsset());
+                    }
+                }
+            }
+        }
+    } // namespace
+
+    Data::AssetId ModelBuilder::AssetIds::Next()
+    {
+        if (guid.IsNull())
+        {
+            return Data::AssetId(Uuid::CreateRandom(), 0);
+        }
+        return Data::AssetId(guid, nextSubId++);
+    }
+
+    Data::Asset<BufferAsset> ModelBuilder::MakeBufferAsset(
+        AssetIds& ids, const void* data, uint32_t elementCount, uint32_t elementSize)
+    {
+        const uint32_t byteCount = elementCount * elementSize;
+        ScopedPhaseTimer timer(ids.timings ? &ids.timings->bufferSeconds : nullptr);
+        if (ids.timings)
+        {
+            ids.timings->bufferBytes += byteCount;
+            ++ids.timings->bufferCount;
+        }
+
+        // 1) Share a host-visible InputAssembly buffer pool with every other generated buffer
+        Data::Asset<ResourcePoolAsset> bufferPoolAsset = BufferPoolRegistry::Get().Acquire(
+            RHI::BufferBindFlags::InputAssembly, RHI::HeapMemoryLevel::Host, byteCount);
+
+        // 2) Create the buffer asset with a copy of the provided data
+        Data::Asset<BufferAsset> bufferAsset;
+        {
+            const Data::AssetId bufId = ids.Next();
+            bufferAsset = Data::AssetManager::Instance().CreateAsset(
+                bufId, azrtti_typeid<BufferAsset>(), Data::AssetLoadBehavior::PreLoad);
+
+            RHI::BufferDescriptor desc;
+            desc.m_bindFlags = RHI::BufferBindFlags::InputAssembly;
+            desc.m_byteCount = byteCount;
+
+            BufferAssetCreator creator;
+            creator.Begin(bufId);
+            creator.SetPoolAsset(bufferPoolAsset);
+            creator.SetBuffer(data, desc.m_byteCount, desc);
+            // Use a structured view (count + stride); callers pick the typed format on the mesh side.
+            creator.SetBufferViewDescriptor(RHI::BufferViewDescriptor::CreateStructured(0, elementCount, elementSize));
+            creator.End(bufferAsset);
+        }
+
+        return bufferAsset;
+    }
+
+    namespace
+    {
+        //! One vertex attribute stream as it is uploaded to the GPU
+        struct VertexStream
+        {
+            const char* semantic;
+            const void* data;
+            uint32_t count;
+            uint32_t elementSize;
+            RHI::Format format;
+        };
+
+        using VertexStreamList = AZStd::fixed_vector<VertexStream, 5>;
+
+        VertexStreamList GatherVertexStreams(const MeshStreams& mesh, const ModelBuildSettings& settings, QuantizedVertexData& quantized)
+        {
+            VertexStreamList streams;
+            streams.push_back({ "POSITION", mesh.positions.data(), static_cast<uint32_t>(mesh.positions.size() / 3), sizeof(float) * 3, RHI::Format::R32G32B32_FLOAT });
+
+            if (settings.vertexProfile == VertexProfile::Quantized)
+            {
+                // Bitangents are dropped, shaders rebuild them from the normal and the signed tangent
+                VertexCompression::Quantize(mesh.normals, mesh.tangents, mesh.uvs, quantized);
+
+                if (const uint32_t normalCount = static_cast<uint32_t>(quantized.normals.size() / 2))
+                {
+                    streams.push_back({ "NORMAL", quantized.normals.data(), normalCount, sizeof(int16_t) * 2, RHI::Format::R16G16_SNORM });
+                }
+                if (const uint32_t tangentCount = static_cast<uint32_t>(quantized.tangents.size() / 2))
+                {
+                    streams.push_back({ "TANGENT", quantized.tangents.data(), tangentCount, sizeof(int16_t) * 2, RHI::Format::R16G16_SNORM });
+                }
+                if (const uint32_t uvCount = static_cast<uint32_t>(quantized.uvs.size() / 2))
+                {
+                    streams.push_back({ "UV", quantized.uvs.data(), uvCount, sizeof(uint16_t) * 2, RHI::Format::R16G16_FLOAT });
+                }
+                return streams;
+            }
+
+            // NORMAL, TANGENT, BITANGENT and UV are optional
+            if (const uint32_t normalCount = static_cast<uint32_t>(mesh.normals.size() / 3))
+            {
+                streams.push_back({ "NORMAL", mesh.normals.data(), normalCount, sizeof(float) * 3, RHI::Format::R32G32B32_FLOAT });
+            }
+            if (const uint32_t tangentCount = static_cast<uint32_t>(mesh.tangents.size() / 4))
+            {
+                streams.push_back({ "TANGENT", mesh.tangents.data(), tangentCount, sizeof(float) * 4, RHI::Format::R32G32B32A32_FLOAT });
+            }
+            if (const uint32_t bitangentCount = static_cast<uint32_t>(mesh.bitangents.size() / 3))
+            {
+                streams.push_back({ "BITANGENT", mesh.bitangents.data(), bitangentCount, sizeof(float) * 3, RHI::Format::R32G32B32_FLOAT });
+            }
+            if (const uint32_t uvCount = static_cast<uint32_t>(mesh.uvs.size() / 2))
+            {
+                streams.push_back({ "UV", mesh.uvs.data(), uvCount, sizeof(float) * 2, RHI::Format::R32G32_FLOAT });
+            }
+            return streams;
+        }
+
+        //! Byte offset of each stream inside a single packed buffer. Every block starts on a multiple
+        //! of its own element size so the view can address it with a whole element offset.
+        uint32_t ComputePackedOffsets(const VertexStreamList& streams, AZStd::fixed_vector<uint32_t, 5>& offsets)
+        {
+            uint32_t byteCount = 0;
+            for (const VertexStream& stream : streams)
+            {
+                byteCount = ((byteCount + stream.elementSize - 1) / stream.elementSize) * stream.elementSize;
+                offsets.push_back(byteCount);
+                byteCount += stream.count * stream.elementSize;
+            }
+            return byteCount;
+        }
+
+        //! Copy of a set of streams, indices widened to 32 bits
+        MeshData ToMeshData(const MeshStreams& mesh)
+        {
+            MeshData data;
+            data.indices.assign(mesh.indices.begin(), mesh.indices.end());
+            data.indices.insert(data.indices.end(), mesh.indices16.begin(), mesh.indices16.end());
+            data.positions.assign(mesh.positions.begin(), mesh.positions.end());
+            data.normals.assign(mesh.normals.begin(), mesh.normals.end());
+            data.tangents.assign(mesh.tangents.begin(), mesh.tangents.end());
+            data.bitangents.assign(mesh.bitangents.begin(), mesh.bitangents.end());
+            data.uvs.assign(mesh.uvs.begin(), mesh.uvs.end());
+            return data;
+        }
+
+        //! Bounds of mesh, validating its streams in the same pass. Non-finite values are left out of
+        //! the bounds; out of range indices would make the GPU read past the vertex buffers.
+        Aabb ComputeAabb(const Name& name, const MeshStreams& mesh, ModelBuildTimings* timings)
+        {
+            ScopedPhaseTimer timer(timings ? &timings->boundsSeconds : nullptr);
+            const MeshStreamStats stats = MeshStatistics::Compute(mesh);
+            AZ_Warning("CustomGem", stats.nonFinitePositions == 0 && stats.nonFiniteAttributes == 0,
+                "Model '%s' has %zu NaN/Inf position and %zu NaN/Inf attribute values.",
+                name.GetCStr(), stats.nonFinitePositions, stats.nonFiniteAttributes);
+            AZ_Assert(stats.HasValidIndices(), "Model '%s' references vertex %u but only has %zu vertices.",
+                name.GetCStr(), stats.maxIndex, stats.vertexCount);
+            return stats.GetAabb();
+        }
+
+        //! Whether every index of every submesh addresses one of its vertices. Checked before a build
+        //! touches the mesh, since welding, optimizing and simplifying all index the vertex streams.
+        bool HasValidIndices(const Name& name, AZStd::span<const SubMesh> subMeshes)
+        {
+            for (size_t i = 0; i < subMeshes.size(); ++i)
+            {
+                const MeshStreams& mesh = subMeshes[i].mesh;
+                const size_t vertexCount = mesh.positions.size() / 3;
+                if (mesh.indices.empty() && mesh.indices16.empty())
+                {
+                    continue;
+                }
+
+                const uint32_t maxIndex = MeshStatistics::ComputeMaxIndex(mesh);
+                if (maxIndex >= vertexCount)
+                {
+                    AZ_Error("CustomGem", false, "Model '%s' mesh %zu references vertex %u but only has %zu vertices, not building it.",
+                        name.GetCStr(), i, maxIndex, vertexCount);
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        //! Whether all submeshes carry the same optional streams, so each semantic can live in one buffer
+        bool HaveMatchingStreams(AZStd::span<const SubMesh> subMeshes)
+        {
+            auto streamMask = [](const MeshStreams& mesh)
+            {
+                return (mesh.normals.empty() ? 0 : 1) | (mesh.tangents.empty() ? 0 : 2) |
+                    (mesh.bitangents.empty() ? 0 : 4) | (mesh.uvs.empty() ? 0 : 8);
+            };
+
+            const int mask = streamMask(subMeshes[0].mesh);
+            for (const SubMesh& subMesh : subMeshes)
+            {
+                if (streamMask(subMesh.mesh) != mask)
+                {
+                    AZ_Warning("CustomGem", false, "Submeshes have different vertex streams, every mesh gets its own buffers.");
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        HashValue64 HashText(AZStd::string_view text, HashValue64 seed = HashValue64{ 0 })
+        {
+            return TypeHash64(reinterpret_cast<const uint8_t*>(text.data()), text.size(), seed);
+        }
+
+        template<typename T>
+        void FreeStream(AZStd::vector<T>& stream)
+        {
+            stream.clear();
+            stream.shrink_to_fit();
+        }
+
+        //! Frees whichever vertex stream of mesh holds data
+        void FreeStream(MeshData& mesh, const void* data)
+        {
+            for (AZStd::vector<float>* stream : { &mesh.positions, &mesh.normals, &mesh.tangents, &mesh.bitangents, &mesh.uvs })
+            {
+                if (!stream->empty() && stream->data() == data)
+                {
+                    FreeStream(*stream);
+                    return;
+                }
+            }
+        }
+
+        //! Highest resident set size the process has reached, in bytes; 0 where it is not available
+        uint64_t GetPeakResidentBytes()
+        {
+#if defined(AZ_PLATFORM_WINDOWS)
+            PROCESS_MEMORY_COUNTERS counters;
+            if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            {
+                return counters.PeakWorkingSetSize;
+            }
+            return 0;
+#elif defined(AZ_PLATFORM_LINUX) || defined(AZ_PLATFORM_MAC)
+            rusage usage;
+            if (getrusage(RUSAGE_SELF, &usage) != 0)
+            {
+                return 0;
+            }
+#if defined(AZ_PLATFORM_MAC)
+            return static_cast<uint64_t>(usage.ru_maxrss);         // bytes
+#else
+            return static_cast<uint64_t>(usage.ru_maxrss) * 1024;  // kilobytes
+#endif
+#else
+            return 0;
+#endif
+        }
+    } // namespace
+
+    void ModelBuilder::AddVertexStreams(
+        AssetIds& ids,
+        ModelLodAssetCreator& lodCreator,
+        const MeshStreams& mesh,
+        const ModelBuildSettings& settings,
+        MeshData* owner)
+    {
+        QuantizedVertexData quantized;
+        const VertexStreamList streams = GatherVertexStreams(mesh, settings, quantized);
+        if (owner && settings.vertexProfile == VertexProfile::Quantized)
+        {
+            // Only the quantized copies are uploaded from here on
+            FreeStream(owner->normals);
+            FreeStream(owner->tangents);
+            FreeStream(owner->bitangents);
+            FreeStream(owner->uvs);
+        }
+
+        if (settings.vertexLayout == VertexBufferLayout::SingleBuffer)
+        {
+            AZStd::fixed_vector<uint32_t, 5> offsets;
+            const uint32_t byteCount = ComputePackedOffsets(streams, offsets);
+
+            AZStd::vector<uint8_t> packed(byteCount, 0);
+            for (size_t i = 0; i < streams.size(); ++i)
+            {
+                memcpy(packed.data() + offsets[i], streams[i].data, streams[i].count * streams[i].elementSize);
+            }
+            if (owner)
+            {
+                FreeStream(owner->positions);
+                FreeStream(owner->normals);
+                FreeStream(owner->tangents);
+                FreeStream(owner->bitangents);
+                FreeStream(owner->uvs);
+            }
+
+            const Data::Asset<BufferAsset> buffer = MakeBufferAsset(ids, packed.data(), byteCount, 1);
+            for (size_t i = 0; i < streams.size(); ++i)
+            {
+                const VertexStream& stream = streams[i];
+                lodCreator.AddMeshStreamBuffer(
+                    RHI::ShaderSemantic(Name(stream.semantic)), Name(),
+                    {
+                        buffer,
+                        RHI::BufferViewDescriptor::CreateTyped(offsets[i] / stream.elementSize, stream.count, stream.format)
+                    });
+            }
+            return;
+        }
+
+        for (const VertexStream& stream : streams)
+        {
+            lodCreator.AddMeshStreamBuffer(
+                RHI::ShaderSemantic(Name(stream.semantic)), Name(),
+                {
+                    MakeBufferAsset(ids, stream.data, stream.count, stream.elementSize),
+                    RHI::BufferViewDescriptor::CreateTyped(0, stream.count, stream.format)
+                });
+            if (owner)
+            {
+                FreeStream(*owner, stream.data);
+            }
+        }
+    }
+
+    bool ModelBuilder::Uses16BitIndices(const MeshStreams& mesh, const ModelBuildSettings& settings)
+    {
+        const size_t vertexCount = mesh.positions.size() / 3;
+        const bool fits16 = vertexCount <= MeshData::MaxIndex16 + 1;
+
+        switch (settings.indexFormat)
+        {
+        case IndexBufferFormat::Uint32:
+            return false;
+        case IndexBufferFormat::Uint16:
+            AZ_Warning("CustomGem", fits16,
+                "16-bit indices requested for a mesh with %zu vertices, using 32-bit indices instead.", vertexCount);
+            return fits16;
+        default:
+            return fits16;
+        }
+    }
+
+    void ModelBuilder::SetIndexBuffer(AssetIds& ids, ModelLodAssetCreator& lodCreator, const MeshStreams& mesh, const ModelBuildSettings& settings)
+    {
+        AZ_Assert(mesh.indices.empty() || mesh.indices16.empty(), "CreateModel: mesh has both 16-bit and 32-bit indices");
+
+        if (Uses16BitIndices(mesh, settings))
+        {
+            // Upload 16-bit indices as they are, narrow 32-bit ones
+            AZStd::vector<uint16_t> narrowed;
+            AZStd::span<const uint16_t> indices = mesh.indices16;
+            if (!mesh.indices.empty())
+            {
+                narrowed.resize_no_construct(mesh.indices.size());
+                AZStd::transform(mesh.indices.begin(), mesh.indices.end(), narrowed.begin(),
+                    [](uint32_t index) { return static_cast<uint16_t>(index); });
+                indices = narrowed;
+            }
+
+            const uint32_t indexCount = static_cast<uint32_t>(indices.size());
+            lodCreator.SetMeshIndexBuffer(
+                {
+                    MakeBufferAsset(ids, indices.data(), indexCount, sizeof(uint16_t)),
+                    RHI::BufferViewDescriptor::CreateTyped(0, indexCount, RHI::Format::R16_UINT)
+                });
+            return;
+        }
+
+        AZStd::vector<uint32_t> widened;
+        AZStd::span<const uint32_t> indices = mesh.indices;
+        if (!mesh.indices16.empty())
+        {
+            widened.assign(mesh.indices16.begin(), mesh.indices16.end());
+            indices = widened;
+        }
+
+        const uint32_t indexCount = static_cast<uint32_t>(indices.size());
+        lodCreator.SetMeshIndexBuffer(
+            {
+                MakeBufferAsset(ids, indices.data(), indexCount, sizeof(uint32_t)),
+                RHI::BufferViewDescriptor::CreateTyped(0, indexCount, RHI::Format::R32_UINT)
+            });
+    }
+
+    AZ::Data::Asset<AZ::RPI::ModelAsset> ModelBuilder::CreateModel(
+        const Name& name,
+        const MeshStreams& mesh,
+        const ModelBuildSettings& settings)
+    {
+        SubMesh subMesh;
+        subMesh.mesh = mesh;
+        subMesh.materialSlotName = Name("Default");
+        return CreateModel(name, AZStd::span<const SubMesh>(&subMesh, 1), settings);
+    }
+
+    AZ::Data::Asset<AZ::RPI::ModelAsset> ModelBuilder::CreateModel(
+        const Name& name,
+        AZStd::span<const SubMesh> subMeshes,
+        const ModelBuildSettings& settings)
+    {
+        if (!settings.useModelCache)
+        {
+            AssetIds ids;
+            ids.timings = settings.timings;
+            return BuildModel(ids, name, subMeshes, settings);
+        }
+
+        return ModelCache::Get().FindOrCreate(ComputeContentHash(name, subMeshes, settings),
+            [&](const Uuid& guid)
+            {
+                AssetIds ids;
+                ids.guid = guid;
+                ids.timings = settings.timings;
+                return BuildModel(ids, name, subMeshes, settings);
+            });
+    }
+
+    AZ::Data::Asset<AZ::RPI::ModelAsset> ModelBuilder::CreateCachedModel(
+        const Name& name,
+        HashValue64 generatorKey,
+        const GenerateFunction& generate,
+        const ModelBuildSettings& settings)
+    {
+        const HashValue64 key = HashText(name.GetStringView(), TypeHash64(BuilderVersion, generatorKey));
+        auto build = [&](AssetIds& ids)
+        {
+            // A disk hit uploads straight from the mapped file
+            MappedMeshFile cached;
+            if (settings.useDiskCache && ModelDiskCache::Get().Open(key, cached))
+            {
+                SubMesh subMesh;
+                subMesh.mesh = cached.GetStreams();
+                subMesh.materialSlotName = Name("Default");
+                return BuildModel(ids, name, AZStd::span<const SubMesh>(&subMesh, 1), settings);
+            }
+
+            MeshData mesh;
+            generate(mesh);
+            if (settings.useDiskCache)
+            {
+                ModelDiskCache::Get().Store(key, mesh);
+            }
+            return BuildOwnedModel(ids, name, mesh, settings);
+        };
+
+        if (!settings.useModelCache)
+        {
+            AssetIds ids;
+            ids.timings = settings.timings;
+            return build(ids);
+        }
+
+        // Keyed by the generator instead of the content, so a warm build neither touches the disk
+        // cache nor generates and hashes the streams
+        const HashValue64 cacheKey = TypeHash64(key, ComputeContentHash(name, {}, settings));
+        return ModelCache::Get().FindOrCreate(cacheKey,
+            [&](const Uuid& guid)
+            {
+                AssetIds ids;
+                ids.guid = guid;
+                ids.timings = settings.timings;
+                return build(ids);
+            });
+    }
+
+    AZ::HashValue64 ModelBuilder::ComputeContentHash(
+        const Name& name,
+        AZStd::span<const SubMesh> subMeshes,
+        const ModelBuildSettings& settings)
+    {
+        HashValue64 hash = HashValue64{ 0 };
+        auto hashBytes = [&hash](const void* data, size_t byteCount)
+        {
+            hash = TypeHash64(static_cast<const uint8_t*>(data), byteCount, hash);
+        };
+        auto hashValue = [&hashBytes](const auto& value)
+        {
+            hashBytes(&value, sizeof(value));
+        };
+        auto hashString = [&hashBytes, &hashValue](AZStd::string_view text)
+        {
+            hashValue(text.size());
+            hashBytes(text.data(), text.size());
+        };
+        auto hashSpan = [&hashBytes, &hashValue](const auto& data)
+        {
+            hashValue(data.size());
+            hashBytes(data.data(), data.size_bytes());
+        };
+
+        hashString(name.GetStringView());
+
+        // Everything that changes the built assets; hashed field by field so padding never leaks in
+        hashValue(settings.indexFormat);
+        hashValue(settings.vertexLayout);
+        hashValue(settings.vertexProfile);
+        hashValue(settings.optimizeMesh);
+        if (settings.optimizeMesh)
+        {
+            const OptimizeSettings& optimize = settings.optimizeSettings;
+            hashValue(optimize.weld);
+            hashValue(optimize.weldSettings.positionEpsilon);
+            hashValue(optimize.weldSettings.normalEpsilon);
+            hashValue(optimize.weldSettings.tangentEpsilon);
+            hashValue(optimize.weldSettings.bitangentEpsilon);
+            hashValue(optimize.weldSettings.uvEpsilon);
+            hashValue(optimize.vertexCache);
+            hashValue(optimize.overdraw);
+            hashValue(optimize.overdrawThreshold);
+            hashValue(optimize.vertexFetch);
+        }
+        hashValue(settings.lods.size());
+        for (const ModelLodSettings& lod : settings.lods)
+        {
+            hashValue(lod.triangleRatio);
+            hashValue(lod.maxError);
+        }
+
+        hashValue(subMeshes.size());
+        for (const SubMesh& subMesh : subMeshes)
+        {
+            hashValue(subMesh.materialSlotId);
+            hashString(subMesh.materialSlotName.GetStringView());
+            hashSpan(subMesh.mesh.indices);
+            hashSpan(subMesh.mesh.indices16);
+            hashSpan(subMesh.mesh.positions);
+            hashSpan(subMesh.mesh.normals);
+            hashSpan(subMesh.mesh.tangents);
+            hashSpan(subMesh.mesh.bitangents);
+            hashSpan(subMesh.mesh.uvs);
+        }
+        return hash;
+    }
+
+    AZ::Data::Asset<AZ::RPI::ModelAsset> ModelBuilder::BuildModel(
+        AssetIds& ids,
+        const Name& name,
+        AZStd::span<const SubMesh> subMeshes,
+        const ModelBuildSettings& settings)
+    {
+        if (!HasValidIndices(name, subMeshes))
+        {
+            return {};
+        }
+
+        ScopedPhaseTimer timer(ids.timings ? &ids.timings->totalSeconds : nullptr);
+        AZStd::vector<Data::Asset<ModelLodAsset>> lods;
+        lods.reserve(settings.lods.size() + 1);
+
+        if (settings.lods.empty())
+        {
+            lods.push_back(BuildLodAsset(ids, name, subMeshes, settings));
+        }
+        else
+        {
+            // Exact duplicates are welded first so that only real seams lock vertices. LOD 0 is
+            // uploaded welded as well, matching BuildOwnedModel, which welds the owned mesh in place.
+            AZStd::vector<MeshData> base(subMeshes.size());
+            AZStd::vector<SubMesh> lodSubMeshes(subMeshes.begin(), subMeshes.end());
+            for (size_t i = 0; i < subMeshes.size(); ++i)
+            {
+                base[i] = ToMeshData(subMeshes[i].mesh);
+                MeshOptimizer::WeldVertices(base[i]);
+                lodSubMeshes[i].mesh = base[i].GetStreams();
+            }
+            lods.push_back(BuildLodAsset(ids, name, lodSubMeshes, settings));
+
+            for (const AZStd::vector<MeshData>& lodMeshes : GenerateLodMeshes(name, base, settings))
+            {
+                for (size_t i = 0; i < subMeshes.size(); ++i)
+                {
+                    lodSubMeshes[i].mesh = lodMeshes[i].GetStreams();
+                }
+                lods.push_back(BuildLodAsset(ids, name, lodSubMeshes, settings));
+            }
+        }
+
+        return BuildModelAsset(ids, name, subMeshes, lods);
+    }
+
+    AZ::Data::Asset<AZ::RPI::ModelAsset> ModelBuilder::BuildOwnedModel(
+        AssetIds& ids,
+        const Name& name,
+        MeshData& mesh,
+        const ModelBuildSettings& settings)
+    {
+        SubMesh slot;
+        slot.mesh = mesh.GetStreams();
+        slot.materialSlotName = Name("Default");
+        if (!HasValidIndices(name, AZStd::span<const SubMesh>(&slot, 1)))
+        {
+            return {};
+        }
+        slot.mesh = {};
+
+        ScopedPhaseTimer timer(ids.timings ? &ids.timings->totalSeconds : nullptr);
+
+        // The LOD chain is simplified before LOD 0 is uploaded and freed. Welding in place merges
+        // vertices that are equal within the weld tolerance, which leaves LOD 0 looking the same.
+        AZStd::vector<AZStd::vector<MeshData>> lodMeshes;
+        if (!settings.lods.empty())
+        {
+            MeshOptimizer::WeldVertices(mesh);
+            lodMeshes = GenerateLodMeshes(name, AZStd::span<const MeshData>(&mesh, 1), settings);
+        }
+
+        AZStd::vector<Data::Asset<ModelLodAsset>> lods;
+        lods.reserve(lodMeshes.size() + 1);
+        lods.push_back(BuildOwnedLodAsset(ids, name, mesh, settings));
+        for (AZStd::vector<MeshData>& lodMesh : lodMeshes)
+        {
+            lods.push_back(BuildOwnedLodAsset(ids, name, lodMesh[0], settings));
+        }
+
+        return BuildModelAsset(ids, name, AZStd::span<const SubMesh>(&slot, 1), lods);
+    }
+
+    AZStd::vector<AZStd::vector<MeshData>> ModelBuilder::GenerateLodMeshes(
+        const Name& name,
+        AZStd::span<const MeshData> base,
+        const ModelBuildSettings& settings)
+    {
+        // Each LOD is simplified from the previous one
+        AZStd::vector<AZStd::vector<MeshData>> lodMeshes;
+        lodMeshes.reserve(settings.lods.size());
+
+        AZStd::vector<size_t> baseTriangles(base.size());
+        for (size_t i = 0; i < base.size(); ++i)
+        {
+            baseTriangles[i] = base[i].GetIndexCount() / 3;
+        }
+
+        for (const ModelLodSettings& lod : settings.lods)
+        {
+            AZStd::vector<MeshData> simplified(base.size());
+            size_t trianglesBefore = 0;
+            size_t trianglesAfter = 0;
+            size_t verticesAfter = 0;
+            float error = 0.0f;
+            for (size_t i = 0; i < base.size(); ++i)
+            {
+                const MeshData& previous = lodMeshes.empty() ? base[i] : lodMeshes.back()[i];
+                const size_t previousTriangles = previous.GetIndexCount() / 3;
+                const float targetTriangles = lod.triangleRatio * static_cast<float>(baseTriangles[i]);
+
+                SimplifySettings simplifySettings;
+                simplifySettings.triangleRatio = previousTriangles > 0 ? targetTriangles / static_cast<float>(previousTriangles) : 1.0f;
+                simplifySettings.maxError = lod.maxError;
+
+                SimplifyStats stats = MeshSimplifier::Simplify(previous, simplified[i], simplifySettings);
+                if (stats.trianglesAfter == 0)
+                {
+                    // Keep every submesh drawable, a tiny part simply stops shrinking
+                    simplified[i] = previous;
+                    stats.trianglesAfter = previousTriangles;
+                    stats.verticesAfter = previous.GetVertexCount();
+                }
+
+                trianglesBefore += previousTriangles;
+                trianglesAfter += stats.trianglesAfter;
+                verticesAfter += stats.verticesAfter;
+                error = AZStd::max(error, stats.error);
+            }
+
+            if (trianglesAfter == trianglesBefore)
+            {
+                AZ_Warning("CustomGem", false, "'%s': LOD %zu could not be simplified further, the chain ends at %zu LODs.",
+                    name.GetCStr(), lodMeshes.size() + 1, lodMeshes.size() + 1);
+                break;
+            }
+
+            if (cg_modelBuilderVerbose)
+            {
+                AZ_Printf("CustomGem", "'%s' LOD %zu: %zu triangles, %zu vertices, error %.4f\n",
+                    name.GetCStr(), lodMeshes.size() + 1, trianglesAfter, verticesAfter, error);
+            }
+            lodMeshes.push_back(AZStd::move(simplified));
+        }
+        return lodMeshes;
+    }
+
+    Data::Asset<ModelLodAsset> ModelBuilder::BuildLodAsset(
+        AssetIds& ids,
+        const Name& name,
+        AZStd::span<const SubMesh> subMeshes,
+        const ModelBuildSettings& settings)
+    {
+        if (settings.optimizeMesh)
+        {
+            AZStd::vector<MeshData> optimized(subMeshes.size());
+            AZStd::vector<SubMesh> optimizedSubMeshes(subMeshes.begin(), subMeshes.end());
+            for (size_t i = 0; i < subMeshes.size(); ++i)
+            {
+                optimized[i] = ToMeshData(subMeshes[i].mesh);
+
+                const OptimizeStats stats = MeshOptimizer::Optimize(optimized[i], settings.optimizeSettings);
+                if (cg_modelBuilderVerbose)
+                {
+                    AZ_Printf("CustomGem", "Optimized '%s' mesh %zu: vertices %zu -> %zu, ACMR %.3f -> %.3f -> %.3f, ATVR %.3f -> %.3f\n",
+                        name.GetCStr(), i, subMeshes[i].mesh.positions.size() / 3, optimized[i].GetVertexCount(),
+                        stats.initial.acmr, stats.afterVertexCache.acmr, stats.afterOverdraw.acmr,
+                        stats.initial.atvr, stats.afterOverdraw.atvr);
+                }
+
+                optimizedSubMeshes[i].mesh = optimized[i].GetStreams();
+            }
+
+            ModelBuildSettings uploadSettings = settings;
+            uploadSettings.optimizeMesh = false;
+            return BuildLodAsset(ids, name, optimizedSubMeshes, uploadSettings);
+        }
+
+        // ---- Build one LOD with one mesh per submesh ----
+        const Data::AssetId lodId = ids.Next();
+        Data::Asset<ModelLodAsset> lodAsset =
+            Data::AssetManager::Instance().CreateAsset(lodId, azrtti_typeid<ModelLodAsset>(), Data::AssetLoadBehavior::PreLoad);
+
+        ModelLodAssetCreator lodCreator;
+        lodCreator.Begin(lodId);
+
+        if (subMeshes.size() > 1 && HaveMatchingStreams(subMeshes))
+        {
+            AddSharedMeshes(ids, name, lodCreator, subMeshes, settings);
+        }
+        else
+        {
+            for (const SubMesh& subMesh : subMeshes)
+            {
+                lodCreator.BeginMesh();
+                lodCreator.SetMeshAabb(ComputeAabb(name, subMesh.mesh, ids.timings));
+                lodCreator.SetMeshMaterialSlot(subMesh.materialSlotId);
+
+                SetIndexBuffer(ids, lodCreator, subMesh.mesh, settings);
+
+                AddVertexStreams(ids, lodCreator, subMesh.mesh, settings);
+
+                lodCreator.EndMesh();
+            }
+        }
+
+        lodCreator.End(lodAsset);
+
+        return lodAsset;
+    }
+
+    Data::Asset<ModelLodAsset> ModelBuilder::BuildOwnedLodAsset(
+        AssetIds& ids,
+        const Name& name,
+        MeshData& mesh,
+        const ModelBuildSettings& settings)
+    {
+        if (settings.optimizeMesh)
+        {
+            const size_t verticesBefore = mesh.GetVertexCount();
+            const OptimizeStats stats = MeshOptimizer::Optimize(mesh, settings.optimizeSettings);
+            if (cg_modelBuilderVerbose)
+            {
+                AZ_Printf("CustomGem", "Optimized '%s' mesh 0: vertices %zu -> %zu, ACMR %.3f -> %.3f -> %.3f, ATVR %.3f -> %.3f\n",
+                    name.GetCStr(), verticesBefore, mesh.GetVertexCount(),
+                    stats.initial.acmr, stats.afterVertexCache.acmr, stats.afterOverdraw.acmr,
+                    stats.initial.atvr, stats.afterOverdraw.atvr);
+            }
+        }
+
+        const Data::AssetId lodId = ids.Next();
+        Data::Asset<ModelLodAsset> lodAsset =
+            Data::AssetManager::Instance().CreateAsset(lodId, azrtti_typeid<ModelLodAsset>(), Data::AssetLoadBehavior::PreLoad);
+
+        ModelLodAssetCreator lodCreator;
+        lodCreator.Begin(lodId);
+        lodCreator.BeginMesh();
+        lodCreator.SetMeshAabb(ComputeAabb(name, mesh.GetStreams(), ids.timings));
+        lodCreator.SetMeshMaterialSlot(0);
+
+        // Narrowing the owned indices frees the 32-bit ones before the upload copies them again
+        if (!mesh.use16BitIndices && Uses16BitIndices(mesh.GetStreams(), settings))
+        {
+            mesh.NarrowIndices();
+        }
+        SetIndexBuffer(ids, lodCreator, mesh.GetStreams(), settings);
+        FreeStream(mesh.indices);
+        FreeStream(mesh.indices16);
+
+        AddVertexStreams(ids, lodCreator, mesh.GetStreams(), settings, &mesh);
+
+        lodCreator.EndMesh();
+        lodCreator.End(lodAsset);
+        return lodAsset;
+    }
+
+    void ModelBuilder::AddSharedMeshes(
+        AssetIds& ids,
+        const Name& name,
+        ModelLodAssetCreator& lodCreator,
+        AZStd::span<const SubMesh> subMeshes,
+        const ModelBuildSettings& settings)
+    {
+        const size_t meshCount = subMeshes.size();
+
+        // ---- One index buffer; indices stay local to their submesh ----
+        bool use16BitIndices = true;
+        for (const SubMesh& subMesh : subMeshes)
+        {
+            use16BitIndices &= Uses16BitIndices(subMesh.mesh, settings);
+        }
+
+        AZStd::vector<uint32_t> indexOffsets(meshCount);
+        AZStd::vector<uint32_t> indexCounts(meshCount);
+        Data::Asset<BufferAsset> indexBuffer;
+        if (use16BitIndices)
+        {
+            AZStd::vector<uint16_t> indices;
+            for (size_t i = 0; i < meshCount; ++i)
+            {
+                const MeshStreams& mesh = subMeshes[i].mesh;
+                indexOffsets[i] = static_cast<uint32_t>(indices.size());
+                indices.insert(indices.end(), mesh.indices16.begin(), mesh.indices16.end());
+                for (uint32_t index : mesh.indices)
+                {
+                    indices.push_back(static_cast<uint16_t>(index));
+                }
+                indexCounts[i] = static_cast<uint32_t>(indices.size()) - indexOffsets[i];
+            }
+            indexBuffer = MakeBufferAsset(ids, indices.data(), static_cast<uint32_t>(indices.size()), sizeof(uint16_t));
+        }
+        else
+        {
+            AZStd::vector<uint32_t> indices;
+            for (size_t i = 0; i < meshCount; ++i)
+            {
+                const MeshStreams& mesh = subMeshes[i].mesh;
+                indexOffsets[i] = static_cast<uint32_t>(indices.size());
+                indices.insert(indices.end(), mesh.indices.begin(), mesh.indices.end());
+                indices.insert(indices.end(), mesh.indices16.begin(), mesh.indices16.end());
+                indexCounts[i] = static_cast<uint32_t>(indices.size()) - indexOffsets[i];
+            }
+            indexBuffer = MakeBufferAsset(ids, indices.data(), static_cast<uint32_t>(indices.size()), sizeof(uint32_t));
+        }
+        const RHI::Format indexFormat = use16BitIndices ? RHI::Format::R16_UINT : RHI::Format::R32_UINT;
+
+        // ---- One buffer per semantic (or one in total) holding every submesh's range back to back ----
+        AZStd::vector<QuantizedVertexData> quantized(meshCount);
+        AZStd::vector<VertexStreamList> meshStreams(meshCount);
+        for (size_t i = 0; i < meshCount; ++i)
+        {
+            meshStreams[i] = GatherVertexStreams(subMeshes[i].mesh, settings, quantized[i]);
+        }
+
+        // Combined stream s covers the ranges of stream s of all submeshes, in submesh order
+        VertexStreamList combined = meshStreams[0];
+        for (size_t s = 0; s < combined.size(); ++s)
+        {
+            combined[s].data = nullptr;
+            combined[s].count = 0;
+            for (size_t i = 0; i < meshCount; ++i)
+            {
+                combined[s].count += meshStreams[i][s].count;
+            }
+        }
+
+        AZStd::fixed_vector<Data::Asset<BufferAsset>, 5> buffers;
+        AZStd::fixed_vector<uint32_t, 5> firstElements;
+        if (settings.vertexLayout == VertexBufferLayout::SingleBuffer)
+        {
+            AZStd::fixed_vector<uint32_t, 5> offsets;
+            const uint32_t byteCount = ComputePackedOffsets(combined, offsets);
+
+            AZStd::vector<uint8_t> packed(byteCount, 0);
+            for (size_t s = 0; s < combined.size(); ++s)
+            {
+                uint8_t* write = packed.data() + offsets[s];
+                for (size_t i = 0; i < meshCount; ++i)
+                {
+                    const VertexStream& stream = meshStreams[i][s];
+                    memcpy(write, stream.data, stream.count * stream.elementSize);
+                    write += stream.count * stream.elementSize;
+                }
+            }
+
+            const Data::Asset<BufferAsset> buffer = MakeBufferAsset(ids, packed.data(), byteCount, 1);
+            for (size_t s = 0; s < combined.size(); ++s)
+            {
+                buffers.push_back(buffer);
+                firstElements.push_back(offsets[s] / combined[s].elementSize);
+            }
+        }
+        else
+        {
+            AZStd::vector<uint8_t> bytes;
+            for (size_t s = 0; s < combined.size(); ++s)
+            {
+                bytes.resize_no_construct(combined[s].count * combined[s].elementSize);
+                uint8_t* write = bytes.data();
+                for (size_t i = 0; i < meshCount; ++i)
+                {
+                    const VertexStream& stream = meshStreams[i][s];
+                    memcpy(write, stream.data, stream.count * stream.elementSize);
+                    write += stream.count * stream.elementSize;
+                }
+
+                buffers.push_back(MakeBufferAsset(ids, bytes.data(), combined[s].count, combined[s].elementSize));
+                firstElements.push_back(0);
+            }
+        }
+
+        // ---- One mesh per submesh, addressing its ranges through the view offsets ----
+        for (size_t i = 0; i < meshCount; ++i)
+        {
+            lodCreator.BeginMesh();
+            lodCreator.SetMeshAabb(ComputeAabb(name, subMeshes[i].mesh, ids.timings));
+            lodCreator.SetMeshMaterialSlot(subMeshes[i].materialSlotId);
+
+            lodCreator.SetMeshIndexBuffer(
+                {
+                    indexBuffer,
+                    RHI::BufferViewDescriptor::CreateTyped(indexOffsets[i], indexCounts[i], indexFormat)
+                });
+
+            for (size_t s = 0; s < combined.size(); ++s)
+            {
+                const VertexStream& stream = meshStreams[i][s];
+                lodCreator.AddMeshStreamBuffer(
+                    RHI::ShaderSemantic(Name(stream.semantic)), Name(),
+                    {
+                        buffers[s],
+                        RHI::BufferViewDescriptor::CreateTyped(firstElements[s], stream.count, stream.format)
+                    });
+                firstElements[s] += stream.count;
+            }
+
+            lodCreator.EndMesh();
+        }
+    }
+
+    AZ::Data::Asset<AZ::RPI::ModelAsset> ModelBuilder::BuildModelAsset(
+        AssetIds& ids,
+        const Name& name,
+        AZStd::span<const SubMesh> subMeshes,
+        AZStd::span<Data::Asset<ModelLodAsset>> lods)
+    {
+        // ---- Final ModelAsset via ModelAssetCreator (public) ----
+        const Data::AssetId modelId = ids.guid.IsNull() ? Data::AssetId(Uuid::CreateRandom(), 0) : Data::AssetId(ids.guid, 0);
+        Data::Asset<ModelAsset> result =
+            Data::AssetManager::Instance()
+            .CreateAsset(modelId, azrtti_typeid<ModelAsset>(), 
+            Data::AssetLoadBehavior::PreLoad);
+
+        AZ::RPI::ModelAssetCreator modelCreator;
+        modelCreator.Begin(modelId);
+        modelCreator.SetName(name.GetStringView());
+
+        // One material slot per distinct slot id, named by the first submesh using it.
+        // DrawListTag can be left default ({}); engine will resolve a default tag per pass.
+        AZStd::unordered_set<uint32_t> addedSlots;
+        for (const SubMesh& subMesh : subMeshes)
+        {
+            if (!addedSlots.insert(subMesh.materialSlotId).second)
+            {
+                continue;
+            }
+
+            const AZ::Name slotName = subMesh.materialSlotName.IsEmpty()
+                ? AZ::Name(AZStd::string::format("Slot%u", subMesh.materialSlotId))
+                : subMesh.materialSlotName;
+            AZ::RPI::ModelMaterialSlot slot(
+                AZ::RPI::ModelMaterialSlot::StableId{subMesh.materialSlotId},
+                slotName);
+
+            modelCreator.AddMaterialSlot(slot);
+        }
+
+        // LOD 0 first; every LOD has the same meshes and slots
+        for (Data::Asset<ModelLodAsset>& lodAsset : lods)
+        {
+            modelCreator.AddLodAsset(AZStd::move(lodAsset));
+        }
+        modelCreator.End(result);
+
+        return result;
+    }
+
+    AZ::Data::Asset<AZ::RPI::ModelAsset> ModelBuilder::CreateModel(
+        const Name& name,
+        AZStd::span<const uint32_t> indices,
+        AZStd::span<const float> positions,
+        AZStd::span<const float> normals,
+        AZStd::span<const float> tangents,
+        AZStd::span<const float> bitangents,
+        AZStd::span<const float> uvs,
+        const ModelBuildSettings& settings)
+    {
+        MeshStreams streams;
+        streams.indices = indices;
+        streams.positions = positions;
+        streams.normals = normals;
+        streams.tangents = tangents;
+        streams.bitangents = bitangents;
+        streams.uvs = uvs;
+        return CreateModel(name, streams, settings);
+    }
+
+    AZ::Data::Asset<AZ::RPI::ModelAsset> ModelBuilder::CreateModel(
+        const AZ::Name& name,
+        const MeshData& mesh,
+        const ModelBuildSettings& settings)
+    {
+        // AZ_Printf("CustomGem", "Creating model '%s' with %zu vertices and %zu indices.\n",
+        //     name.c_str(), meshData.positions.size() / 3, meshData.indices.size());
+        return CreateModel(name, mesh.GetStreams(), settings);
+    }
+
+    AZ::Data::Asset<AZ::RPI::ModelAsset> ModelBuilder::CreateModel(
+        const AZ::Name& name,
+        MeshData&& mesh,
+        const ModelBuildSettings& settings)
+    {
+        // getrusage and friends are only worth their cost when the result is logged
+        const uint64_t peakBefore = cg_modelBuilderVerbose ? GetPeakResidentBytes() : 0;
+        const size_t vertexCount = mesh.GetVertexCount();
+
+        Data::Asset<ModelAsset> model;
+        if (!settings.useModelCache)
+        {
+            AssetIds ids;
+            ids.timings = settings.timings;
+            model = BuildOwnedModel(ids, name, mesh, settings);
+        }
+        else
+        {
+            // Same key as the copying overloads, so both share cached models
+            SubMesh subMesh;
+            subMesh.mesh = mesh.GetStreams();
+            subMesh.materialSlotName = Name("Default");
+            model = ModelCache::Get().FindOrCreate(ComputeContentHash(name, AZStd::span<const SubMesh>(&subMesh, 1), settings),
+                [&](const Uuid& guid)
+                {
+                    AssetIds ids;
+                    ids.guid = guid;
+                    ids.timings = settings.timings;
+                    return BuildOwnedModel(ids, name, mesh, settings);
+                });
+        }
+
+        // The mesh was handed over, so it goes away on a cache hit as well
+        mesh = MeshData();
+
+        if (const uint64_t peakAfter = cg_modelBuilderVerbose ? GetPeakResidentBytes() : 0)
+        {
+            constexpr double MiB = 1024.0 * 1024.0;
+            AZ_Printf("CustomGem", "Built '%s' (%zu vertices) from an owned mesh: peak RSS %.1f MiB, %.1f MiB above the peak before the build\n",
+                name.GetCStr(), vertexCount, peakAfter / MiB, (peakAfter - peakBefore) / MiB);
+        }
+        return model;
+    }
+
+    void ModelBuilder::ReleaseModel(AZ::Data::Asset<AZ::RPI::ModelAsset>& model)
+    {
+        // Cached models are shared, their buffers stay until the last user lets go
+        if (!model.IsReady() || !ModelCache::Get().Release(model.GetId()))
+        {
+            model.Reset();
+            return;
+        }
+
+        ReleaseBuffers(*model);
+        model.Reset();
+    }
+
+    uint32_t ModelBuilder::ReleaseUnusedModels()
+    {
+        AZStd::vector<Data::Asset<ModelAsset>> evicted;
+        const uint32_t released = ModelCache::Get().ReleaseUnused(evicted);
+        for (const Data::Asset<ModelAsset>& model : evicted)
+        {
+            if (model.IsReady())
+            {
+                ReleaseBuffers(*model);
+            }
+        }
+        return released;
+    }
+
+    AZ::Data::Asset<AZ::RPI::ModelAsset> ModelBuilder::BuildPlane(const AZ::Vector3& pos) {
+        const float corner[3] = { pos.GetX(), pos.GetY(), pos.GetZ() };
+        const HashValue64 key = TypeHash64(reinterpret_cast<const uint8_t*>(corner), sizeof(corner), HashValue64{ 0 });
+        return CreateCachedModel(AZ::Name("ProceduralPlane"), key, [&pos](MeshData& mesh)
+        {
+            mesh.use16BitIndices = true;
+            MeshUtils::PushQuad(mesh, pos, 0);
+        });
+    }
+
+    AZ::Data::Asset<AZ::RPI::ModelAsset> ModelBuilder::BuildPlane(const float x, const float y, const float z) {
+        return BuildPlane(AZ::Vector3(x, y, z));
+    }
+
+    AZ::Data::Asset<AZ::RPI::ModelAsset> ModelBuilder::BuildPlane() {
+        return BuildPlane(-0.5f, 0.0f, 0.5f);
+    }
+
+    void ModelBuilder::GenerateCube(MeshData& mesh)
+    {
+        mesh.use16BitIndices = true;
+        mesh.ReserveQuads(6);
+
+        // The cube extends from (0,0,0) to (1,1,1)
+        // Each PushQuad builds one oriented face at the corresponding side.
+
+        MeshUtils::PushQuad(mesh, AZ::Vector3(0.0f, 0.0f, 1.0f), 0, {3, 0}); // +Z (front)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(0.0f, 0.0f, 0.0f), 1, {3, 2}); // -Z (back)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(0.0f, 0.0f, 0.0f), 2, {3, 1}); // -X (left)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(1.0f, 0.0f, 0.0f), 3, {3, 1}); // +X (right)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(0.0f, 1.0f, 0.0f), 4, {3, 1}); // +Y (top)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(0.0f, 0.0f, 0.0f), 5, {3, 1}); // -Y (bottom)
+    }
+
+    void ModelBuilder::GenerateOctCube(MeshData& mesh) {
+        mesh.use16BitIndices = true;
+        mesh.ReserveQuads(24);
+
+        // The cube extends from (0,0,0) to (1,1,1)
+        // Each PushQuad builds one oriented face at the corresponding side.
+
+        MeshUtils::PushQuad(mesh, AZ::Vector3(0.0f, 0.0f, 2.0f), 0, {3, 0}); // +Z (front)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(0.0f, 1.0f, 2.0f), 0, {3, 0}); // +Z (front)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(1.0f, 0.0f, 2.0f), 0, {3, 0}); // +Z (front)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(1.0f, 1.0f, 2.0f), 0, {3, 0}); // +Z (front)
+        
+        MeshUtils::PushQuad(mesh, AZ::Vector3(0.0f, 0.0f, 0.0f), 1, {3, 2}); // -Z (back)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(0.0f, 1.0f, 0.0f), 1, {3, 2}); // -Z (back)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(1.0f, 0.0f, 0.0f), 1, {3, 2}); // -Z (back)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(1.0f, 1.0f, 0.0f), 1, {3, 2}); // -Z (back)
+
+        MeshUtils::PushQuad(mesh, AZ::Vector3(0.0f, 0.0f, 0.0f), 2, {3, 1}); // -X (left)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(0.0f, 0.0f, 1.0f), 2, {3, 1}); // -X (left)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(0.0f, 1.0f, 0.0f), 2, {3, 1}); // -X (left)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(0.0f, 1.0f, 1.0f), 2, {3, 1}); // -X (left)
+
+
+        MeshUtils::PushQuad(mesh, AZ::Vector3(2.0f, 0.0f, 0.0f), 3, {3, 1}); // +X (right)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(2.0f, 0.0f, 1.0f), 3, {3, 1}); // +X (right)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(2.0f, 1.0f, 0.0f), 3, {3, 1}); // +X (right)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(2.0f, 1.0f, 1.0f), 3, {3, 1}); // +X (right)
+
+        MeshUtils::PushQuad(mesh, AZ::Vector3(0.0f, 2.0f, 0.0f), 4, {3, 1}); // +Y (top)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(0.0f, 2.0f, 1.0f), 4, {3, 1}); // +Y (top)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(1.0f, 2.0f, 0.0f), 4, {3, 1}); // +Y (top)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(1.0f, 2.0f, 1.0f), 4, {3, 1}); // +Y (top)
+
+        MeshUtils::PushQuad(mesh, AZ::Vector3(0.0f, 0.0f, 0.0f), 5, {3, 1}); // -Y (bottom)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(0.0f, 0.0f, 1.0f), 5, {3, 1}); // -Y (bottom)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(1.0f, 0.0f, 0.0f), 5, {3, 1}); // -Y (bottom)
+        MeshUtils::PushQuad(mesh, AZ::Vector3(1.0f, 0.0f, 1.0f), 5, {3, 1}); // -Y (bottom)
+    }
+
+    AZ::Data::Asset<AZ::RPI::ModelAsset> ModelBuilder::BuildCube(const ModelBuildSettings& settings)
+    {
+        return CreateCachedModel(AZ::Name("ProceduralCube"), HashText("BuildCube"), &GenerateCube, settings);
+    }
+
+    AZ::Data::Asset<AZ::RPI::ModelAsset> ModelBuilder::BuildOctCube(const ModelBuildSettings& settings)
+    {
+        return CreateCachedModel(AZ::Name("ProceduralCube"), HashText("BuildOctCube"), &GenerateOctCube, settings);
+    }
+} // namespace CustomGem
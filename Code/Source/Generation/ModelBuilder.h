@@ -0,0 +1,280 @@
+#pragma once
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "MeshUtils.h"
+
+#include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/Math/Aabb.h>
+#include <AzCore/Name/Name.h>
+#include <AzCore/Utils/TypeHash.h>
+#include <AzCore/std/functional.h>
+#include <AzCore/std/containers/span.h>
+#include <AzCore/std/containers/vector.h>
+
+#include <Atom/RHI.Reflect/Format.h>
+#include <Atom/RHI.Reflect/BufferViewDescriptor.h>
+#include <Atom/RPI.Reflect/Model/ModelAsset.h>
+#include <Atom/RPI.Reflect/Model/ModelLodAssetCreator.h>
+
+namespace CustomGem
+{
+    //! How vertex attribute streams are stored in buffer assets.
+    enum class VertexBufferLayout : uint8_t
+    {
+        //! One buffer asset per attribute stream.
+        Separate,
+        //! All attribute streams packed back to back into one buffer asset, with one
+        //! offset view per semantic. The RPI derives a stream's byte offset and stride from
+        //! whole elements of its view, so attributes are stored as aligned blocks rather
+        //! than interleaved per vertex.
+        SingleBuffer,
+    };
+
+    //! Precision of the shading attribute streams.
+    enum class VertexProfile : uint8_t
+    {
+        //! float3 normal, float4 tangent, float3 bitangent, float2 uv (64 bytes per vertex with positions).
+        Full,
+        //! Octahedral snorm16x2 normal and tangent with the handedness folded into the tangent,
+        //! no bitangent stream and half-float uvs (24 bytes per vertex with positions).
+        //! Materials must decode the octahedral normal/tangent, see VertexCompression.
+        Quantized,
+    };
+
+    //! Index buffer format selection.
+    enum class IndexBufferFormat : uint8_t
+    {
+        //! R16_UINT when the mesh has fewer than 65536 vertices, R32_UINT otherwise.
+        Auto,
+        //! R16_UINT; falls back to R32_UINT with a warning when the mesh is too large.
+        Uint16,
+        //! Always R32_UINT.
+        Uint32,
+    };
+
+    //! One generated LOD below LOD 0. Simplification stops at whichever limit is reached first.
+    struct ModelLodSettings
+    {
+        //! Target triangle count as a fraction of LOD 0
+        float triangleRatio = 0.5f;
+        //! Largest allowed simplification error, relative to the extent of the mesh bounds
+        float maxError = 1.0f;
+    };
+
+    //! Where the time of a model build goes, summed over all of its LODs. Only builds that miss
+    //! ModelCache are measured; a cache hit leaves every field unchanged.
+    struct ModelBuildTimings
+    {
+        //! Bounds and stream validation of every mesh
+        double boundsSeconds = 0.0;
+        //! Creating buffer assets, including the copy of the stream data
+        double bufferSeconds = 0.0;
+        //! The whole build, from the first LOD to the finished model asset
+        double totalSeconds = 0.0;
+        uint64_t bufferBytes = 0;
+        uint32_t bufferCount = 0;
+
+        //! Optimization, LOD simplification and assembling the LOD and model assets
+        double GetAssemblySeconds() const { return totalSeconds - boundsSeconds - bufferSeconds; }
+    };
+
+    //! Per-model options for ModelBuilder::CreateModel.
+    struct ModelBuildSettings
+    {
+        IndexBufferFormat indexFormat = IndexBufferFormat::Auto;
+        VertexBufferLayout vertexLayout = VertexBufferLayout::Separate;
+        VertexProfile vertexProfile = VertexProfile::Full;
+        //! Run MeshOptimizer on a copy of the mesh before upload; cg_modelBuilderVerbose logs the cache metrics
+        bool optimizeMesh = false;
+        OptimizeSettings optimizeSettings;
+        //! LODs generated after LOD 0 with MeshSimplifier, finest first. Empty builds a single LOD.
+        AZStd::vector<ModelLodSettings> lods;
+        //! Share models built from identical input through ModelCache. Cached models get asset ids
+        //! derived from the content hash, so regenerated output keeps its ids between runs.
+        bool useModelCache = true;
+        //! Let CreateCachedModel read and write generator output from ModelDiskCache
+        bool useDiskCache = true;
+        //! When set, the build adds its phase timings here; concurrent builds need one each.
+        //! Not part of the content hash.
+        ModelBuildTimings* timings = nullptr;
+    };
+
+    //! One mesh of a multi-material model. Submeshes with the same materialSlotId share that slot;
+    //! the slot takes the name of the first submesh using it.
+    struct SubMesh
+    {
+        MeshStreams mesh;
+        uint32_t materialSlotId = 0;
+        AZ::Name materialSlotName;
+    };
+
+    //! Minimal extraction of O3DE's ModelAssetHelpers "create model" logic.
+    struct ModelBuilder
+    {
+        //! Version of the generators and of the cached mesh format. Bump it whenever generated
+        //! geometry changes; ModelDiskCache drops everything written by other versions.
+        static constexpr uint32_t BuilderVersion = 1;
+
+        //! Fills a MeshData; the output must depend only on what went into the generator key
+        using GenerateFunction = AZStd::function<void(MeshData& mesh)>;
+
+        //! Build a single-mesh ModelAsset from raw arrays, plus the LOD chain in settings.lods.
+        //! All spans are tightly packed (no stride) and use the formats noted below.
+        //! Formats:
+        //!   indices:    uint32 (R32_UINT) or uint16 (R16_UINT), see settings.indexFormat
+        //!   positions:  float3 (R32G32B32_FLOAT)
+        //!   normals:    float3 (R32G32B32_FLOAT)
+        //!   tangents:   float4 (R32G32B32A32_FLOAT)
+        //!   bitangents: float3 (R32G32B32_FLOAT)
+        //!   uvs:        float2 (R32G32_FLOAT)
+        //! settings.vertexProfile decides the formats the streams are uploaded with. An index past the
+        //! last vertex fails the build with an error and returns an empty asset.
+        static AZ::Data::Asset<AZ::RPI::ModelAsset> CreateModel(
+            const AZ::Name& name,
+            const MeshStreams& mesh,
+            const ModelBuildSettings& settings = {});
+
+        static AZ::Data::Asset<AZ::RPI::ModelAsset> CreateModel(
+            const AZ::Name& name,
+            AZStd::span<const uint32_t> indices,
+            AZStd::span<const float> positions,
+            AZStd::span<const float> normals,
+            AZStd::span<const float> tangents,
+            AZStd::span<const float> bitangents,
+            AZStd::span<const float> uvs,
+            const ModelBuildSettings& settings = {});
+
+        static AZ::Data::Asset<AZ::RPI::ModelAsset> CreateModel(
+            const AZ::Name& name,
+            const MeshData& mesh,
+            const ModelBuildSettings& settings = {});
+
+        //! Same as above, but takes ownership of mesh and frees each stream as soon as it has been
+        //! copied into its buffer asset, so with the Separate layout the build needs one stream of headroom
+        //! instead of a second copy of the whole mesh. SingleBuffer still packs every stream into one
+        //! staging copy while they are alive, so its peak stays a full second copy of the vertex data.
+        //! Optimization runs in place; with LODs, LOD 0 is welded in place before it is simplified,
+        //! which is what the copying overloads upload as LOD 0 too. The mesh is left empty, also on a
+        //! cache hit. cg_modelBuilderVerbose logs the peak RSS.
+        static AZ::Data::Asset<AZ::RPI::ModelAsset> CreateModel(
+            const AZ::Name& name,
+            MeshData&& mesh,
+            const ModelBuildSettings& settings = {});
+
+        //! Build a model with one mesh per submesh in every LOD, each bound to its submesh's material slot.
+        //! When all submeshes carry the same streams they share one index buffer and one buffer per vertex
+        //! stream (one buffer in total with SingleBuffer); each mesh addresses its range through the element
+        //! offsets of its views, so indices stay local to their submesh.
+        static AZ::Data::Asset<AZ::RPI::ModelAsset> CreateModel(
+            const AZ::Name& name,
+            AZStd::span<const SubMesh> subMeshes,
+            const ModelBuildSettings& settings = {});
+        
+        //! Build a model from generator output that is kept in ModelDiskCache across sessions.
+        //! generatorKey must hash every parameter of the generator; it is combined with the name and
+        //! BuilderVersion. ModelCache is checked first under that key and the build settings; only on a
+        //! miss is ModelDiskCache consulted, and on a disk hit generate() is skipped and the stored mesh
+        //! is uploaded instead.
+        static AZ::Data::Asset<AZ::RPI::ModelAsset> CreateCachedModel(
+            const AZ::Name& name,
+            AZ::HashValue64 generatorKey,
+            const GenerateFunction& generate,
+            const ModelBuildSettings& settings = {});
+
+        static AZ::Data::Asset<AZ::RPI::ModelAsset> BuildPlane();
+        static AZ::Data::Asset<AZ::RPI::ModelAsset> BuildPlane(const AZ::Vector3& pos);
+        static AZ::Data::Asset<AZ::RPI::ModelAsset> BuildPlane(const float x, const float y, const float z);
+        static AZ::Data::Asset<AZ::RPI::ModelAsset> BuildCube(const ModelBuildSettings& settings = {});
+        static AZ::Data::Asset<AZ::RPI::ModelAsset> BuildOctCube(const ModelBuildSettings& settings = {});
+
+        //! Hash of everything that goes into a model: name, build settings, material slots and streams.
+        static AZ::HashValue64 ComputeContentHash(
+            const AZ::Name& name, AZStd::span<const SubMesh> subMeshes, const ModelBuildSettings& settings);
+
+        //! Returns the model's buffers to the shared pool registry and drops the caller's reference.
+        //! Call this once for every model created here that is being thrown away; a cached model keeps
+        //! its buffers until every caller that received it has released it.
+        static void ReleaseModel(AZ::Data::Asset<AZ::RPI::ModelAsset>& model);
+
+        //! Evicts cached models nobody holds a handle to any more (see ModelCache::ReleaseUnused) and
+        //! returns their buffers to the pool registry. Returns the number of models released.
+        static uint32_t ReleaseUnusedModels();
+
+    private:
+        //! Generators behind BuildCube() and BuildOctCube()
+        static void GenerateCube(MeshData& mesh);
+        static void GenerateOctCube(MeshData& mesh);
+
+        //! Asset ids of one model build. Cached builds put every asset of the model under the model's
+        //! guid with sequential sub ids; otherwise each asset gets a random guid. Also carries the
+        //! build's ModelBuildSettings::timings down to the buffer and bounds passes.
+        struct AssetIds
+        {
+            AZ::Uuid guid = AZ::Uuid::CreateNull();
+            uint32_t nextSubId = 1;
+            ModelBuildTimings* timings = nullptr;
+
+            AZ::Data::AssetId Next();
+        };
+
+        //! Builds all LODs and the model asset, bypassing the cache. Returns an empty asset when an
+        //! index is out of range.
+        static AZ::Data::Asset<AZ::RPI::ModelAsset> BuildModel(
+            AssetIds& ids, const AZ::Name& name, AZStd::span<const SubMesh> subMeshes, const ModelBuildSettings& settings);
+
+        //! Builds all LODs and the model asset from an owned mesh, emptying it along the way. Returns
+        //! an empty asset when an index is out of range.
+        static AZ::Data::Asset<AZ::RPI::ModelAsset> BuildOwnedModel(
+            AssetIds& ids, const AZ::Name& name, MeshData& mesh, const ModelBuildSettings& settings);
+
+        //! Simplifies base, the welded LOD 0 of each submesh, into the chain of settings.lods.
+        //! Returns one entry per LOD below LOD 0 holding one mesh per submesh; the chain ends early
+        //! once a LOD no longer shrinks.
+        static AZStd::vector<AZStd::vector<MeshData>> GenerateLodMeshes(
+            const AZ::Name& name, AZStd::span<const MeshData> base, const ModelBuildSettings& settings);
+
+        //! Builds one LOD holding one mesh per submesh, running the optimize stage first when enabled.
+        static AZ::Data::Asset<AZ::RPI::ModelLodAsset> BuildLodAsset(
+            AssetIds& ids, const AZ::Name& name, AZStd::span<const SubMesh> subMeshes, const ModelBuildSettings& settings);
+
+        //! Builds a single-mesh LOD from mesh, optimizing it in place when enabled and freeing every
+        //! stream once it is uploaded.
+        static AZ::Data::Asset<AZ::RPI::ModelLodAsset> BuildOwnedLodAsset(
+            AssetIds& ids, const AZ::Name& name, MeshData& mesh, const ModelBuildSettings& settings);
+
+        //! Adds one mesh per submesh to lodCreator, all sharing the same index and vertex buffers.
+        static void AddSharedMeshes(
+            AssetIds& ids,
+            const AZ::Name& name,
+            AZ::RPI::ModelLodAssetCreator& lodCreator,
+            AZStd::span<const SubMesh> subMeshes,
+            const ModelBuildSettings& settings);
+
+        //! Wraps the LODs, finest first, into a ModelAsset with the submeshes' material slots.
+        static AZ::Data::Asset<AZ::RPI::ModelAsset> BuildModelAsset(
+            AssetIds& ids,
+            const AZ::Name& name,
+            AZStd::span<const SubMesh> subMeshes,
+            AZStd::span<AZ::Data::Asset<AZ::RPI::ModelLodAsset>> lods);
+
+        //! Creates a buffer asset holding a copy of data. All buffers share pools through BufferPoolRegistry.
+        static AZ::Data::Asset<AZ::RPI::BufferAsset> MakeBufferAsset(
+            AssetIds& ids, const void* data, uint32_t elementCount, uint32_t elementSize);
+
+        //! Whether the mesh's index buffer is uploaded as R16_UINT.
+        static bool Uses16BitIndices(const MeshStreams& mesh, const ModelBuildSettings& settings);
+
+        //! Sets the index buffer of the mesh currently open in lodCreator.
+        static void SetIndexBuffer(
+            AssetIds& ids, AZ::RPI::ModelLodAssetCreator& lodCreator, const MeshStreams& mesh, const ModelBuildSettings& settings);
+
+        //! Adds the vertex attribute streams of mesh to the mesh currently open in lodCreator.
+        //! When owner is set, mesh must view it and each stream of owner is freed once it is no longer needed.
+        static void AddVertexStreams(
+            AssetIds& ids,
+            AZ::RPI::ModelLodAssetCreator& lodCreator,
+            const MeshStreams& mesh,
+            const ModelBuildSettings& settings,
+            MeshData* owner = nullptr);
+    };
+} // namespace CustomGem
@@ -0,0 +1,117 @@
+#include "ModelCache.h"
+
+#include <AzCore/std/string/string.h>
+
+namespace CustomGem
+{
+    using namespace AZ;
+    using namespace AZ::RPI;
+
+    ModelCache& ModelCache::Get()
+    {
+        static ModelCache s_cache;
+        return s_cache;
+    }
+
+    Data::Asset<ModelAsset> ModelCache::FindOrCreate(HashValue64 contentHash, const BuildFunction& build)
+    {
+        const uint64_t key = static_cast<uint64_t>(contentHash);
+
+        AZStd::unique_lock<AZStd::mutex> lock(m_mutex);
+        auto it = m_entries.find(key);
+        while (it != m_entries.end() && it->second.building)
+        {
+            m_buildDone.wait(lock);
+            it = m_entries.find(key);
+        }
+
+        if (it != m_entries.end())
+        {
+            ++it->second.users;
+            ++m_hits;
+            return it->second.model;
+        }
+
+        ++m_misses;
+        m_entries[key].building = true;
+        const uint32_t generation = m_generations[key];
+        lock.unlock();
+
+        const Uuid guid = Uuid::CreateName(AZStd::string::format("CustomGem/Model/%016llx/%u",
+            static_cast<unsigned long long>(key), generation).c_str());
+        Data::Asset<ModelAsset> model = build(guid);
+
+        lock.lock();
+        it = m_entries.find(key);
+        if (!model)
+        {
+            m_entries.erase(it);
+        }
+        else
+        {
+            it->second.model = model;
+            it->second.users = 1;
+            it->second.building = false;
+            m_hashByGuid[model.GetId().m_guid] = key;
+        }
+        m_buildDone.notify_all();
+        return model;
+    }
+
+    bool ModelCache::Release(const Data::AssetId& modelId)
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        auto hashIt = m_hashByGuid.find(modelId.m_guid);
+        if (hashIt == m_hashByGuid.end())
+        {
+            return true;
+        }
+
+        auto it = m_entries.find(hashIt->second);
+        AZ_Assert(it != m_entries.end(), "ModelCache: guid without an entry");
+        if (--it->second.users > 0)
+        {
+            return false;
+        }
+
+        ++m_generations[hashIt->second];
+        m_entries.erase(it);
+        m_hashByGuid.erase(hashIt);
+        return true;
+    }
+
+    uint32_t ModelCache::ReleaseUnused(AZStd::vector<Data::Asset<ModelAsset>>& evicted)
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+
+        uint32_t released = 0;
+        for (auto it = m_entries.begin(); it != m_entries.end();)
+        {
+            // The entry's own handle is the only remaining reference
+            const Data::AssetData* data = it->second.model.Get();
+            if (!it->second.building && (!data || data->GetUseCount() <= 1))
+            {
+                ++m_generations[it->first];
+                m_hashByGuid.erase(it->second.model.GetId().m_guid);
+                evicted.push_back(AZStd::move(it->second.model));
+                it = m_entries.erase(it);
+                ++released;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        return released;
+    }
+
+    ModelCacheStats ModelCache::GetStats() const
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        ModelCacheStats stats;
+        stats.liveModels = static_cast<uint32_t>(m_hashByGuid.size());
+        stats.hits = m_hits;
+        stats.misses = m_misses;
+        return stats;
+    }
+} // namespace CustomGem
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/Utils/TypeHash.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/functional.h>
+#include <AzCore/std/parallel/conditional_variable.h>
+#include <AzCore/std/parallel/mutex.h>
+
+#include <Atom/RPI.Reflect/Model/ModelAsset.h>
+
+namespace CustomGem
+{
+    //! Snapshot of the generated-model cache.
+    struct ModelCacheStats
+    {
+        uint32_t liveModels = 0;  // cached models with at least one user
+        uint64_t hits = 0;        // requests answered with an existing model
+        uint64_t misses = 0;      // requests that built a new model
+    };
+
+    //! In-memory cache of generated models keyed by a content hash of their input
+    //! (see ModelBuilder::ComputeContentHash). Every FindOrCreate() counts one user of the model and
+    //! every ModelBuilder::ReleaseModel() drops one; the entry goes away with its last user.
+    //! Callers that simply drop their handle are covered by ReleaseUnused(), which evicts entries
+    //! whose asset is referenced by nothing but the cache.
+    class ModelCache
+    {
+    public:
+        static ModelCache& Get();
+
+        //! Builds the model; every asset it creates must use guid, which is derived from the content hash
+        using BuildFunction = AZStd::function<AZ::Data::Asset<AZ::RPI::ModelAsset>(const AZ::Uuid& guid)>;
+
+        //! Returns the model built from the content with this hash and counts one more user.
+        //! On a miss build() runs outside the lock; concurrent requests for the same hash wait for it.
+        //! The guid is stable between runs for the first build of a hash in a session, a model rebuilt
+        //! after its entry was dropped gets a new guid so it never collides with assets still in flight.
+        AZ::Data::Asset<AZ::RPI::ModelAsset> FindOrCreate(AZ::HashValue64 contentHash, const BuildFunction& build);
+
+        //! Drops one user of the model. Returns true when the caller held the last reference the
+        //! cache knows of (or the model is not cached) and its buffers can be released.
+        bool Release(const AZ::Data::AssetId& modelId);
+
+        //! Evicts every finished entry whose asset has no reference left besides the cache's own,
+        //! whatever its user count, and appends those models to evicted so their buffers can be
+        //! released. Returns the number of entries evicted.
+        uint32_t ReleaseUnused(AZStd::vector<AZ::Data::Asset<AZ::RPI::ModelAsset>>& evicted);
+
+        ModelCacheStats GetStats() const;
+
+    private:
+        struct Entry
+        {
+            AZ::Data::Asset<AZ::RPI::ModelAsset> model;
+            uint32_t users = 0;
+            bool building = false;
+        };
+
+        mutable AZStd::mutex m_mutex;
+        AZStd::condition_variable m_buildDone;
+        AZStd::unordered_map<uint64_t, Entry> m_entries;
+        AZStd::unordered_map<AZ::Uuid, uint64_t> m_hashByGuid;
+        //! Number of times each hash has been evicted, folded into the next guid
+        AZStd::unordered_map<uint64_t, uint32_t> m_generations;
+        uint64_t m_hits = 0;
+        uint64_t m_misses = 0;
+    };
+} // namespace CustomGem
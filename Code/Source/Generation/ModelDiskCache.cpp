@@ -0,0 +1,275 @@
+#include "ModelDiskCache.h"
+#include "MeshFile.h"
+#include "ModelBuilder.h"
+
+#include <AzCore/IO/FileIO.h>
+#include <AzCore/Math/Uuid.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/sort.h>
+#include <AzCore/std/time.h>
+
+namespace CustomGem
+{
+    using namespace AZ;
+
+    namespace
+    {
+        constexpr const char* CacheRoot = "@user@/CustomCppToolGem/ModelCache";
+    } // namespace
+
+    ModelDiskCache& ModelDiskCache::Get()
+    {
+        static ModelDiskCache s_cache;
+        return s_cache;
+    }
+
+    AZStd::string ModelDiskCache::GetDirectory() const
+    {
+        return AZStd::string::format("%s/v%u", CacheRoot, ModelBuilder::BuilderVersion);
+    }
+
+    AZStd::string ModelDiskCache::GetFilePath(uint64_t key) const
+    {
+        return AZStd::string::format("%s/%016llx.mesh", GetDirectory().c_str(), static_cast<unsigned long long>(key));
+    }
+
+    void ModelDiskCache::EnsureIndex()
+    {
+        if (m_indexed)
+        {
+            return;
+        }
+        m_indexed = true;
+
+        IO::FileIOBase* fileIO = IO::FileIOBase::GetInstance();
+        if (!fileIO)
+        {
+            return;
+        }
+
+        // Output of other builder versions can never be read again
+        const AZStd::string directory = GetDirectory();
+        const AZStd::string versionSuffix = AZStd::string::format("/v%u", ModelBuilder::BuilderVersion);
+        AZStd::vector<AZStd::string> staleDirectories;
+        fileIO->FindFiles(CacheRoot, "v*", [&](const char* path)
+        {
+            if (fileIO->IsDirectory(path) && !AZStd::string_view(path).ends_with(versionSuffix))
+            {
+                staleDirectories.emplace_back(path);
+            }
+            return true;
+        });
+        for (const AZStd::string& path : staleDirectories)
+        {
+            AZ_Printf("CustomGem", "Removing model cache of an older builder version: %s\n", path.c_str());
+            fileIO->DestroyPath(path.c_str());
+        }
+
+        fileIO->CreatePath(directory.c_str());
+        AZStd::vector<AZStd::string> unreadable;
+        fileIO->FindFiles(directory.c_str(), "*.mesh", [&](const char* path)
+        {
+            MeshFileHeader header;
+            uint64_t bytes = 0;
+            if (MeshFile::ReadHeader(path, header) && header.generatorVersion == ModelBuilder::BuilderVersion &&
+                fileIO->Size(path, bytes))
+            {
+                m_index[header.key] = { bytes, header.lastAccess };
+                m_totalBytes += bytes;
+            }
+            else
+            {
+                // Older mesh file formats, or files left half written
+                unreadable.emplace_back(path);
+            }
+            return true;
+        });
+        for (const AZStd::string& path : unreadable)
+        {
+            fileIO->Remove(path.c_str());
+        }
+    }
+
+    bool ModelDiskCache::Open(HashValue64 contentKey, MappedMeshFile& file)
+    {
+        file.Close();
+        const uint64_t key = static_cast<uint64_t>(contentKey);
+        bool writeAccess = false;
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+            EnsureIndex();
+            auto it = m_index.find(key);
+            if (!IO::FileIOBase::GetInstance() || it == m_index.end())
+            {
+                ++m_misses;
+                return false;
+            }
+            writeAccess = !it->second.accessWritten;
+            it->second.accessWritten = true;
+        }
+
+        // Only the access time changes, once per session; the rest of the file is left alone
+        const AZStd::string path = GetFilePath(key);
+        const uint64_t lastAccess = AZStd::GetTimeUTCMilliSecond();
+        const bool loaded = (!writeAccess || MeshFile::WriteLastAccess(path.c_str(), lastAccess)) && file.Open(path.c_str()) &&
+            file.GetHeader().key == key && file.GetHeader().generatorVersion == ModelBuilder::BuilderVersion;
+
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        if (!loaded)
+        {
+            AZ_Warning("CustomGem", false, "Dropping unreadable model cache file %s", path.c_str());
+            file.Close();
+            IO::FileIOBase::GetInstance()->Remove(path.c_str());
+            auto it = m_index.find(key);
+            if (it != m_index.end())
+            {
+                m_totalBytes -= it->second.bytes;
+                m_index.erase(it);
+            }
+            ++m_misses;
+            return false;
+        }
+
+        auto it = m_index.find(key);
+        if (it != m_index.end())
+        {
+            it->second.lastAccess = lastAccess;
+        }
+        ++m_hits;
+        return true;
+    }
+
+    bool ModelDiskCache::Load(HashValue64 key, MeshData& mesh)
+    {
+        MappedMeshFile file;
+        if (!Open(key, file))
+        {
+            mesh.Clear();
+            return false;
+        }
+        file.CopyTo(mesh);
+        return true;
+    }
+
+    void ModelDiskCache::Store(HashValue64 contentKey, const MeshData& mesh)
+    {
+        const uint64_t key = static_cast<uint64_t>(contentKey);
+        IO::FileIOBase* fileIO = IO::FileIOBase::GetInstance();
+        if (!fileIO)
+        {
+            return;
+        }
+
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+            EnsureIndex();
+        }
+
+        MeshFileWriteSettings writeSettings;
+        writeSettings.generatorVersion = ModelBuilder::BuilderVersion;
+        writeSettings.key = key;
+        writeSettings.lastAccess = AZStd::GetTimeUTCMilliSecond();
+
+        // Write to a private file and move it into place so readers never see a partial file
+        const AZStd::string path = GetFilePath(key);
+        const AZStd::string tempPath = path + "." + Uuid::CreateRandom().ToString<AZStd::string>(false, false);
+        const uint64_t bytes = MeshFile::Write(tempPath.c_str(), mesh, writeSettings);
+        const bool written = bytes > 0;
+
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        fileIO->Remove(path.c_str());
+        if (written && fileIO->Rename(tempPath.c_str(), path.c_str()))
+        {
+            IndexEntry& entry = m_index[key];
+            m_totalBytes += bytes - entry.bytes;
+            entry = { bytes, writeSettings.lastAccess, true };
+            Trim();
+            return;
+        }
+        fileIO->Remove(tempPath.c_str());
+
+        // Windows refuses to remove or replace a file that is mapped, for example by a MappedMeshFile
+        // still uploading it. The file in place holds the same key, so it is kept when it is intact.
+        MeshFileHeader header;
+        uint64_t existingBytes = 0;
+        if (MeshFile::ReadHeader(path.c_str(), header) && header.key == key &&
+            header.generatorVersion == ModelBuilder::BuilderVersion && fileIO->Size(path.c_str(), existingBytes))
+        {
+            IndexEntry& entry = m_index[key];
+            m_totalBytes += existingBytes - entry.bytes;
+            entry = { existingBytes, writeSettings.lastAccess, entry.accessWritten };
+            return;
+        }
+
+        AZ_Warning("CustomGem", false, "Could not write model cache file %s", path.c_str());
+        auto it = m_index.find(key);
+        if (it != m_index.end())
+        {
+            m_totalBytes -= it->second.bytes;
+            m_index.erase(it);
+        }
+    }
+
+    void ModelDiskCache::Trim()
+    {
+        if (m_totalBytes <= m_maxBytes)
+        {
+            return;
+        }
+
+        AZStd::vector<AZStd::pair<uint64_t, uint64_t>> byAge; // lastAccess, key
+        byAge.reserve(m_index.size());
+        for (const auto& entry : m_index)
+        {
+            byAge.emplace_back(entry.second.lastAccess, entry.first);
+        }
+        AZStd::sort(byAge.begin(), byAge.end());
+
+        IO::FileIOBase* fileIO = IO::FileIOBase::GetInstance();
+        for (const auto& [lastAccess, key] : byAge)
+        {
+            if (m_totalBytes <= m_maxBytes)
+            {
+                break;
+            }
+
+            fileIO->Remove(GetFilePath(key).c_str());
+            m_totalBytes -= m_index[key].bytes;
+            m_index.erase(key);
+            ++m_evictions;
+        }
+    }
+
+    void ModelDiskCache::SetMaxBytes(uint64_t maxBytes)
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        m_maxBytes = maxBytes;
+        EnsureIndex();
+        Trim();
+    }
+
+    void ModelDiskCache::Clear()
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        if (IO::FileIOBase* fileIO = IO::FileIOBase::GetInstance())
+        {
+            fileIO->DestroyPath(GetDirectory().c_str());
+            fileIO->CreatePath(GetDirectory().c_str());
+        }
+        m_index.clear();
+        m_totalBytes = 0;
+        m_indexed = true;
+    }
+
+    ModelDiskCacheStats ModelDiskCache::GetStats() const
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_mutex);
+        ModelDiskCacheStats stats;
+        stats.entries = static_cast<uint32_t>(m_index.size());
+        stats.bytes = m_totalBytes;
+        stats.hits = m_hits;
+        stats.misses = m_misses;
+        stats.evictions = m_evictions;
+        return stats;
+    }
+} // namespace CustomGem
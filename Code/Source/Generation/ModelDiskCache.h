@@ -0,0 +1,81 @@
+#pragma once
+
+#include "MeshUtils.h"
+
+#include <AzCore/Utils/TypeHash.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/string/string.h>
+
+namespace CustomGem
+{
+    class MappedMeshFile;
+
+    //! Snapshot of the on-disk mesh cache.
+    struct ModelDiskCacheStats
+    {
+        uint32_t entries = 0;   // files in the current version directory
+        uint64_t bytes = 0;     // total size of those files
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0; // files removed by the size limit
+    };
+
+    //! Persistent cache of generator output under @user@/CustomCppToolGem/ModelCache/v<version>.
+    //! One MeshFile per key holds the MeshData streams. Hits update the access time in the index;
+    //! the file's lastAccess field is patched in place only on a key's first hit of the session, so
+    //! the least recently used files are dropped first once the cache grows past its size limit
+    //! without a write on every hit. Directories of other versions are deleted on first use, which invalidates
+    //! everything when ModelBuilder::BuilderVersion changes, and files of older MeshFile formats
+    //! are deleted when the directory is scanned.
+    class ModelDiskCache
+    {
+    public:
+        static ModelDiskCache& Get();
+
+        //! Maps the mesh stored under key into file, whose streams can be uploaded in place.
+        //! Returns false on a miss or a damaged file.
+        bool Open(AZ::HashValue64 key, MappedMeshFile& file);
+
+        //! Same as Open, copying the streams into mesh.
+        bool Load(AZ::HashValue64 key, MeshData& mesh);
+
+        //! Writes mesh under key, replacing any previous file, then trims to the size limit. When the
+        //! previous file cannot be replaced, as on Windows while it is mapped, an intact one is kept.
+        void Store(AZ::HashValue64 key, const MeshData& mesh);
+
+        //! Size limit of the cache directory; 512 MiB by default.
+        void SetMaxBytes(uint64_t maxBytes);
+
+        //! Remove every file of the current version.
+        void Clear();
+
+        ModelDiskCacheStats GetStats() const;
+
+    private:
+        struct IndexEntry
+        {
+            uint64_t bytes = 0;
+            uint64_t lastAccess = 0;
+            //! The file's lastAccess was written this session, by Store() or an earlier hit
+            bool accessWritten = false;
+        };
+
+        //! Scans the cache directory on first use; requires m_mutex.
+        void EnsureIndex();
+        //! Drops least recently used files until the cache fits; requires m_mutex.
+        void Trim();
+
+        AZStd::string GetDirectory() const;
+        AZStd::string GetFilePath(uint64_t key) const;
+
+        mutable AZStd::mutex m_mutex;
+        bool m_indexed = false;
+        AZStd::unordered_map<uint64_t, IndexEntry> m_index;
+        uint64_t m_totalBytes = 0;
+        uint64_t m_maxBytes = 512ull * 1024 * 1024;
+        uint64_t m_hits = 0;
+        uint64_t m_misses = 0;
+        uint64_t m_evictions = 0;
+    };
+} // namespace CustomGem
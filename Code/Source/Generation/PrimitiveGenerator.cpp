@@ -0,0 +1,208 @@
+#include "PrimitiveGenerator.h"
+
+#include <AzCore/Math/MathUtils.h>
+
+#include <cmath>
+
+namespace CustomGem
+{
+    namespace
+    {
+        //! Appends a (columns + 1) x (rows + 1) vertex grid spanning origin + [0, 1] uAxis + [0, 1] vAxis.
+        //! Uvs run from 0 to 1 along the axes, so the tangent follows uAxis and the bitangent vAxis.
+        //! Triangles wind counter-clockwise around normal.
+        void AppendGrid(
+            MeshData& mesh, const AZ::Vector3& origin, const AZ::Vector3& uAxis, const AZ::Vector3& vAxis,
+            const AZ::Vector3& normal, uint32_t columns, uint32_t rows)
+        {
+            const uint32_t first = static_cast<uint32_t>(mesh.GetVertexCount());
+            const AZ::Vector3 tangent = uAxis.GetNormalized();
+            const AZ::Vector3 bitangent = vAxis.GetNormalized();
+            mesh.Reserve(first + (columns + 1) * (rows + 1), mesh.GetIndexCount() + columns * rows * 6);
+
+            // Where tangent x bitangent points away from the normal the handedness goes into w
+            const bool flip = uAxis.Cross(vAxis).Dot(normal) < 0.0f;
+            for (uint32_t row = 0; row <= rows; ++row)
+            {
+                const float v = static_cast<float>(row) / rows;
+                for (uint32_t column = 0; column <= columns; ++column)
+                {
+                    const float u = static_cast<float>(column) / columns;
+                    MeshUtils::PushVertex(mesh, origin + uAxis * u + vAxis * v, normal, tangent, bitangent, u, v);
+                    mesh.tangents.back() = flip ? -1.0f : 1.0f;
+                }
+            }
+
+            for (uint32_t row = 0; row < rows; ++row)
+            {
+                for (uint32_t column = 0; column < columns; ++column)
+                {
+                    const uint32_t a = first + row * (columns + 1) + column;
+                    const uint32_t b = a + 1;
+                    const uint32_t c = b + columns + 1;
+                    const uint32_t d = a + columns + 1;
+                    if (flip)
+                    {
+                        mesh.AppendIndices({ a, c, b, a, d, c });
+                    }
+                    else
+                    {
+                        mesh.AppendIndices({ a, b, c, a, c, d });
+                    }
+                }
+            }
+        }
+
+        void GeneratePlane(const PrimitiveDesc& desc, MeshData& mesh)
+        {
+            const AZ::Vector3 uAxis(desc.size.GetX(), 0.0f, 0.0f);
+            const AZ::Vector3 vAxis(0.0f, desc.size.GetY(), 0.0f);
+            AppendGrid(mesh, (uAxis + vAxis) * -0.5f, uAxis, vAxis, AZ::Vector3::CreateAxisZ(), desc.segments, desc.segments);
+        }
+
+        void GenerateBox(const PrimitiveDesc& desc, MeshData& mesh)
+        {
+            const AZ::Vector3 half = desc.size * 0.5f;
+            for (const FaceBasis& basis : FaceBases)
+            {
+                const AZ::Vector3 normal = AZ::Vector3::CreateFromFloat3(basis.normal);
+                const AZ::Vector3 uAxis = AZ::Vector3::CreateFromFloat3(basis.tangent) * desc.size.GetElement(basis.tangentAxis);
+                const AZ::Vector3 vAxis = AZ::Vector3::CreateFromFloat3(basis.bitangent) * desc.size.GetElement(basis.bitangentAxis);
+                const AZ::Vector3 center = normal * half.GetElement(basis.normalAxis);
+                AppendGrid(mesh, center - (uAxis + vAxis) * 0.5f, uAxis, vAxis, normal, desc.segments, desc.segments);
+            }
+        }
+
+        void GenerateSphere(const PrimitiveDesc& desc, MeshData& mesh)
+        {
+            const float radius = desc.size.GetX() * 0.5f;
+            const uint32_t slices = desc.segments;
+            const uint32_t stacks = AZStd::max(desc.segments / 2, 2u);
+            const uint32_t first = static_cast<uint32_t>(mesh.GetVertexCount());
+            mesh.Reserve(first + (slices + 1) * (stacks + 1), mesh.GetIndexCount() + slices * (stacks - 1) * 6);
+
+            // Stacks run from the -Z pole to the +Z pole; the seam column is duplicated for the uvs
+            for (uint32_t stack = 0; stack <= stacks; ++stack)
+            {
+                const float v = static_cast<float>(stack) / stacks;
+                const float polar = AZ::Constants::Pi * v;
+                const float ringRadius = std::sin(polar);
+                const float height = -std::cos(polar);
+                for (uint32_t slice = 0; slice <= slices; ++slice)
+                {
+                    const float u = static_cast<float>(slice) / slices;
+                    const float azimuth = AZ::Constants::TwoPi * u;
+                    const float cosAzimuth = std::cos(azimuth);
+                    const float sinAzimuth = std::sin(azimuth);
+                    const AZ::Vector3 normal(ringRadius * cosAzimuth, ringRadius * sinAzimuth, height);
+                    const AZ::Vector3 tangent(-sinAzimuth, cosAzimuth, 0.0f);
+                    const AZ::Vector3 bitangent(-height * cosAzimuth, -height * sinAzimuth, ringRadius);
+                    MeshUtils::PushVertex(mesh, normal * radius, normal, tangent, bitangent, u, v);
+                }
+            }
+
+            // tangent x bitangent is the outward normal; the pole rows drop their degenerate triangle
+            for (uint32_t stack = 0; stack < stacks; ++stack)
+            {
+                for (uint32_t slice = 0; slice < slices; ++slice)
+                {
+                    const uint32_t a = first + stack * (slices + 1) + slice;
+                    const uint32_t b = a + 1;
+                    const uint32_t c = b + slices + 1;
+                    const uint32_t d = a + slices + 1;
+                    if (stack > 0)
+                    {
+                        mesh.AppendIndices({ a, b, c });
+                    }
+                    if (stack + 1 < stacks)
+                    {
+                        mesh.AppendIndices({ a, c, d });
+                    }
+                }
+            }
+        }
+
+        void GenerateHeightfield(const PrimitiveDesc& desc, MeshData& mesh)
+        {
+            const uint32_t columns = desc.heightsWidth - 1;
+            const uint32_t rows = static_cast<uint32_t>(desc.heights.size() / desc.heightsWidth) - 1;
+            const size_t first = mesh.GetVertexCount();
+            const AZ::Vector3 uAxis(desc.size.GetX(), 0.0f, 0.0f);
+            const AZ::Vector3 vAxis(0.0f, desc.size.GetY(), 0.0f);
+            AppendGrid(mesh, (uAxis + vAxis) * -0.5f, uAxis, vAxis, AZ::Vector3::CreateAxisZ(), columns, rows);
+
+            // The grid's vertex order matches the sample order
+            for (size_t i = 0; i < desc.heights.size(); ++i)
+            {
+                mesh.positions[(first + i) * 3 + 2] = desc.heights[i];
+            }
+            MeshUtils::GenerateNormals(mesh);
+            MeshUtils::GenerateTangents(mesh);
+        }
+    } // namespace
+
+    bool PrimitiveGenerator::Validate(const PrimitiveDesc& desc)
+    {
+        if (!desc.size.IsFinite() || desc.size.GetMinElement() <= 0.0f)
+        {
+            AZ_Warning("CustomGem", false, "Primitive size must be finite and positive");
+            return false;
+        }
+
+        switch (desc.shape)
+        {
+        case PrimitiveShape::Plane:
+        case PrimitiveShape::Box:
+            AZ_Warning("CustomGem", desc.segments >= 1 && desc.segments <= MaxSegments,
+                "Primitive segments must be between 1 and %u", MaxSegments);
+            return desc.segments >= 1 && desc.segments <= MaxSegments;
+        case PrimitiveShape::Sphere:
+            AZ_Warning("CustomGem", desc.segments >= 3 && desc.segments <= MaxSegments,
+                "Sphere segments must be between 3 and %u", MaxSegments);
+            return desc.segments >= 3 && desc.segments <= MaxSegments;
+        case PrimitiveShape::Heightfield:
+        {
+            const bool valid = desc.heightsWidth >= 2 && desc.heights.size() % desc.heightsWidth == 0 &&
+                desc.heights.size() / desc.heightsWidth >= 2 && desc.heights.size() <= UINT32_MAX / 6;
+            AZ_Warning("CustomGem", valid, "Heightfield needs at least 2 x 2 samples in rows of heightsWidth");
+            return valid;
+        }
+        }
+        return false;
+    }
+
+    void PrimitiveGenerator::Generate(const PrimitiveDesc& desc, MeshData& mesh)
+    {
+        mesh.use16BitIndices = mesh.GetIndexCount() == 0 || mesh.use16BitIndices;
+        switch (desc.shape)
+        {
+        case PrimitiveShape::Plane:
+            GeneratePlane(desc, mesh);
+            break;
+        case PrimitiveShape::Box:
+            GenerateBox(desc, mesh);
+            break;
+        case PrimitiveShape::Sphere:
+            GenerateSphere(desc, mesh);
+            break;
+        case PrimitiveShape::Heightfield:
+            GenerateHeightfield(desc, mesh);
+            break;
+        }
+    }
+
+    AZ::HashValue64 PrimitiveGenerator::ComputeKey(const PrimitiveDesc& desc)
+    {
+        // Field by field so padding never leaks in
+        const float size[3] = { desc.size.GetX(), desc.size.GetY(), desc.size.GetZ() };
+        AZ::HashValue64 hash = AZ::TypeHash64(static_cast<uint8_t>(desc.shape), AZ::HashValue64{ 0 });
+        hash = AZ::TypeHash64(reinterpret_cast<const uint8_t*>(size), sizeof(size), hash);
+        hash = AZ::TypeHash64(desc.segments, hash);
+        if (desc.shape == PrimitiveShape::Heightfield)
+        {
+            hash = AZ::TypeHash64(desc.heightsWidth, hash);
+            hash = AZ::TypeHash64(reinterpret_cast<const uint8_t*>(desc.heights.data()), desc.heights.size() * sizeof(float), hash);
+        }
+        return hash;
+    }
+} // namespace CustomGem
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "MeshUtils.h"
+
+#include <CustomCppToolGem/ProceduralModel.h>
+
+#include <AzCore/Utils/TypeHash.h>
+
+namespace CustomGem
+{
+    //! Meshes for the parametric shapes of PrimitiveDesc, with every vertex stream filled
+    struct PrimitiveGenerator
+    {
+        //! Largest segments value accepted for planes, boxes and spheres
+        static constexpr uint32_t MaxSegments = 1024;
+
+        //! Warns and returns false when desc cannot be generated
+        static bool Validate(const PrimitiveDesc& desc);
+
+        //! Appends the shape to mesh; desc must pass Validate
+        static void Generate(const PrimitiveDesc& desc, MeshData& mesh);
+
+        //! Hash of every field Generate reads, for ModelBuilder::CreateCachedModel
+        static AZ::HashValue64 ComputeKey(const PrimitiveDesc& desc);
+    };
+} // namespace CustomGem
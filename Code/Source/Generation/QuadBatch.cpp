@@ -0,0 +1,49 @@
+#include "QuadBatch.h"
+
+namespace CustomGem
+{
+    namespace
+    {
+        //! Width and height of quad i
+        inline void GetQuadSize(const QuadBatch& batch, size_t i, float& width, float& height)
+        {
+            width = batch.sizes.empty() ? 1.0f : batch.sizes[i * 2 + 0];
+            height = batch.sizes.empty() ? 1.0f : batch.sizes[i * 2 + 1];
+        }
+    } // namespace
+
+    void QuadBatchEmitter::Emit(MeshData& mesh, const QuadBatch& batch)
+    {
+        const size_t count = batch.GetCount();
+        if (count == 0)
+        {
+            return;
+        }
+        AZ_Assert(batch.corners.size() >= count * 3 && batch.tiles.size() >= count &&
+            (batch.sizes.empty() || batch.sizes.size() >= count * 2),
+            "QuadBatchEmitter: batch arrays are shorter than its face array");
+
+        QuadWriter out = MeshUtils::BeginQuads(mesh, count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const float* c = batch.corners.data() + i * 3;
+            const AZ::Vector3 corner(c[0], c[1], c[2]);
+            float width, height;
+            GetQuadSize(batch, i, width, height);
+
+            switch (batch.faces[i])
+            {
+            case Face::PosZ: MeshUtils::WriteQuad<Face::PosZ>(out, corner, batch.tiles[i], width, height); break;
+            case Face::NegZ: MeshUtils::WriteQuad<Face::NegZ>(out, corner, batch.tiles[i], width, height); break;
+            case Face::NegX: MeshUtils::WriteQuad<Face::NegX>(out, corner, batch.tiles[i], width, height); break;
+            case Face::PosX: MeshUtils::WriteQuad<Face::PosX>(out, corner, batch.tiles[i], width, height); break;
+            case Face::PosY: MeshUtils::WriteQuad<Face::PosY>(out, corner, batch.tiles[i], width, height); break;
+            case Face::NegY: MeshUtils::WriteQuad<Face::NegY>(out, corner, batch.tiles[i], width, height); break;
+            default:
+                AZ_Assert(false, "QuadBatchEmitter: face out of range [0..5]");
+                MeshUtils::WriteQuad<Face::PosZ>(out, corner, batch.tiles[i], width, height);
+                break;
+            }
+        }
+    }
+} // namespace CustomGem
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "MeshUtils.h"
+
+#include <AzCore/std/containers/span.h>
+
+namespace CustomGem
+{
+    //! Quads as parallel arrays, the input of QuadBatchEmitter. Element i of every array
+    //! describes quad i, with the meaning of the matching PushQuad parameters.
+    struct QuadBatch
+    {
+        AZStd::span<const float> corners;     // x, y, z
+        AZStd::span<const Face> faces;
+        AZStd::span<const UVIndex> tiles;
+        //! width, height; empty for unit quads
+        AZStd::span<const float> sizes;
+
+        size_t GetCount() const { return faces.size(); }
+    };
+
+    //! Writes quad batches into a mesh. The output is identical to pushing the same quads one by
+    //! one through PushQuad, but every stream grows once for the whole batch and each quad goes
+    //! through the PushQuad<Face> writer of its face.
+    struct QuadBatchEmitter
+    {
+        //! Append all quads of batch to mesh.
+        static void Emit(MeshData& mesh, const QuadBatch& batch);
+    };
+} // namespace CustomGem
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <AzCore/base.h>
+
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+//! Marks a function that uses AVX2 instructions above the build's baseline. MSVC accepts the
+//! intrinsics without it; GCC and Clang need the target enabled per function.
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE && (defined(__clang__) || defined(__GNUC__))
+#define CUSTOMGEM_TARGET_AVX2 __attribute__((target("avx2")))
+#define CUSTOMGEM_TARGET_F16C __attribute__((target("f16c")))
+#else
+#define CUSTOMGEM_TARGET_AVX2
+#define CUSTOMGEM_TARGET_F16C
+#endif
+
+namespace CustomGem
+{
+    //! Instruction sets batch kernels are written for. SSE2 is the x86-64 baseline and NEON the
+    //! arm64 one; AVX2 is only used when the CPU and the OS both support it.
+    enum class SimdLevel : uint8_t
+    {
+        Scalar,
+        Sse2,
+        Avx2,
+        Neon,
+    };
+
+    namespace Internal
+    {
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+        //! The OS saves the XMM and YMM halves across context switches, which every VEX encoded
+        //! instruction needs; leaf1 is CPUID leaf 1.
+        inline bool OsSavesYmm(const unsigned int (&leaf1)[4])
+        {
+            if ((leaf1[2] & (1u << 27)) == 0) // OSXSAVE
+            {
+                return false;
+            }
+#if defined(_MSC_VER)
+            const unsigned long long xcr0 = _xgetbv(0);
+#else
+            unsigned int eax = 0;
+            unsigned int edx = 0;
+            __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+            const unsigned long long xcr0 = (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+            return (xcr0 & 0x6) == 0x6;
+        }
+
+        inline void ReadCpuid(unsigned int leaf, unsigned int (&registers)[4])
+        {
+#if defined(_MSC_VER)
+            __cpuidex(reinterpret_cast<int*>(registers), static_cast<int>(leaf), 0);
+#else
+            __get_cpuid_count(leaf, 0, &registers[0], &registers[1], &registers[2], &registers[3]);
+#endif
+        }
+#endif
+
+        inline SimdLevel DetectSimdLevel()
+        {
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+            unsigned int leaf1[4] = {};
+            unsigned int leaf7[4] = {};
+            ReadCpuid(1, leaf1);
+            ReadCpuid(7, leaf7);
+            const bool avx = (leaf1[2] & (1u << 28)) != 0;
+            const bool avx2 = (leaf7[1] & (1u << 5)) != 0;
+            return avx && avx2 && OsSavesYmm(leaf1) ? SimdLevel::Avx2 : SimdLevel::Sse2;
+#elif AZ_TRAIT_USE_PLATFORM_SIMD_NEON
+            return SimdLevel::Neon;
+#else
+            return SimdLevel::Scalar;
+#endif
+        }
+
+        inline bool DetectF16c()
+        {
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+            unsigned int leaf1[4] = {};
+            ReadCpuid(1, leaf1);
+            return (leaf1[2] & (1u << 29)) != 0 && OsSavesYmm(leaf1);
+#else
+            return false;
+#endif
+        }
+    } // namespace Internal
+
+    //! Widest level this CPU runs, detected on first use
+    inline SimdLevel GetSimdLevel()
+    {
+        static const SimdLevel s_level = Internal::DetectSimdLevel();
+        return s_level;
+    }
+
+    //! Whether this CPU has the F16C half float conversions, detected on first use. Every AVX2 CPU
+    //! has them, but they are a separate feature bit.
+    inline bool HasF16c()
+    {
+        static const bool s_f16c = Internal::DetectF16c();
+        return s_f16c;
+    }
+
+    //! requested when this CPU runs it, otherwise the widest level it does run. Lets callers and
+    //! benchmarks force a narrower kernel, never a wider one.
+    inline SimdLevel ClampSimdLevel(SimdLevel requested)
+    {
+        const SimdLevel supported = GetSimdLevel();
+        const bool x86 = supported == SimdLevel::Sse2 || supported == SimdLevel::Avx2;
+        const bool runs = requested == SimdLevel::Scalar ||
+            (x86 && (requested == SimdLevel::Sse2 || requested == SimdLevel::Avx2) && requested <= supported) ||
+            (requested == SimdLevel::Neon && supported == SimdLevel::Neon);
+        return runs ? requested : supported;
+    }
+
+    inline const char* GetSimdLevelName(SimdLevel level)
+    {
+        switch (level)
+        {
+        case SimdLevel::Sse2: return "SSE2";
+        case SimdLevel::Avx2: return "AVX2";
+        case SimdLevel::Neon: return "NEON";
+        default: return "Scalar";
+        }
+    }
+} // namespace CustomGem
@@ -0,0 +1,306 @@
+#include "VertexCompression.h"
+
+#include <AzCore/base.h>
+#include <AzCore/Math/MathUtils.h>
+
+#include <cmath>
+#include <cstring>
+
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+#include <immintrin.h>
+#endif
+
+namespace CustomGem
+{
+    namespace
+    {
+        constexpr float Snorm16Scale = 32767.0f;
+        // Smallest non-zero snorm16 magnitude; keeps the handedness sign of a zero tangent component
+        constexpr float Snorm16Epsilon = 1.0f / 32767.0f;
+
+        inline float SignNotZero(float v)
+        {
+            return v < 0.0f ? -1.0f : 1.0f;
+        }
+
+        //! Rounds to nearest even under the default rounding mode, like _mm_cvtps_epi32, so the scalar
+        //! tail and the SIMD kernel produce the same bits
+        inline int16_t ToSnorm16(float v)
+        {
+            return static_cast<int16_t>(std::lrint(AZ::GetClamp(v, -1.0f, 1.0f) * Snorm16Scale));
+        }
+
+        //! Project a direction onto the octahedron and unfold the lower hemisphere into [-1, 1]^2
+        inline void OctEncode(float x, float y, float z, float& ox, float& oy)
+        {
+            const float l1 = AZStd::max(std::fabs(x) + std::fabs(y) + std::fabs(z), 1e-20f);
+            float px = x / l1;
+            float py = y / l1;
+            if (z < 0.0f)
+            {
+                const float fx = (1.0f - std::fabs(py)) * SignNotZero(px);
+                const float fy = (1.0f - std::fabs(px)) * SignNotZero(py);
+                px = fx;
+                py = fy;
+            }
+            ox = px;
+            oy = py;
+        }
+
+        inline void OctDecode(float px, float py, float& nx, float& ny, float& nz)
+        {
+            px = AZ::GetClamp(px, -1.0f, 1.0f);
+            py = AZ::GetClamp(py, -1.0f, 1.0f);
+            const float pz = 1.0f - std::fabs(px) - std::fabs(py);
+            if (pz < 0.0f)
+            {
+                const float fx = (1.0f - std::fabs(py)) * SignNotZero(px);
+                const float fy = (1.0f - std::fabs(px)) * SignNotZero(py);
+                px = fx;
+                py = fy;
+            }
+
+            const float length = std::sqrt(px * px + py * py + pz * pz);
+            const float invLength = length > 0.0f ? 1.0f / length : 0.0f;
+            nx = px * invLength;
+            ny = py * invLength;
+            nz = pz * invLength;
+        }
+
+        //! Move the second octahedral component to [eps, 1] and give it the sign of the handedness
+        inline float FoldHandedness(float oy, float w)
+        {
+            return AZStd::max(oy * 0.5f + 0.5f, Snorm16Epsilon) * SignNotZero(w);
+        }
+
+        inline uint16_t FloatToHalf(float value)
+        {
+            constexpr uint32_t f32Infinity = 255u << 23;
+            constexpr uint32_t f16Max = (127u + 16u) << 23;
+            constexpr uint32_t denormMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+            uint32_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            const uint32_t sign = bits & 0x80000000u;
+            bits ^= sign;
+
+            uint16_t result;
+            if (bits >= f16Max)
+            {
+                // Overflow maps to Inf, NaN stays NaN
+                result = (bits > f32Infinity) ? 0x7e00 : 0x7c00;
+            }
+            else if (bits < (113u << 23))
+            {
+                // Zero and half denormals; let the FPU do the rounding
+                float magic;
+                memcpy(&magic, &denormMagic, sizeof(magic));
+                float f;
+                memcpy(&f, &bits, sizeof(f));
+                f += magic;
+                memcpy(&bits, &f, sizeof(bits));
+                result = static_cast<uint16_t>(bits - denormMagic);
+            }
+            else
+            {
+                // Rebias the exponent and round the mantissa to nearest even
+                const uint32_t mantissaOdd = (bits >> 13) & 1u;
+                bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xfffu;
+                bits += mantissaOdd;
+                result = static_cast<uint16_t>(bits >> 13);
+            }
+            return result | static_cast<uint16_t>(sign >> 16);
+        }
+
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+        //! Encode four directions given as SoA registers. Writes 8 snorm16 values (x0 y0 .. x3 y3).
+        //! When w is given the second component gets the handedness fold used for tangents.
+        inline void OctEncode4(__m128 x, __m128 y, __m128 z, const __m128* w, int16_t* out)
+        {
+            const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+            const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u)));
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 zero = _mm_setzero_ps();
+
+            const __m128 l1 = _mm_max_ps(
+                _mm_add_ps(_mm_add_ps(_mm_and_ps(x, absMask), _mm_and_ps(y, absMask)), _mm_and_ps(z, absMask)),
+                _mm_set1_ps(1e-20f));
+            __m128 px = _mm_div_ps(x, l1);
+            __m128 py = _mm_div_ps(y, l1);
+
+            // Lower hemisphere fold, selected per lane
+            const __m128 signX = _mm_or_ps(_mm_and_ps(_mm_cmplt_ps(px, zero), signMask), one);
+            const __m128 signY = _mm_or_ps(_mm_and_ps(_mm_cmplt_ps(py, zero), signMask), one);
+            const __m128 foldX = _mm_mul_ps(_mm_sub_ps(one, _mm_and_ps(py, absMask)), signX);
+            const __m128 foldY = _mm_mul_ps(_mm_sub_ps(one, _mm_and_ps(px, absMask)), signY);
+            const __m128 lower = _mm_cmplt_ps(z, zero);
+            px = _mm_or_ps(_mm_and_ps(lower, foldX), _mm_andnot_ps(lower, px));
+            py = _mm_or_ps(_mm_and_ps(lower, foldY), _mm_andnot_ps(lower, py));
+
+            if (w)
+            {
+                const __m128 signW = _mm_or_ps(_mm_and_ps(_mm_cmplt_ps(*w, zero), signMask), one);
+                py = _mm_max_ps(_mm_add_ps(_mm_mul_ps(py, _mm_set1_ps(0.5f)), _mm_set1_ps(0.5f)), _mm_set1_ps(Snorm16Epsilon));
+                py = _mm_mul_ps(py, signW);
+            }
+
+            const __m128 scale = _mm_set1_ps(Snorm16Scale);
+            const __m128i ix = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(px, _mm_set1_ps(-1.0f)), one), scale));
+            const __m128i iy = _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(py, _mm_set1_ps(-1.0f)), one), scale));
+            const __m128i packed = _mm_unpacklo_epi16(_mm_packs_epi32(ix, ix), _mm_packs_epi32(iy, iy));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), packed);
+        }
+
+        //! Converts whole groups of four values with F16C; returns how many were converted.
+        //! Rounds to nearest even like FloatToHalf, which handles the rest.
+        CUSTOMGEM_TARGET_F16C size_t EncodeHalfFloatsF16c(const float* values, size_t count, uint16_t* out)
+        {
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128i halves = _mm_cvtps_ph(_mm_loadu_ps(values + i), _MM_FROUND_TO_NEAREST_INT);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), halves);
+            }
+            return i;
+        }
+#endif
+    } // namespace
+
+    void VertexCompression::EncodeOctahedralNormals(
+        AZStd::span<const float> normals, AZStd::span<int16_t> out, [[maybe_unused]] SimdLevel level)
+    {
+        const size_t count = normals.size() / 3;
+        AZ_Assert(out.size() >= count * 2, "EncodeOctahedralNormals: output holds %zu values, need %zu", out.size(), count * 2);
+
+        const float* n = normals.data();
+        int16_t* o = out.data();
+        size_t i = 0;
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+        const bool sse = ClampSimdLevel(level) != SimdLevel::Scalar;
+        for (; sse && i + 4 <= count; i += 4, n += 12, o += 8)
+        {
+            OctEncode4(
+                _mm_setr_ps(n[0], n[3], n[6], n[9]),
+                _mm_setr_ps(n[1], n[4], n[7], n[10]),
+                _mm_setr_ps(n[2], n[5], n[8], n[11]),
+                nullptr, o);
+        }
+#endif
+        for (; i < count; ++i, n += 3, o += 2)
+        {
+            float ox, oy;
+            OctEncode(n[0], n[1], n[2], ox, oy);
+            o[0] = ToSnorm16(ox);
+            o[1] = ToSnorm16(oy);
+        }
+    }
+
+    void VertexCompression::EncodeOctahedralTangents(
+        AZStd::span<const float> tangents, AZStd::span<int16_t> out, [[maybe_unused]] SimdLevel level)
+    {
+        const size_t count = tangents.size() / 4;
+        AZ_Assert(out.size() >= count * 2, "EncodeOctahedralTangents: output holds %zu values, need %zu", out.size(), count * 2);
+
+        const float* t = tangents.data();
+        int16_t* o = out.data();
+        size_t i = 0;
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+        const bool sse = ClampSimdLevel(level) != SimdLevel::Scalar;
+        for (; sse && i + 4 <= count; i += 4, t += 16, o += 8)
+        {
+            // Four float4 tangents transpose straight into SoA registers
+            __m128 t0 = _mm_loadu_ps(t + 0);
+            __m128 t1 = _mm_loadu_ps(t + 4);
+            __m128 t2 = _mm_loadu_ps(t + 8);
+            __m128 t3 = _mm_loadu_ps(t + 12);
+            _MM_TRANSPOSE4_PS(t0, t1, t2, t3);
+            OctEncode4(t0, t1, t2, &t3, o);
+        }
+#endif
+        for (; i < count; ++i, t += 4, o += 2)
+        {
+            float ox, oy;
+            OctEncode(t[0], t[1], t[2], ox, oy);
+            o[0] = ToSnorm16(ox);
+            o[1] = ToSnorm16(FoldHandedness(oy, t[3]));
+        }
+    }
+
+    void VertexCompression::EncodeHalfFloats(
+        AZStd::span<const float> values, AZStd::span<uint16_t> out, [[maybe_unused]] SimdLevel level)
+    {
+        AZ_Assert(out.size() >= values.size(), "EncodeHalfFloats: output holds %zu values, need %zu", out.size(), values.size());
+
+        size_t i = 0;
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+        if (ClampSimdLevel(level) != SimdLevel::Scalar && HasF16c())
+        {
+            i = EncodeHalfFloatsF16c(values.data(), values.size(), out.data());
+        }
+#endif
+        for (; i < values.size(); ++i)
+        {
+            out[i] = FloatToHalf(values[i]);
+        }
+    }
+
+    void VertexCompression::Quantize(
+        AZStd::span<const float> normals,
+        AZStd::span<const float> tangents,
+        AZStd::span<const float> uvs,
+        QuantizedVertexData& out)
+    {
+        out.normals.resize_no_construct((normals.size() / 3) * 2);
+        out.tangents.resize_no_construct((tangents.size() / 4) * 2);
+        out.uvs.resize_no_construct(uvs.size());
+
+        EncodeOctahedralNormals(normals, out.normals);
+        EncodeOctahedralTangents(tangents, out.tangents);
+        EncodeHalfFloats(uvs, out.uvs);
+    }
+
+    void VertexCompression::DecodeOctahedral(int16_t x, int16_t y, float& nx, float& ny, float& nz)
+    {
+        OctDecode(x / Snorm16Scale, y / Snorm16Scale, nx, ny, nz);
+    }
+
+    void VertexCompression::DecodeOctahedralTangent(int16_t x, int16_t y, float& tx, float& ty, float& tz, float& tw)
+    {
+        const float folded = y / Snorm16Scale;
+        tw = SignNotZero(folded);
+        OctDecode(x / Snorm16Scale, std::fabs(folded) * 2.0f - 1.0f, tx, ty, tz);
+    }
+
+    float VertexCompression::DecodeHalfFloat(uint16_t value)
+    {
+        constexpr uint32_t shiftedExponent = 0x7c00u << 13;
+        constexpr uint32_t magicBits = 113u << 23;
+
+        uint32_t bits = (value & 0x7fffu) << 13;
+        const uint32_t exponent = shiftedExponent & bits;
+        bits += (127u - 15u) << 23;
+
+        float result;
+        if (exponent == shiftedExponent)
+        {
+            // Inf / NaN
+            bits += (128u - 16u) << 23;
+            memcpy(&result, &bits, sizeof(result));
+        }
+        else if (exponent == 0)
+        {
+            // Zero / denormal, renormalize through the FPU
+            bits += 1u << 23;
+            float magic;
+            memcpy(&magic, &magicBits, sizeof(magic));
+            memcpy(&result, &bits, sizeof(result));
+            result -= magic;
+        }
+        else
+        {
+            memcpy(&result, &bits, sizeof(result));
+        }
+
+        return (value & 0x8000u) ? -result : result;
+    }
+} // namespace CustomGem
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "SimdDispatch.h"
+
+#include <AzCore/std/containers/span.h>
+#include <AzCore/std/containers/vector.h>
+
+namespace CustomGem
+{
+    //! Quantized copies of the shading streams of a mesh.
+    //! Normals and tangents are octahedral encoded into two snorm16 components (R16G16_SNORM).
+    //! The tangent handedness (tangent.w) is folded into the sign of the tangent's second component,
+    //! which lets shaders rebuild the bitangent as cross(N, T) * w. UVs are half floats (R16G16_FLOAT).
+    struct QuantizedVertexData
+    {
+        AZStd::vector<int16_t> normals;    // ox, oy
+        AZStd::vector<int16_t> tangents;   // ox, oy * sign(w)
+        AZStd::vector<uint16_t> uvs;       // u, v as IEEE half
+    };
+
+    struct VertexCompression
+    {
+        //! Encode float3 normals into octahedral snorm16x2. out must hold 2 values per normal.
+        //! Every level gives the same bits; level only picks the kernel.
+        static void EncodeOctahedralNormals(
+            AZStd::span<const float> normals, AZStd::span<int16_t> out, SimdLevel level = GetSimdLevel());
+
+        //! Encode float4 tangents (xyz + handedness w) into octahedral snorm16x2. out must hold 2 values per tangent.
+        static void EncodeOctahedralTangents(
+            AZStd::span<const float> tangents, AZStd::span<int16_t> out, SimdLevel level = GetSimdLevel());
+
+        //! Convert floats to IEEE half floats with round-to-nearest-even. out must be as large as values.
+        //! Levels above Scalar use F16C when the CPU has it; NaN payloads may then differ from the
+        //! scalar conversion, every other value converts to the same bits.
+        static void EncodeHalfFloats(AZStd::span<const float> values, AZStd::span<uint16_t> out, SimdLevel level = GetSimdLevel());
+
+        //! Quantize all shading streams of a mesh. Empty input streams stay empty.
+        static void Quantize(
+            AZStd::span<const float> normals,
+            AZStd::span<const float> tangents,
+            AZStd::span<const float> uvs,
+            QuantizedVertexData& out);
+
+        //! Inverse of the encoders, used for validation and CPU side consumers.
+        static void DecodeOctahedral(int16_t x, int16_t y, float& nx, float& ny, float& nz);
+        static void DecodeOctahedralTangent(int16_t x, int16_t y, float& tx, float& ty, float& tz, float& tw);
+        static float DecodeHalfFloat(uint16_t value);
+    };
+} // namespace CustomGem
@@ -0,0 +1,101 @@
+#include "VoxelChunkStore.h"
+#include "MeshDataPool.h"
+
+#include <AtomLyIntegration/CommonFeatures/Mesh/MeshComponentBus.h>
+
+namespace CustomGem
+{
+    void VoxelChunkStore::Initialize(VoxelVolume&& volume, const ChunkedMeshSettings& settings)
+    {
+        Reset();
+
+        m_volume = AZStd::move(volume);
+        m_settings = settings;
+
+        ChunkedVoxelMesher::Build(m_volume, m_settings, m_chunks);
+        m_entities.resize(m_chunks.size());
+        m_dirtyChunks.Initialize(m_volume.size, m_settings.chunkSize);
+
+        // The models hold the geometry from here on; the storage serves the next remesh
+        for (VoxelChunk& chunk : m_chunks)
+        {
+            MeshDataPool::Get().Recycle(AZStd::move(chunk.mesh));
+        }
+    }
+
+    void VoxelChunkStore::Reset()
+    {
+        for (VoxelChunk& chunk : m_chunks)
+        {
+            ModelBuilder::ReleaseModel(chunk.model);
+        }
+        m_chunks.clear();
+        m_entities.clear();
+        m_dirtyChunks.Reset();
+    }
+
+    void VoxelChunkStore::SetVoxel(int x, int y, int z, uint16_t material)
+    {
+        if (!m_volume.Contains(x, y, z) || m_volume.Get(x, y, z) == material)
+        {
+            return;
+        }
+
+        m_volume.Set(x, y, z, material);
+        MarkRegionDirty({ x, y, z }, { x + 1, y + 1, z + 1 });
+    }
+
+    void VoxelChunkStore::SetChunkEntity(size_t chunkIndex, AZ::EntityId entityId)
+    {
+        m_entities[chunkIndex] = entityId;
+        ApplyModel(chunkIndex);
+    }
+
+    AZStd::vector<size_t> VoxelChunkStore::RemeshDirty()
+    {
+        AZStd::vector<size_t> rebuilt = m_dirtyChunks.TakeDirtyChunks();
+        if (rebuilt.empty())
+        {
+            return rebuilt;
+        }
+
+        // Keep the previous models alive until the entities have switched over
+        AZStd::vector<AZ::Data::Asset<AZ::RPI::ModelAsset>> previousModels;
+        previousModels.reserve(rebuilt.size());
+
+        AZStd::vector<VoxelChunk*> chunks;
+        chunks.reserve(rebuilt.size());
+        for (size_t chunkIndex : rebuilt)
+        {
+            previousModels.push_back(m_chunks[chunkIndex].model);
+            chunks.push_back(&m_chunks[chunkIndex]);
+        }
+
+        ChunkedVoxelMesher::BuildChunks(m_volume, m_settings, chunks);
+
+        for (size_t chunkIndex : rebuilt)
+        {
+            MeshDataPool::Get().Recycle(AZStd::move(m_chunks[chunkIndex].mesh));
+            ApplyModel(chunkIndex);
+        }
+
+        for (AZ::Data::Asset<AZ::RPI::ModelAsset>& model : previousModels)
+        {
+            ModelBuilder::ReleaseModel(model);
+        }
+        return rebuilt;
+    }
+
+    void VoxelChunkStore::ApplyModel(size_t chunkIndex)
+    {
+        const AZ::EntityId entityId = m_entities[chunkIndex];
+        if (!entityId.IsValid())
+        {
+            return;
+        }
+
+        // A chunk that became empty keeps its entity, it just renders nothing
+        AZ::Render::MeshComponentRequestBus::Event(
+            entityId, &AZ::Render::MeshComponentRequests::SetModelAsset, m_chunks[chunkIndex].model);
+    }
+} // namespace CustomGem
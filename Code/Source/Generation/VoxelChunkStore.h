@@ -0,0 +1,64 @@
+#pragma once
+
+#include "ChunkedVoxelMesher.h"
+#include "VoxelDirtyChunks.h"
+
+#include <AzCore/Component/EntityId.h>
+#include <AzCore/std/containers/vector.h>
+
+namespace CustomGem
+{
+    //! Persistent chunked voxel world for live editing.
+    //! Edits only mark the chunks whose surface can change; RemeshDirty() rebuilds those chunks and
+    //! swaps the model asset on the mesh component of the entity bound to each chunk, so entities
+    //! are created once and kept across edits.
+    //! Built into the Editor object library only, since it drives the Atom mesh components.
+    class VoxelChunkStore
+    {
+    public:
+        //! Take ownership of the volume and mesh every chunk.
+        void Initialize(VoxelVolume&& volume, const ChunkedMeshSettings& settings);
+
+        //! Release all chunk models and entity bindings.
+        void Reset();
+
+        const VoxelVolume& GetVolume() const { return m_volume; }
+        const ChunkedMeshSettings& GetSettings() const { return m_settings; }
+        size_t GetChunkCount() const { return m_chunks.size(); }
+        const VoxelChunk& GetChunk(size_t chunkIndex) const { return m_chunks[chunkIndex]; }
+
+        //! Chunk index holding the voxel, or InvalidChunk when outside the volume
+        size_t GetChunkIndex(int x, int y, int z) const { return m_dirtyChunks.GetChunkIndex(x, y, z); }
+        static constexpr size_t InvalidChunk = VoxelDirtyChunks::InvalidChunk;
+
+        //! Change one voxel. Marks its chunk dirty, plus the neighbouring chunks when the voxel
+        //! lies on a chunk border since their culled faces depend on it.
+        void SetVoxel(int x, int y, int z, uint16_t material);
+
+        //! Mark every chunk touching [regionMin, regionMax) and the voxels around it dirty.
+        void MarkRegionDirty(const VoxelCoord& regionMin, const VoxelCoord& regionMax)
+        {
+            m_dirtyChunks.MarkRegionDirty(regionMin, regionMax);
+        }
+
+        bool HasDirtyChunks() const { return m_dirtyChunks.HasDirtyChunks(); }
+
+        //! Bind an entity with a mesh component to a chunk. The entity receives the chunk's current
+        //! model immediately and every model rebuilt by RemeshDirty() afterwards.
+        void SetChunkEntity(size_t chunkIndex, AZ::EntityId entityId);
+        AZ::EntityId GetChunkEntity(size_t chunkIndex) const { return m_entities[chunkIndex]; }
+
+        //! Rebuild all dirty chunks in parallel and push the new models to the bound entities.
+        //! Returns the indices of the rebuilt chunks.
+        AZStd::vector<size_t> RemeshDirty();
+
+    private:
+        void ApplyModel(size_t chunkIndex);
+
+        VoxelVolume m_volume;
+        ChunkedMeshSettings m_settings;
+        AZStd::vector<VoxelChunk> m_chunks;
+        AZStd::vector<AZ::EntityId> m_entities;
+        VoxelDirtyChunks m_dirtyChunks;
+    };
+} // namespace CustomGem
@@ -0,0 +1,90 @@
+#include "VoxelDirtyChunks.h"
+
+#include <AzCore/std/algorithm.h>
+
+namespace CustomGem
+{
+    void VoxelDirtyChunks::Initialize(const VoxelCoord& volumeSize, int chunkSize)
+    {
+        Reset();
+
+        AZ_Assert(chunkSize > 0, "VoxelDirtyChunks: chunk size must be positive");
+        m_volumeSize = volumeSize;
+        m_chunkSize = chunkSize;
+        // Same grid as ChunkedVoxelMesher::GetChunkCount()
+        m_chunkCount = {
+            (volumeSize.x + chunkSize - 1) / chunkSize,
+            (volumeSize.y + chunkSize - 1) / chunkSize,
+            (volumeSize.z + chunkSize - 1) / chunkSize };
+        m_dirtyFlags.resize(static_cast<size_t>(m_chunkCount.x) * m_chunkCount.y * m_chunkCount.z, false);
+    }
+
+    void VoxelDirtyChunks::Reset()
+    {
+        m_volumeSize = {};
+        m_chunkCount = {};
+        m_dirtyFlags.clear();
+        m_dirtyChunks.clear();
+    }
+
+    size_t VoxelDirtyChunks::GetChunkIndex(int x, int y, int z) const
+    {
+        if (x < 0 || y < 0 || z < 0 || x >= m_volumeSize.x || y >= m_volumeSize.y || z >= m_volumeSize.z)
+        {
+            return InvalidChunk;
+        }
+
+        const int size = m_chunkSize;
+        return (static_cast<size_t>(z / size) * m_chunkCount.y + y / size) * m_chunkCount.x + x / size;
+    }
+
+    void VoxelDirtyChunks::MarkRegionDirty(const VoxelCoord& regionMin, const VoxelCoord& regionMax)
+    {
+        if (m_dirtyFlags.empty())
+        {
+            return;
+        }
+
+        // Faces of the voxels one step outside the region are culled against the region's voxels
+        const int size = m_chunkSize;
+        const VoxelCoord first = {
+            AZStd::max(regionMin.x - 1, 0) / size,
+            AZStd::max(regionMin.y - 1, 0) / size,
+            AZStd::max(regionMin.z - 1, 0) / size };
+        const VoxelCoord last = {
+            AZStd::min(regionMax.x, m_volumeSize.x - 1) / size,
+            AZStd::min(regionMax.y, m_volumeSize.y - 1) / size,
+            AZStd::min(regionMax.z, m_volumeSize.z - 1) / size };
+
+        for (int z = first.z; z <= last.z; ++z)
+        {
+            for (int y = first.y; y <= last.y; ++y)
+            {
+                for (int x = first.x; x <= last.x; ++x)
+                {
+                    MarkChunkDirty((static_cast<size_t>(z) * m_chunkCount.y + y) * m_chunkCount.x + x);
+                }
+            }
+        }
+    }
+
+    void VoxelDirtyChunks::MarkChunkDirty(size_t chunkIndex)
+    {
+        if (!m_dirtyFlags[chunkIndex])
+        {
+            m_dirtyFlags[chunkIndex] = true;
+            m_dirtyChunks.push_back(chunkIndex);
+        }
+    }
+
+    AZStd::vector<size_t> VoxelDirtyChunks::TakeDirtyChunks()
+    {
+        AZStd::vector<size_t> dirty;
+        dirty.swap(m_dirtyChunks);
+        for (size_t chunkIndex : dirty)
+        {
+            m_dirtyFlags[chunkIndex] = false;
+        }
+        return dirty;
+    }
+} // namespace CustomGem
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "VoxelMesher.h"
+
+#include <AzCore/std/containers/vector.h>
+
+namespace CustomGem
+{
+    //! Chunks of a chunked voxel volume whose mesh is out of date after voxel edits. Only knows the
+    //! chunk grid, chunks numbered x fastest as in ChunkedVoxelMesher::Build(), so VoxelChunkStore
+    //! keeps its models and entities separately.
+    class VoxelDirtyChunks
+    {
+    public:
+        //! Sizes the grid for a volume of volumeSize voxels; every chunk starts clean.
+        void Initialize(const VoxelCoord& volumeSize, int chunkSize);
+
+        void Reset();
+
+        const VoxelCoord& GetChunkCount() const { return m_chunkCount; }
+
+        //! Chunk index holding the voxel, or InvalidChunk when outside the volume
+        size_t GetChunkIndex(int x, int y, int z) const;
+        static constexpr size_t InvalidChunk = static_cast<size_t>(-1);
+
+        //! Mark every chunk touching [regionMin, regionMax) and the voxels around it dirty. A voxel on
+        //! a chunk border also dirties the neighbouring chunk, whose culled faces depend on it.
+        void MarkRegionDirty(const VoxelCoord& regionMin, const VoxelCoord& regionMax);
+
+        void MarkChunkDirty(size_t chunkIndex);
+
+        bool HasDirtyChunks() const { return !m_dirtyChunks.empty(); }
+        bool IsDirty(size_t chunkIndex) const { return m_dirtyFlags[chunkIndex]; }
+
+        //! The dirty chunks in the order they were marked; they are clean afterwards.
+        AZStd::vector<size_t> TakeDirtyChunks();
+
+    private:
+        VoxelCoord m_volumeSize;
+        int m_chunkSize = 1;
+        VoxelCoord m_chunkCount;
+        AZStd::vector<bool> m_dirtyFlags;
+        AZStd::vector<size_t> m_dirtyChunks;
+    };
+} // namespace CustomGem
@@ -0,0 +1,147 @@
+#include "VoxelMesher.h"
+#include "QuadBatch.h"
+
+namespace CustomGem
+{
+    namespace
+    {
+        inline int Component(const VoxelCoord& coord, int axis)
+        {
+            return axis == 0 ? coord.x : (axis == 1 ? coord.y : coord.z);
+        }
+    } // namespace
+
+    VoxelMeshStats VoxelMesher::BuildMesh(const VoxelVolume& volume, MeshData& mesh, const VoxelMeshSettings& settings)
+    {
+        return BuildRegion(volume, { 0, 0, 0 }, volume.size, mesh, settings);
+    }
+
+    VoxelMeshStats VoxelMesher::BuildRegion(
+        const VoxelVolume& volume,
+        const VoxelCoord& regionMin,
+        const VoxelCoord& regionMax,
+        MeshData& mesh,
+        const VoxelMeshSettings& settings)
+    {
+        VoxelMeshStats stats;
+
+        const VoxelCoord lo = { AZStd::max(regionMin.x, 0), AZStd::max(regionMin.y, 0), AZStd::max(regionMin.z, 0) };
+        const VoxelCoord hi = {
+            AZStd::min(regionMax.x, volume.size.x),
+            AZStd::min(regionMax.y, volume.size.y),
+            AZStd::min(regionMax.z, volume.size.z) };
+        if (lo.x >= hi.x || lo.y >= hi.y || lo.z >= hi.z)
+        {
+            return stats;
+        }
+
+        // Exposed face materials of one slice, tangent fastest
+        AZStd::vector<uint16_t> mask;
+        // Merged quads of the whole region as QuadBatch arrays, written to the mesh in one go at the end
+        AZStd::vector<float> corners;
+        AZStd::vector<Face> faces;
+        AZStd::vector<UVIndex> tiles;
+        AZStd::vector<float> sizes;
+
+        for (int orientation = 0; orientation < 6; ++orientation)
+        {
+            const FaceBasis& axes = FaceBases[orientation];
+            const int tangentMin = Component(lo, axes.tangentAxis);
+            const int bitangentMin = Component(lo, axes.bitangentAxis);
+            const int width = Component(hi, axes.tangentAxis) - tangentMin;
+            const int height = Component(hi, axes.bitangentAxis) - bitangentMin;
+            mask.resize(static_cast<size_t>(width) * height);
+
+            for (int slice = Component(lo, axes.normalAxis); slice < Component(hi, axes.normalAxis); ++slice)
+            {
+                // 1) Cull: a face is visible when the voxel is solid and its neighbour along the normal is empty
+                for (int b = 0; b < height; ++b)
+                {
+                    for (int t = 0; t < width; ++t)
+                    {
+                        int p[3];
+                        p[axes.normalAxis] = slice;
+                        p[axes.tangentAxis] = tangentMin + t;
+                        p[axes.bitangentAxis] = bitangentMin + b;
+
+                        uint16_t face = VoxelVolume::Empty;
+                        if (const uint16_t material = volume.Get(p[0], p[1], p[2]); material != VoxelVolume::Empty)
+                        {
+                            p[axes.normalAxis] += axes.direction;
+                            if (volume.Get(p[0], p[1], p[2]) == VoxelVolume::Empty)
+                            {
+                                face = material;
+                                ++stats.exposedFaces;
+                            }
+                        }
+                        mask[static_cast<size_t>(b) * width + t] = face;
+                    }
+                }
+
+                // 2) Merge: grow each face along the tangent, then along the bitangent while whole rows match
+                const float plane = static_cast<float>(slice + (axes.direction > 0 ? 1 : 0));
+                for (int b = 0; b < height; ++b)
+                {
+                    uint16_t* row = mask.data() + static_cast<size_t>(b) * width;
+                    for (int t = 0; t < width;)
+                    {
+                        const uint16_t material = row[t];
+                        if (material == VoxelVolume::Empty)
+                        {
+                            ++t;
+                            continue;
+                        }
+
+                        const UVIndex tile = volume.GetTile(material, orientation);
+                        int quadWidth = 1;
+                        int quadHeight = 1;
+                        if (settings.greedy && (settings.mergeAtlasTiles || tile.segment <= 1))
+                        {
+                            while (t + quadWidth < width && row[t + quadWidth] == material)
+                            {
+                                ++quadWidth;
+                            }
+
+                            for (; b + quadHeight < height; ++quadHeight)
+                            {
+                                const uint16_t* next = row + static_cast<size_t>(quadHeight) * width + t;
+                                if (!AZStd::all_of(next, next + quadWidth, [material](uint16_t m) { return m == material; }))
+                                {
+                                    break;
+                                }
+                            }
+                        }
+
+                        for (int h = 0; h < quadHeight; ++h)
+                        {
+                            uint16_t* covered = row + static_cast<size_t>(h) * width + t;
+                            AZStd::fill(covered, covered + quadWidth, VoxelVolume::Empty);
+                        }
+
+                        float corner[3];
+                        corner[axes.normalAxis] = plane;
+                        corner[axes.tangentAxis] = static_cast<float>(tangentMin + t);
+                        corner[axes.bitangentAxis] = static_cast<float>(bitangentMin + b);
+
+                        corners.insert(corners.end(), corner, corner + 3);
+                        faces.push_back(static_cast<Face>(orientation));
+                        tiles.push_back(tile);
+                        sizes.push_back(static_cast<float>(quadWidth));
+                        sizes.push_back(static_cast<float>(quadHeight));
+
+                        t += quadWidth;
+                    }
+                }
+            }
+        }
+
+        QuadBatch batch;
+        batch.corners = corners;
+        batch.faces = faces;
+        batch.tiles = tiles;
+        batch.sizes = sizes;
+        QuadBatchEmitter::Emit(mesh, batch);
+        stats.quads = faces.size();
+        return stats;
+    }
+} // namespace CustomGem
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "MeshUtils.h"
+
+#include <AzCore/std/containers/vector.h>
+
+namespace CustomGem
+{
+    //! Integer voxel coordinate
+    struct VoxelCoord
+    {
+        int x = 0;
+        int y = 0;
+        int z = 0;
+    };
+
+    //! UV tile used by each face of a material, indexed by PushQuad orientation
+    struct VoxelMaterial
+    {
+        UVIndex faces[6] = { {1, 0}, {1, 0}, {1, 0}, {1, 0}, {1, 0}, {1, 0} };
+
+        static VoxelMaterial FromTile(UVIndex tile)
+        {
+            VoxelMaterial material;
+            for (UVIndex& face : material.faces)
+            {
+                face = tile;
+            }
+            return material;
+        }
+    };
+
+    //! Dense voxel grid holding one material id per voxel. Material 0 is empty space.
+    //! Voxel (x, y, z) occupies the unit cube [x, x+1] x [y, y+1] x [z, z+1].
+    struct VoxelVolume
+    {
+        static constexpr uint16_t Empty = 0;
+
+        VoxelCoord size;
+        AZStd::vector<uint16_t> voxels;        // x fastest, then y, then z
+        AZStd::vector<VoxelMaterial> palette;  // indexed by material id, entry 0 is unused
+
+        void Resize(int sizeX, int sizeY, int sizeZ)
+        {
+            size = { sizeX, sizeY, sizeZ };
+            voxels.assign(static_cast<size_t>(sizeX) * sizeY * sizeZ, Empty);
+        }
+
+        bool Contains(int x, int y, int z) const
+        {
+            return x >= 0 && y >= 0 && z >= 0 && x < size.x && y < size.y && z < size.z;
+        }
+
+        size_t IndexOf(int x, int y, int z) const
+        {
+            return (static_cast<size_t>(z) * size.y + y) * size.x + x;
+        }
+
+        //! Voxels outside the volume read as empty
+        uint16_t Get(int x, int y, int z) const
+        {
+            return Contains(x, y, z) ? voxels[IndexOf(x, y, z)] : Empty;
+        }
+
+        void Set(int x, int y, int z, uint16_t material)
+        {
+            AZ_Assert(Contains(x, y, z), "VoxelVolume::Set: (%d, %d, %d) is outside the volume", x, y, z);
+            voxels[IndexOf(x, y, z)] = material;
+        }
+
+        //! Tile for one face of a material; unknown materials use the full 0..1 range
+        UVIndex GetTile(uint16_t material, int orientation) const
+        {
+            return material < palette.size() ? palette[material].faces[orientation] : UVIndex{ 1, 0 };
+        }
+    };
+
+    struct VoxelMeshSettings
+    {
+        //! Merge coplanar faces of the same material into maximal rectangles.
+        //! When disabled every exposed voxel face becomes its own quad.
+        bool greedy = true;
+        //! Also merge faces whose tile is part of an atlas (segment > 1). A merged quad's uvs then run
+        //! past its tile, so this needs a material that wraps them inside the tile (frac(uv * segment));
+        //! with stock materials the quad samples the neighbouring tiles. Faces using the whole texture
+        //! are always merged and repeat through the sampler's wrap mode.
+        bool mergeAtlasTiles = false;
+    };
+
+    struct VoxelMeshStats
+    {
+        uint64_t exposedFaces = 0;  // voxel faces that survived culling
+        uint64_t quads = 0;         // quads written to the mesh
+    };
+
+    struct VoxelMesher
+    {
+        //! Append the surface of the whole volume to mesh.
+        static VoxelMeshStats BuildMesh(const VoxelVolume& volume, MeshData& mesh, const VoxelMeshSettings& settings = {});
+
+        //! Append the surface of the voxels in [regionMin, regionMax) to mesh.
+        //! Voxels outside the region are still read to cull hidden faces, so neighbouring regions
+        //! can be meshed independently and still line up.
+        static VoxelMeshStats BuildRegion(
+            const VoxelVolume& volume,
+            const VoxelCoord& regionMin,
+            const VoxelCoord& regionMax,
+            MeshData& mesh,
+            const VoxelMeshSettings& settings = {});
+    };
+} // namespace CustomGem
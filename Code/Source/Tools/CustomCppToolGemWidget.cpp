@@ -9,6 +9,11 @@
 #include <QMimeData>
 #include <QDragEnterEvent>
 #include <QDropEvent>
+#include <QCoreApplication>
+#include <QPointer>
+#include <QProgressBar>
+#include <QSpinBox>
+#include <QTimer>
 
 // Util
 #include <AzCore/Asset/AssetManager.h>
@@ -16,6 +21,8 @@
 #include <AzCore/Component/EntityId.h>
 #include <AzCore/Component/TransformBus.h>
 #include <AzCore/Math/Vector3.h>
+#include <AzCore/Math/MathUtils.h>
+#include <AzCore/Jobs/JobFunction.h>
 
 #include <AzToolsFramework/API/EditorEntityAPI.h>
 #include <AzToolsFramework/API/EditorAssetSystemAPI.h>
@@ -42,9 +49,12 @@
 #include <AzCore/Debug/Trace.h>
 #include <AzCore/IO/FileIO.h>
 
+#include <cmath>
+
 // Header
 #include "CustomCppToolGemWidget.h"
-#include "ModelBuilder.h"
+#include <Generation/ModelBuilder.h>
+#include <Generation/VoxelMesher.h>
 
 namespace CustomCppToolGem
 {
@@ -57,12 +67,25 @@ namespace CustomCppToolGem
 
         auto* main = new QVBoxLayout(this);
 
-        auto* intro = new QLabel(tr("Click the button to spawn a cube at world origin."), this);
+        auto* intro = new QLabel(tr("Click the button to spawn a cube at world origin, or a voxel terrain when size is above 1."), this);
         main->addWidget(intro);
 
         auto* row = new QHBoxLayout();
+        m_sizeSpin = new QSpinBox(this);
+        m_sizeSpin->setRange(1, 1024);
+        m_sizeSpin->setValue(1);
+        m_sizeSpin->setPrefix(tr("Size: "));
+        row->addWidget(m_sizeSpin);
+
+        m_instanceSpin = new QSpinBox(this);
+        m_instanceSpin->setRange(1, 100000);
+        m_instanceSpin->setValue(1);
+        m_instanceSpin->setPrefix(tr("Instances: "));
+        row->addWidget(m_instanceSpin);
+
         auto* btnGenerate = new QPushButton(tr("Generate"), this);
         btnGenerate->setObjectName("Generate Button");
+        m_generateButton = btnGenerate;
         row->addStretch(1);
         row->addWidget(btnGenerate);
         row->addStretch(1);
@@ -74,10 +97,35 @@ namespace CustomCppToolGem
 
         main->addLayout(row);
 
+        auto* progressRow = new QHBoxLayout();
+        m_progressBar = new QProgressBar(this);
+        m_progressBar->setRange(0, GenerationTask::ProgressRange);
+        m_progressBar->setTextVisible(false);
+        m_cancelButton = new QPushButton(tr("Cancel"), this);
+        progressRow->addWidget(m_progressBar, 1);
+        progressRow->addWidget(m_cancelButton);
+        main->addLayout(progressRow);
+
+        m_progressTimer = new QTimer(this);
+        m_progressTimer->setInterval(50);
+
         connect(btnGenerate, &QPushButton::clicked, this, &CustomCppToolGemWidget::OnGenerateClicked);
+        connect(m_cancelButton, &QPushButton::clicked, this, &CustomCppToolGemWidget::OnCancelClicked);
+        connect(m_progressTimer, &QTimer::timeout, this, &CustomCppToolGemWidget::OnProgressTimer);
         connect(m_pathEdit, &QLineEdit::returnPressed, this, &CustomCppToolGemWidget::OnPathEntered);
 
         setLayout(main);
+        SetGenerating(false);
+    }
+
+    CustomCppToolGemWidget::~CustomCppToolGemWidget()
+    {
+        // A running job notices this and stops early; its result is released once it arrives
+        if (m_task)
+        {
+            m_task->cancelled = true;
+        }
+        m_spawner.Cancel();
     }
 
     bool HasAssetBrowserEntries(const QMimeData* mime)
@@ -181,8 +229,208 @@ namespace CustomCppToolGem
 
     void CustomCppToolGemWidget::OnGenerateClicked()
     {
-        AZ_Printf("CustomGem", "Information");
-        GenerateCubeEntityAtOrigin();
+        if (m_task || m_spawner.IsRunning())
+        {
+            return;
+        }
+        StartGeneration(m_sizeSpin->value());
+    }
+
+    void CustomCppToolGemWidget::OnCancelClicked()
+    {
+        if (m_task)
+        {
+            // The job's result is released when it comes back for a task that is no longer current
+            m_task->cancelled = true;
+            m_task.reset();
+            SetGenerating(false);
+        }
+        else if (m_spawner.IsRunning())
+        {
+            // Entities spawned so far stay in the level and are removed by one undo
+            m_spawner.Cancel();
+        }
+    }
+
+    void CustomCppToolGemWidget::OnProgressTimer()
+    {
+        if (m_task)
+        {
+            m_progressBar->setValue(m_task->progress);
+        }
+        else if (m_spawner.IsRunning())
+        {
+            m_progressBar->setValue(static_cast<int>(
+                GenerationTask::ProgressRange * m_spawner.GetSpawnedCount() / m_spawner.GetTotalCount()));
+        }
+    }
+
+    void CustomCppToolGemWidget::SetGenerating(bool generating)
+    {
+        m_generateButton->setEnabled(!generating);
+        m_sizeSpin->setEnabled(!generating);
+        m_instanceSpin->setEnabled(!generating);
+        m_cancelButton->setEnabled(generating);
+        m_progressBar->setValue(0);
+        m_progressBar->setVisible(generating);
+        m_cancelButton->setVisible(generating);
+        if (generating)
+        {
+            m_progressTimer->start();
+        }
+        else
+        {
+            m_progressTimer->stop();
+        }
+    }
+
+    namespace
+    {
+        //! Rolling voxel heightfield of size x size columns. Meshed in slabs so the job can report
+        //! progress and stop between them.
+        AZ::Data::Asset<AZ::RPI::ModelAsset> GenerateTerrainModel(int size, GenerationTask& task)
+        {
+            using namespace CustomGem;
+
+            const int height = AZStd::max(size / 4, 1);
+            VoxelVolume volume;
+            volume.Resize(size, height, size);
+            volume.palette = { VoxelMaterial{}, VoxelMaterial::FromTile({ 3, 1 }), VoxelMaterial::FromTile({ 3, 0 }) };
+            for (int z = 0; z < size; ++z)
+            {
+                if (task.IsCancelled())
+                {
+                    return {};
+                }
+
+                for (int x = 0; x < size; ++x)
+                {
+                    const float wave = std::sin(x * 0.11f) * std::cos(z * 0.07f);
+                    const int columnHeight = AZ::GetClamp(static_cast<int>(height * (0.5f + 0.25f * wave)), 1, height);
+                    for (int y = 0; y < columnHeight; ++y)
+                    {
+                        volume.Set(x, y, z, y + 1 == columnHeight ? 2 : 1);
+                    }
+                }
+                task.SetProgress(0.3f * (z + 1) / size);
+            }
+
+            constexpr int SlabDepth = 16;
+            MeshData mesh;
+            mesh.use16BitIndices = true;
+            for (int z = 0; z < size; z += SlabDepth)
+            {
+                if (task.IsCancelled())
+                {
+                    return {};
+                }
+
+                VoxelMesher::BuildRegion(volume, { 0, 0, z }, { size, height, AZStd::min(z + SlabDepth, size) }, mesh);
+                task.SetProgress(0.3f + 0.6f * AZStd::min(z + SlabDepth, size) / size);
+            }
+
+            if (task.IsCancelled())
+            {
+                return {};
+            }
+
+            AZ::Data::Asset<AZ::RPI::ModelAsset> modelAsset =
+                ModelBuilder::CreateModel(AZ::Name(AZStd::string::format("VoxelTerrain_%d", size)), AZStd::move(mesh));
+            task.SetProgress(1.0f);
+            return modelAsset;
+        }
+    } // namespace
+
+    void CustomCppToolGemWidget::StartGeneration(int size)
+    {
+        AZStd::shared_ptr<GenerationTask> task = AZStd::make_shared<GenerationTask>();
+        m_task = task;
+        SetGenerating(true);
+
+        QPointer<CustomCppToolGemWidget> self(this);
+        AZ::Job* job = AZ::CreateJobFunction([task, self, size]()
+            {
+                AZ::Data::Asset<AZ::RPI::ModelAsset> modelAsset = size <= 1
+                    ? CustomGem::ModelBuilder::BuildOctCube()
+                    : GenerateTerrainModel(size, *task);
+
+                // Entities may only be created on the main thread. qApp lives there and outlives the
+                // widget, which may be gone by the time the queued call runs.
+                QMetaObject::invokeMethod(qApp, [self, task, modelAsset]() mutable
+                    {
+                        if (self)
+                        {
+                            self->OnGenerationFinished(task, modelAsset);
+                        }
+                        else
+                        {
+                            CustomGem::ModelBuilder::ReleaseModel(modelAsset);
+                        }
+                    }, Qt::QueuedConnection);
+            }, true);
+        job->Start();
+    }
+
+    void CustomCppToolGemWidget::OnGenerationFinished(
+        const AZStd::shared_ptr<GenerationTask>& task, AZ::Data::Asset<AZ::RPI::ModelAsset> modelAsset)
+    {
+        if (task != m_task || task->IsCancelled())
+        {
+            CustomGem::ModelBuilder::ReleaseModel(modelAsset);
+            return;
+        }
+
+        m_task.reset();
+        SetGenerating(false);
+
+        if (!modelAsset)
+        {
+            AZ_Warning("CustomCppToolGem", false, "Generation produced no model.");
+            return;
+        }
+
+        const int instanceCount = m_instanceSpin->value();
+        if (instanceCount > 1)
+        {
+            SpawnInstances(modelAsset, instanceCount);
+            return;
+        }
+        GenerateMeshEntity(modelAsset, m_matAssetID);
+    }
+
+    void CustomCppToolGemWidget::SpawnInstances(const AZ::Data::Asset<AZ::RPI::ModelAsset>& modelAsset, int count)
+    {
+        // Square grid centred on the origin, one model extent plus half of it apart
+        const AZ::Aabb bounds = modelAsset->GetAabb();
+        const AZ::Vector3 extents = bounds.IsValid() ? bounds.GetExtents() : AZ::Vector3::CreateOne();
+        const float spacing = 1.5f * AZStd::max(extents.GetMaxElement(), 0.01f);
+        const int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count))));
+        const float origin = -0.5f * spacing * (side - 1);
+
+        AZStd::vector<AZ::Transform> transforms;
+        transforms.reserve(count);
+        for (int i = 0; i < count; ++i)
+        {
+            const AZ::Vector3 position(origin + spacing * (i % side), origin + spacing * (i / side), 0.0f);
+            transforms.push_back(AZ::Transform::CreateTranslation(position));
+        }
+
+        InstanceSpawnSettings settings;
+        settings.materialAssetId = m_matAssetID;
+        settings.name = AZStd::string::format("%s_x%d", modelAsset->GetName().GetCStr(), count);
+
+        QPointer<CustomCppToolGemWidget> self(this);
+        const bool started = m_spawner.Start(modelAsset, AZStd::move(transforms), settings, [self](const InstanceSpawnStats&)
+            {
+                if (self)
+                {
+                    self->SetGenerating(false);
+                }
+            });
+        if (started)
+        {
+            SetGenerating(true);
+        }
     }
 
     void CustomCppToolGemWidget::GenerateMeshEntity(
@@ -230,12 +478,6 @@ namespace CustomCppToolGem
             &AzToolsFramework::ToolsApplicationRequests::SetSelectedEntities, selection);
     }
 
-    void CustomCppToolGemWidget::GenerateCubeEntityAtOrigin()
-    {
-        AZ::Data::Asset<AZ::RPI::ModelAsset> modelAsset = CustomGem::ModelBuilder::BuildOctCube();
-        GenerateMeshEntity(modelAsset, m_matAssetID);
-    }
-
 }
 
 #include <moc_CustomCppToolGemWidget.cpp>
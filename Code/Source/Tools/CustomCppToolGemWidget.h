@@ -3,10 +3,19 @@
 #if !defined(Q_MOC_RUN)
 #include <AzToolsFramework/API/ToolsApplicationAPI.h>
 #include <Atom/RPI.Reflect/Model/ModelAsset.h>
+#include <AzCore/std/parallel/atomic.h>
+#include <AzCore/std/smart_ptr/shared_ptr.h>
+
+#include "InstanceSpawner.h"
 
 #include <QWidget>
 #include <QLineEdit>
 
+class QProgressBar;
+class QPushButton;
+class QSpinBox;
+class QTimer;
+
 // Qt FS
 #include <QDir>
 #include <QFileInfoList>
@@ -14,12 +23,26 @@
 
 namespace CustomCppToolGem
 {
+    //! State shared between the widget and a generation job. The job only writes progress and
+    //! reads cancelled; the widget polls progress and may drop its reference at any time.
+    struct GenerationTask
+    {
+        AZStd::atomic_int progress{ 0 };  // 0 .. ProgressRange
+        AZStd::atomic_bool cancelled{ false };
+
+        static constexpr int ProgressRange = 1000;
+
+        void SetProgress(float fraction) { progress = static_cast<int>(fraction * ProgressRange); }
+        bool IsCancelled() const { return cancelled; }
+    };
+
     class CustomCppToolGemWidget
         : public QWidget
     {
         Q_OBJECT
     public:
         explicit CustomCppToolGemWidget(QWidget* parent = nullptr);
+        ~CustomCppToolGemWidget() override;
     
     protected:
         // Drag & Drop overrides
@@ -31,8 +54,24 @@ namespace CustomCppToolGem
         AZ::Data::AssetId m_matAssetID;
 
         QLineEdit* m_pathEdit = nullptr;
+        QSpinBox* m_sizeSpin = nullptr;
+        QSpinBox* m_instanceSpin = nullptr;
+        QPushButton* m_generateButton = nullptr;
+        QPushButton* m_cancelButton = nullptr;
+        QProgressBar* m_progressBar = nullptr;
+        QTimer* m_progressTimer = nullptr;
+
+        //! Generation currently running, nullptr when idle
+        AZStd::shared_ptr<GenerationTask> m_task;
+        //! Places the generated model on a grid when more than one instance is requested
+        InstanceSpawner m_spawner;
 
-        void GenerateCubeEntityAtOrigin();
+        //! Start generating on a job; the entity is created on this thread once the job finishes
+        void StartGeneration(int size);
+        void OnGenerationFinished(const AZStd::shared_ptr<GenerationTask>& task, AZ::Data::Asset<AZ::RPI::ModelAsset> modelAsset);
+        void SetGenerating(bool generating);
+        //! Spawn count entities sharing modelAsset on a grid around the origin
+        void SpawnInstances(const AZ::Data::Asset<AZ::RPI::ModelAsset>& modelAsset, int count);
         void GenerateMeshEntity(
             AZ::Data::Asset<AZ::RPI::ModelAsset>& modelAsset, 
             AZ::Data::AssetId& matAssetID
@@ -41,6 +80,8 @@ namespace CustomCppToolGem
 
     private Q_SLOTS:
         void OnGenerateClicked();
+        void OnCancelClicked();
+        void OnProgressTimer();
         void OnPathEntered();  
         
     };
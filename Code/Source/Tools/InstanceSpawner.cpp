@@ -0,0 +1,168 @@
+#include "InstanceSpawner.h"
+
+#include <AzCore/Component/TransformBus.h>
+#include <AzToolsFramework/API/EditorEntityAPI.h>
+#include <AzToolsFramework/API/ToolsApplicationAPI.h>
+#include <AzToolsFramework/Component/EditorComponentAPIBus.h>
+#include <AzToolsFramework/Entity/EditorEntityContextBus.h>
+
+#include <AtomLyIntegration/CommonFeatures/Material/MaterialComponentBus.h>
+#include <AtomLyIntegration/CommonFeatures/Material/MaterialComponentConstants.h>
+#include <AtomLyIntegration/CommonFeatures/Mesh/MeshComponentBus.h>
+#include <AtomLyIntegration/CommonFeatures/Mesh/MeshComponentConstants.h>
+
+namespace CustomCppToolGem
+{
+    InstanceSpawner::~InstanceSpawner()
+    {
+        Cancel();
+    }
+
+    bool InstanceSpawner::Start(
+        AZ::Data::Asset<AZ::RPI::ModelAsset> modelAsset,
+        AZStd::vector<AZ::Transform> transforms,
+        const InstanceSpawnSettings& settings,
+        FinishedCallback onFinished)
+    {
+        if (IsRunning() || transforms.empty() || !modelAsset)
+        {
+            return false;
+        }
+
+        m_modelAsset = AZStd::move(modelAsset);
+        m_transforms = AZStd::move(transforms);
+        m_settings = settings;
+        m_settings.batchSize = AZStd::max(m_settings.batchSize, 1u);
+        m_onFinished = AZStd::move(onFinished);
+        m_next = 0;
+        m_startTime = AZStd::chrono::steady_clock::now();
+
+        // Every tick resumes this batch, so the spawn stays one undo step
+        m_undoBatch = nullptr;
+        AzToolsFramework::ToolsApplicationRequests::Bus::BroadcastResult(
+            m_undoBatch, &AzToolsFramework::ToolsApplicationRequests::BeginUndoBatch, "Spawn Instances");
+
+        AzToolsFramework::EditorEntityContextRequestBus::BroadcastResult(
+            m_groupId, &AzToolsFramework::EditorEntityContextRequests::CreateNewEditorEntity, m_settings.name.c_str());
+        if (m_groupId.IsValid())
+        {
+            AzToolsFramework::ToolsApplicationRequests::Bus::Broadcast(
+                &AzToolsFramework::ToolsApplicationRequests::AddDirtyEntity, m_groupId);
+        }
+        AzToolsFramework::ToolsApplicationRequests::Bus::Broadcast(
+            &AzToolsFramework::ToolsApplicationRequests::EndUndoBatch);
+
+        AZ::SystemTickBus::Handler::BusConnect();
+        AzToolsFramework::EditorEntityContextNotificationBus::Handler::BusConnect();
+        return true;
+    }
+
+    void InstanceSpawner::Cancel()
+    {
+        if (IsRunning())
+        {
+            Finish(true);
+        }
+    }
+
+    void InstanceSpawner::OnPrepareForContextReset()
+    {
+        // The group and its instances go away with the level, there is nothing left to select
+        m_groupId.SetInvalid();
+        Cancel();
+    }
+
+    void InstanceSpawner::OnSystemTick()
+    {
+        // The batch never stays open across ticks; it is only extended while it is still the latest
+        AzToolsFramework::ToolsApplicationRequests::Bus::BroadcastResult(
+            m_undoBatch, &AzToolsFramework::ToolsApplicationRequests::ResumeUndoBatch, m_undoBatch, "Spawn Instances");
+
+        const size_t end = AZStd::min(m_next + m_settings.batchSize, m_transforms.size());
+        for (; m_next < end; ++m_next)
+        {
+            SpawnInstance(m_next);
+        }
+
+        AzToolsFramework::ToolsApplicationRequests::Bus::Broadcast(
+            &AzToolsFramework::ToolsApplicationRequests::EndUndoBatch);
+
+        if (m_next == m_transforms.size())
+        {
+            Finish(false);
+        }
+    }
+
+    AZ::EntityId InstanceSpawner::SpawnInstance(size_t index)
+    {
+        AZ::EntityId entityId;
+        AzToolsFramework::EditorEntityContextRequestBus::BroadcastResult(
+            entityId,
+            &AzToolsFramework::EditorEntityContextRequests::CreateNewEditorEntity,
+            AZStd::string::format("%s_%zu", m_settings.name.c_str(), index).c_str());
+        if (!entityId.IsValid())
+        {
+            return entityId;
+        }
+
+        // New editor entities already carry a transform, so only the render components are added
+        AZ::ComponentTypeList typeIds = { AZ::Render::EditorMeshComponentTypeId };
+        if (m_settings.materialAssetId.IsValid())
+        {
+            typeIds.push_back(AZ::Render::EditorMaterialComponentTypeId);
+        }
+        AzToolsFramework::EditorComponentAPIBus::Broadcast(
+            &AzToolsFramework::EditorComponentAPIRequests::AddComponentsOfType, entityId, typeIds);
+
+        if (m_groupId.IsValid())
+        {
+            AZ::TransformBus::Event(entityId, &AZ::TransformInterface::SetParent, m_groupId);
+        }
+        AZ::TransformBus::Event(entityId, &AZ::TransformInterface::SetWorldTM, m_transforms[index]);
+
+        // Every instance holds the same asset, so the model's buffers exist once
+        AZ::Render::MeshComponentRequestBus::Event(
+            entityId, &AZ::Render::MeshComponentRequests::SetModelAsset, m_modelAsset);
+        if (m_settings.materialAssetId.IsValid())
+        {
+            AZ::Render::MaterialComponentRequestBus::Event(
+                entityId, &AZ::Render::MaterialComponentRequests::SetMaterialAssetIdOnDefaultSlot, m_settings.materialAssetId);
+        }
+
+        AzToolsFramework::ToolsApplicationRequests::Bus::Broadcast(
+            &AzToolsFramework::ToolsApplicationRequests::AddDirtyEntity, entityId);
+        return entityId;
+    }
+
+    void InstanceSpawner::Finish(bool cancelled)
+    {
+        AZ::SystemTickBus::Handler::BusDisconnect();
+        AzToolsFramework::EditorEntityContextNotificationBus::Handler::BusDisconnect();
+
+        InstanceSpawnStats stats;
+        stats.spawned = m_next;
+        stats.cancelled = cancelled;
+        stats.seconds = AZStd::chrono::duration<double>(AZStd::chrono::steady_clock::now() - m_startTime).count();
+
+        if (m_groupId.IsValid())
+        {
+            AzToolsFramework::ToolsApplicationRequests::Bus::Broadcast(
+                &AzToolsFramework::ToolsApplicationRequests::SetSelectedEntities, AzToolsFramework::EntityIdList{ m_groupId });
+        }
+
+        AZ_Printf("CustomCppToolGem", "Spawned %zu of %zu instances in %.2f s (%.0f entities/s)%s\n",
+            stats.spawned, m_transforms.size(), stats.seconds, stats.GetEntitiesPerSecond(), cancelled ? ", cancelled" : "");
+
+        m_transforms.clear();
+        m_modelAsset.Reset();
+        m_groupId.SetInvalid();
+        m_undoBatch = nullptr;
+
+        FinishedCallback onFinished = AZStd::move(m_onFinished);
+        m_onFinished = {};
+        if (onFinished)
+        {
+            onFinished(stats);
+        }
+    }
+} // namespace CustomCppToolGem
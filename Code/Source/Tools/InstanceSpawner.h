@@ -0,0 +1,90 @@
+#pragma once
+
+#include <AzCore/Component/EntityId.h>
+#include <AzCore/Component/TickBus.h>
+#include <AzCore/Math/Transform.h>
+#include <AzCore/std/chrono/chrono.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/functional.h>
+#include <AzCore/std/string/string.h>
+
+#include <AzToolsFramework/Entity/EditorEntityContextBus.h>
+
+#include <Atom/RPI.Reflect/Model/ModelAsset.h>
+
+namespace AzToolsFramework::UndoSystem
+{
+    class URSequencePoint;
+}
+
+namespace CustomCppToolGem
+{
+    struct InstanceSpawnSettings
+    {
+        //! Entities created per system tick
+        uint32_t batchSize = 256;
+        //! Optional material for the default slot of every instance
+        AZ::Data::AssetId materialAssetId;
+        //! Name of the group entity; instances are named "<name>_<index>"
+        AZStd::string name = "Instances";
+    };
+
+    struct InstanceSpawnStats
+    {
+        size_t spawned = 0;
+        double seconds = 0.0;
+        bool cancelled = false;
+
+        double GetEntitiesPerSecond() const { return seconds > 0.0 ? spawned / seconds : 0.0; }
+    };
+
+    //! Creates one editor entity per transform, all showing the same model asset.
+    //! Entities are created a batch per system tick so the editor keeps drawing, under one group
+    //! entity so the outliner only gains a single collapsed row. Each tick closes its undo batch
+    //! again and the next one resumes it, so the whole spawn is undone in one step unless another
+    //! edit lands in between. Selection changes once, when the spawn finishes. A spawn still
+    //! running when the level is unloaded is cancelled.
+    class InstanceSpawner
+        : private AZ::SystemTickBus::Handler
+        , private AzToolsFramework::EditorEntityContextNotificationBus::Handler
+    {
+    public:
+        using FinishedCallback = AZStd::function<void(const InstanceSpawnStats& stats)>;
+
+        ~InstanceSpawner() override;
+
+        //! Begin spawning; returns false when a spawn is already running or there is nothing to spawn.
+        //! onFinished runs on the main thread after the last batch or after Cancel().
+        bool Start(
+            AZ::Data::Asset<AZ::RPI::ModelAsset> modelAsset,
+            AZStd::vector<AZ::Transform> transforms,
+            const InstanceSpawnSettings& settings,
+            FinishedCallback onFinished = {});
+
+        //! Stop after the current batch. Entities spawned so far are kept and stay undoable.
+        void Cancel();
+
+        bool IsRunning() const { return !m_transforms.empty(); }
+        size_t GetSpawnedCount() const { return m_next; }
+        size_t GetTotalCount() const { return m_transforms.size(); }
+
+    private:
+        void OnSystemTick() override;
+
+        // EditorEntityContextNotificationBus overrides
+        void OnPrepareForContextReset() override;
+
+        AZ::EntityId SpawnInstance(size_t index);
+        void Finish(bool cancelled);
+
+        AZ::Data::Asset<AZ::RPI::ModelAsset> m_modelAsset;
+        AZStd::vector<AZ::Transform> m_transforms;
+        InstanceSpawnSettings m_settings;
+        FinishedCallback m_onFinished;
+        AZ::EntityId m_groupId;
+        //! Undo batch of the spawn, reopened by every tick
+        AzToolsFramework::UndoSystem::URSequencePoint* m_undoBatch = nullptr;
+        size_t m_next = 0;
+        AZStd::chrono::steady_clock::time_point m_startTime;
+    };
+} // namespace CustomCppToolGem
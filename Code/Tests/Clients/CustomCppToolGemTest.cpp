@@ -1,4 +1,1771 @@
-
 #include <AzTest/AzTest.h>
+#include <AzCore/Jobs/JobContext.h>
+#include <AzCore/Jobs/JobManager.h>
+#include <AzCore/Jobs/JobManagerDesc.h>
+#include <AzCore/Name/NameDictionary.h>
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/parallel/thread.h>
+#include <AzFramework/IO/LocalFileIO.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include <Clients/GenerationScheduler.h>
+#include <Generation/ChunkedVoxelMesher.h>
+#include <Generation/MeshFile.h>
+#include <Generation/MeshImporter.h>
+#include <Generation/MeshOptimizer.h>
+#include <Generation/MeshSimplifier.h>
+#include <Generation/MeshStatistics.h>
+#include <Generation/MeshUtils.h>
+#include <Generation/ModelBuilder.h>
+#include <Generation/QuadBatch.h>
+#include <Generation/VertexCompression.h>
+#include <Generation/VoxelDirtyChunks.h>
+#include <Generation/VoxelMesher.h>
+
+namespace UnitTest
+{
+    class CustomCppToolGemVoxelMesherTest : public LeakDetectionFixture
+    {
+    protected:
+        //! A 4 x 1 x 1 bar of one material using tile for every face
+        static CustomGem::VoxelVolume MakeBar(CustomGem::UVIndex tile)
+        {
+            CustomGem::VoxelVolume volume;
+            volume.Resize(4, 1, 1);
+            volume.palette = { CustomGem::VoxelMaterial{}, CustomGem::VoxelMaterial::FromTile(tile) };
+            for (int x = 0; x < 4; ++x)
+            {
+                volume.Set(x, 0, 0, 1);
+            }
+            return volume;
+        }
+    };
+
+    TEST_F(CustomCppToolGemVoxelMesherTest, GreedyMerge_WholeTextureTile_MergesEachSide)
+    {
+        CustomGem::MeshData mesh;
+        const CustomGem::VoxelMeshStats stats = CustomGem::VoxelMesher::BuildMesh(MakeBar({ 1, 0 }), mesh);
+        EXPECT_EQ(stats.exposedFaces, 18u);
+        EXPECT_EQ(stats.quads, 6u);
+    }
+
+    TEST_F(CustomCppToolGemVoxelMesherTest, GreedyMerge_AtlasTile_KeepsFacesInsideTheirTile)
+    {
+        CustomGem::MeshData mesh;
+        const CustomGem::VoxelMeshStats stats = CustomGem::VoxelMesher::BuildMesh(MakeBar({ 4, 5 }), mesh);
+        EXPECT_EQ(stats.quads, 18u);
+
+        // Every uv stays inside tile 5 of the 4 x 4 atlas: u in [0.25, 0.5], v in [0.25, 0.5]
+        for (size_t i = 0; i < mesh.uvs.size(); i += 2)
+        {
+            EXPECT_GE(mesh.uvs[i], 0.25f);
+            EXPECT_LE(mesh.uvs[i], 0.5f);
+            EXPECT_GE(mesh.uvs[i + 1], 0.25f);
+            EXPECT_LE(mesh.uvs[i + 1], 0.5f);
+        }
+    }
+
+    TEST_F(CustomCppToolGemVoxelMesherTest, GreedyMerge_MergeAtlasTiles_MergesAcrossTiles)
+    {
+        CustomGem::VoxelMeshSettings settings;
+        settings.mergeAtlasTiles = true;
+        CustomGem::MeshData mesh;
+        const CustomGem::VoxelMeshStats stats = CustomGem::VoxelMesher::BuildMesh(MakeBar({ 4, 5 }), mesh, settings);
+        EXPECT_EQ(stats.quads, 6u);
+    }
+
+    //! Runs the chunk jobs on a job manager of its own with several workers, so they really interleave
+    class CustomCppToolGemChunkedVoxelMesherTest : public LeakDetectionFixture
+    {
+    public:
+        void SetUp() override
+        {
+            LeakDetectionFixture::SetUp();
+            AZ::JobManagerDesc desc;
+            desc.m_workerThreads.resize(4);
+            m_jobManager = AZStd::make_unique<AZ::JobManager>(desc);
+            m_jobContext = AZStd::make_unique<AZ::JobContext>(*m_jobManager);
+        }
+
+        void TearDown() override
+        {
+            m_jobContext.reset();
+            m_jobManager.reset();
+            LeakDetectionFixture::TearDown();
+        }
+
+    protected:
+        //! Rolling terrain with overhangs whose size is not a multiple of the chunk size
+        static CustomGem::VoxelVolume MakeTerrain()
+        {
+            CustomGem::VoxelVolume volume;
+            volume.Resize(21, 13, 19);
+            volume.palette = {
+                CustomGem::VoxelMaterial{}, CustomGem::VoxelMaterial::FromTile({ 4, 1 }), CustomGem::VoxelMaterial::FromTile({ 4, 2 })
+            };
+            for (int z = 0; z < 19; ++z)
+            {
+                for (int x = 0; x < 21; ++x)
+                {
+                    const int height = 3 + (x * 7 + z * 3) % 9;
+                    for (int y = 0; y < height; ++y)
+                    {
+                        volume.Set(x, y, z, (x + y + z) % 5 == 0 ? 2 : 1);
+                    }
+                }
+            }
+            return volume;
+        }
+
+        template<class T>
+        static bool SameBytes(const AZStd::vector<T>& left, const AZStd::vector<T>& right)
+        {
+            return left.size() == right.size() && (left.empty() || memcmp(left.data(), right.data(), left.size() * sizeof(T)) == 0);
+        }
+
+        static void ExpectSameChunk(const CustomGem::VoxelChunk& expected, const CustomGem::VoxelChunk& chunk)
+        {
+            EXPECT_EQ(chunk.stats.quads, expected.stats.quads);
+            EXPECT_EQ(chunk.stats.exposedFaces, expected.stats.exposedFaces);
+            EXPECT_TRUE(SameBytes(chunk.mesh.positions, expected.mesh.positions));
+            EXPECT_TRUE(SameBytes(chunk.mesh.normals, expected.mesh.normals));
+            EXPECT_TRUE(SameBytes(chunk.mesh.uvs, expected.mesh.uvs));
+            EXPECT_TRUE(SameBytes(chunk.mesh.indices, expected.mesh.indices));
+            EXPECT_TRUE(SameBytes(chunk.mesh.indices16, expected.mesh.indices16));
+        }
+
+        AZStd::unique_ptr<AZ::JobManager> m_jobManager;
+        AZStd::unique_ptr<AZ::JobContext> m_jobContext;
+    };
+
+    TEST_F(CustomCppToolGemChunkedVoxelMesherTest, Build_MatchesChunksMeshedOneByOne)
+    {
+        const CustomGem::VoxelVolume volume = MakeTerrain();
+        CustomGem::ChunkedMeshSettings settings;
+        settings.chunkSize = 8;
+        settings.createModels = false;
+        settings.jobContext = m_jobContext.get();
+
+        AZStd::vector<CustomGem::VoxelChunk> chunks;
+        CustomGem::ChunkedVoxelMesher::Build(volume, settings, chunks);
+        ASSERT_EQ(chunks.size(), 3u * 2u * 3u);
+
+        // The same chunks meshed on this thread, and again as jobs queued in reverse order
+        AZStd::vector<CustomGem::VoxelChunk> reversed(chunks.size());
+        AZStd::vector<CustomGem::VoxelChunk*> pending;
+        uint64_t quads = 0;
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            CustomGem::VoxelChunk single;
+            single.coord = chunks[i].coord;
+            single.origin = chunks[i].origin;
+            CustomGem::ChunkedVoxelMesher::BuildChunk(volume, settings, single);
+            ExpectSameChunk(single, chunks[i]);
+            EXPECT_FALSE(chunks[i].model);
+            quads += single.stats.quads;
+
+            reversed[i].coord = chunks[i].coord;
+            reversed[i].origin = chunks[i].origin;
+            pending.insert(pending.begin(), &reversed[i]);
+        }
+        EXPECT_GT(quads, 0u);
+
+        CustomGem::ChunkedVoxelMesher::BuildChunks(volume, settings, pending);
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            ExpectSameChunk(chunks[i], reversed[i]);
+        }
+    }
+
+    class CustomCppToolGemVoxelDirtyChunksTest : public LeakDetectionFixture
+    {
+    protected:
+        //! Marks the chunks a single voxel edit at (x, y, z) touches and hands them back
+        AZStd::vector<size_t> EditVoxel(int x, int y, int z)
+        {
+            m_dirty.MarkRegionDirty({ x, y, z }, { x + 1, y + 1, z + 1 });
+            return m_dirty.TakeDirtyChunks();
+        }
+
+        CustomGem::VoxelDirtyChunks m_dirty;
+    };
+
+    TEST_F(CustomCppToolGemVoxelDirtyChunksTest, MarkRegionDirty_InteriorVoxel_DirtiesOnlyItsChunk)
+    {
+        // 2 x 2 x 2 chunks of 8, chunk index x fastest
+        m_dirty.Initialize({ 16, 16, 16 }, 8);
+        EXPECT_EQ(EditVoxel(3, 3, 3), (AZStd::vector<size_t>{ 0 }));
+        EXPECT_EQ(EditVoxel(12, 4, 10), (AZStd::vector<size_t>{ 5 }));
+        EXPECT_FALSE(m_dirty.HasDirtyChunks());
+    }
+
+    TEST_F(CustomCppToolGemVoxelDirtyChunksTest, MarkRegionDirty_BorderVoxel_DirtiesNeighbours)
+    {
+        m_dirty.Initialize({ 16, 16, 16 }, 8);
+
+        // Either side of the x border between chunk 0 and chunk 1
+        EXPECT_EQ(EditVoxel(7, 3, 3), (AZStd::vector<size_t>{ 0, 1 }));
+        EXPECT_EQ(EditVoxel(8, 3, 3), (AZStd::vector<size_t>{ 0, 1 }));
+        // Across the y and z borders
+        EXPECT_EQ(EditVoxel(3, 7, 3), (AZStd::vector<size_t>{ 0, 2 }));
+        EXPECT_EQ(EditVoxel(3, 3, 8), (AZStd::vector<size_t>{ 0, 4 }));
+        // A corner voxel touches all eight chunks
+        EXPECT_EQ(EditVoxel(7, 8, 7), (AZStd::vector<size_t>{ 0, 1, 2, 3, 4, 5, 6, 7 }));
+    }
+
+    TEST_F(CustomCppToolGemVoxelDirtyChunksTest, MarkRegionDirty_VolumeEdge_StaysInsideGrid)
+    {
+        // 20 voxels in chunks of 8 leave a last chunk of 4 along x
+        m_dirty.Initialize({ 20, 8, 8 }, 8);
+        EXPECT_EQ(m_dirty.GetChunkCount().x, 3);
+        EXPECT_EQ(EditVoxel(19, 0, 0), (AZStd::vector<size_t>{ 2 }));
+        EXPECT_EQ(EditVoxel(0, 7, 7), (AZStd::vector<size_t>{ 0 }));
+        EXPECT_EQ(m_dirty.GetChunkIndex(19, 7, 7), 2u);
+        EXPECT_EQ(m_dirty.GetChunkIndex(20, 0, 0), CustomGem::VoxelDirtyChunks::InvalidChunk);
+        EXPECT_EQ(m_dirty.GetChunkIndex(-1, 0, 0), CustomGem::VoxelDirtyChunks::InvalidChunk);
+    }
+
+    TEST_F(CustomCppToolGemVoxelDirtyChunksTest, TakeDirtyChunks_KeepsMarkOrderOnceAndClears)
+    {
+        m_dirty.Initialize({ 16, 16, 16 }, 8);
+        m_dirty.MarkChunkDirty(6);
+        m_dirty.MarkRegionDirty({ 1, 1, 1 }, { 2, 2, 2 });
+        m_dirty.MarkChunkDirty(6);
+        EXPECT_TRUE(m_dirty.IsDirty(6));
+        EXPECT_TRUE(m_dirty.IsDirty(0));
+
+        EXPECT_EQ(m_dirty.TakeDirtyChunks(), (AZStd::vector<size_t>{ 6, 0 }));
+        EXPECT_FALSE(m_dirty.IsDirty(6));
+        EXPECT_FALSE(m_dirty.HasDirtyChunks());
+        EXPECT_TRUE(m_dirty.TakeDirtyChunks().empty());
+    }
+
+    class CustomCppToolGemMeshOptimizerTest : public LeakDetectionFixture
+    {
+    protected:
+        //! Two copies of a row of count vertices starting at x, indexed as degenerate triangles
+        static CustomGem::MeshData MakeDuplicatedRow(float x, uint32_t count)
+        {
+            CustomGem::MeshData mesh;
+            for (uint32_t copy = 0; copy < 2; ++copy)
+            {
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    const AZ::Vector3 position(x + static_cast<float>(i), 0.0f, 0.0f);
+                    CustomGem::MeshUtils::PushVertex(mesh, position, AZ::Vector3::CreateAxisZ(), AZ::Vector3::CreateAxisX(),
+                        AZ::Vector3::CreateAxisY(), 0.0f, 0.0f);
+                    mesh.indices.push_back(copy * count + i);
+                }
+            }
+            return mesh;
+        }
+
+        //! Welded size x size quad grid on the plane through origin spanned by axisU and axisV,
+        //! indexed row by row. Every attribute is derived from the position, see ExpectAttributesMatchPositions.
+        static void AppendGrid(CustomGem::MeshData& mesh, const AZ::Vector3& origin, const AZ::Vector3& axisU,
+            const AZ::Vector3& axisV, uint32_t size)
+        {
+            const uint32_t base = static_cast<uint32_t>(mesh.GetVertexCount());
+            for (uint32_t y = 0; y <= size; ++y)
+            {
+                for (uint32_t x = 0; x <= size; ++x)
+                {
+                    const AZ::Vector3 p = origin + axisU * static_cast<float>(x) + axisV * static_cast<float>(y);
+                    CustomGem::MeshUtils::PushVertex(mesh, p, AZ::Vector3(p.GetX(), p.GetY(), 1.0f),
+                        AZ::Vector3(p.GetY(), p.GetZ(), p.GetX()), AZ::Vector3(p.GetZ(), p.GetX(), p.GetY()),
+                        p.GetX() + 2.0f * p.GetZ(), p.GetY() - p.GetZ());
+                }
+            }
+            for (uint32_t y = 0; y < size; ++y)
+            {
+                for (uint32_t x = 0; x < size; ++x)
+                {
+                    const uint32_t i0 = base + y * (size + 1) + x;
+                    const uint32_t i1 = i0 + 1;
+                    const uint32_t i2 = i0 + size + 1;
+                    const uint32_t i3 = i2 + 1;
+                    mesh.AppendIndices({ i0, i1, i3, i0, i3, i2 });
+                }
+            }
+        }
+
+        //! Closed box of six separate size x size grids
+        static CustomGem::MeshData MakeBox(uint32_t size)
+        {
+            const float s = static_cast<float>(size);
+            CustomGem::MeshData mesh;
+            AppendGrid(mesh, AZ::Vector3(0.0f, 0.0f, 0.0f), AZ::Vector3::CreateAxisY(), AZ::Vector3::CreateAxisX(), size);
+            AppendGrid(mesh, AZ::Vector3(0.0f, 0.0f, s), AZ::Vector3::CreateAxisX(), AZ::Vector3::CreateAxisY(), size);
+            AppendGrid(mesh, AZ::Vector3(0.0f, 0.0f, 0.0f), AZ::Vector3::CreateAxisX(), AZ::Vector3::CreateAxisZ(), size);
+            AppendGrid(mesh, AZ::Vector3(0.0f, s, 0.0f), AZ::Vector3::CreateAxisZ(), AZ::Vector3::CreateAxisX(), size);
+            AppendGrid(mesh, AZ::Vector3(0.0f, 0.0f, 0.0f), AZ::Vector3::CreateAxisZ(), AZ::Vector3::CreateAxisY(), size);
+            AppendGrid(mesh, AZ::Vector3(s, 0.0f, 0.0f), AZ::Vector3::CreateAxisY(), AZ::Vector3::CreateAxisZ(), size);
+            return mesh;
+        }
+
+        static uint32_t GetIndex(const CustomGem::MeshData& mesh, size_t i)
+        {
+            return mesh.use16BitIndices ? mesh.indices16[i] : mesh.indices[i];
+        }
+
+        //! Triangles as corner positions, each rotated to start at its smallest corner (keeping the
+        //! winding) and sorted, so two meshes compare equal when they draw the same triangles
+        static AZStd::vector<AZStd::array<float, 9>> GetTriangleSet(const CustomGem::MeshData& mesh)
+        {
+            AZStd::vector<AZStd::array<float, 9>> triangles(mesh.GetIndexCount() / 3);
+            for (size_t t = 0; t < triangles.size(); ++t)
+            {
+                AZStd::array<AZStd::array<float, 3>, 3> corners;
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    const uint32_t index = GetIndex(mesh, t * 3 + k);
+                    corners[k] = { mesh.positions[index * 3], mesh.positions[index * 3 + 1], mesh.positions[index * 3 + 2] };
+                }
+                const size_t first = AZStd::min_element(corners.begin(), corners.end()) - corners.begin();
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    AZStd::copy(corners[(first + k) % 3].begin(), corners[(first + k) % 3].end(), triangles[t].begin() + k * 3);
+                }
+            }
+            AZStd::sort(triangles.begin(), triangles.end());
+            return triangles;
+        }
+
+        static CustomGem::VertexCacheStats AnalyzeMesh(const CustomGem::MeshData& mesh)
+        {
+            AZStd::vector<uint32_t> indices(mesh.GetIndexCount());
+            for (size_t i = 0; i < indices.size(); ++i)
+            {
+                indices[i] = GetIndex(mesh, i);
+            }
+            return CustomGem::MeshOptimizer::AnalyzeVertexCache(indices, mesh.GetVertexCount());
+        }
+
+        //! Every vertex still carries the attributes AppendGrid derived from its position
+        static void ExpectAttributesMatchPositions(const CustomGem::MeshData& mesh)
+        {
+            for (size_t v = 0; v < mesh.GetVertexCount(); ++v)
+            {
+                const float x = mesh.positions[v * 3];
+                const float y = mesh.positions[v * 3 + 1];
+                const float z = mesh.positions[v * 3 + 2];
+                EXPECT_EQ(mesh.normals[v * 3], x);
+                EXPECT_EQ(mesh.normals[v * 3 + 1], y);
+                EXPECT_EQ(mesh.tangents[v * 4], y);
+                EXPECT_EQ(mesh.tangents[v * 4 + 1], z);
+                EXPECT_EQ(mesh.bitangents[v * 3], z);
+                EXPECT_EQ(mesh.bitangents[v * 3 + 1], x);
+                EXPECT_EQ(mesh.uvs[v * 2], x + 2.0f * z);
+                EXPECT_EQ(mesh.uvs[v * 2 + 1], y - z);
+            }
+        }
+    };
+
+    TEST_F(CustomCppToolGemMeshOptimizerTest, WeldVertices_Duplicates_MergesAndRemapsIndices)
+    {
+        CustomGem::MeshData mesh = MakeDuplicatedRow(0.0f, 300);
+        const CustomGem::WeldStats stats = CustomGem::MeshOptimizer::WeldVertices(mesh);
+        EXPECT_EQ(stats.verticesBefore, 600u);
+        EXPECT_EQ(stats.verticesAfter, 300u);
+        ASSERT_EQ(mesh.indices.size(), 600u);
+        for (uint32_t i = 0; i < 300; ++i)
+        {
+            EXPECT_EQ(mesh.indices[i], i);
+            EXPECT_EQ(mesh.indices[300 + i], i);
+        }
+    }
+
+    TEST_F(CustomCppToolGemMeshOptimizerTest, WeldVertices_LargeCoordinates_KeepsDistinctCells)
+    {
+        // With the default 1e-5 tolerance these coordinates are far past 2^31 cells
+        for (float x : { 30000.0f, 1.0e6f, -1.0e6f, 3.0e12f })
+        {
+            const float step = AZStd::max(1.0f, x * 1.0e-6f);
+            CustomGem::MeshData mesh;
+            for (uint32_t copy = 0; copy < 2; ++copy)
+            {
+                for (uint32_t i = 0; i < 2000; ++i)
+                {
+                    CustomGem::MeshUtils::PushVertex(mesh, AZ::Vector3(x + step * static_cast<float>(i), 0.0f, 0.0f),
+                        AZ::Vector3::CreateAxisZ(), AZ::Vector3::CreateAxisX(), AZ::Vector3::CreateAxisY(), 0.0f, 0.0f);
+                }
+            }
+            const CustomGem::WeldStats stats = CustomGem::MeshOptimizer::WeldVertices(mesh);
+            EXPECT_EQ(stats.verticesAfter, 2000u) << "x = " << x;
+        }
+    }
+
+    TEST_F(CustomCppToolGemMeshOptimizerTest, AnalyzeVertexCache_Quad_CountsEachVertexOnce)
+    {
+        const AZStd::vector<uint32_t> indices = { 0, 1, 3, 0, 3, 2 };
+        const CustomGem::VertexCacheStats stats = CustomGem::MeshOptimizer::AnalyzeVertexCache(indices, 4);
+        EXPECT_FLOAT_EQ(stats.acmr, 2.0f);
+        EXPECT_FLOAT_EQ(stats.atvr, 1.0f);
+
+        // A cache of one entry reloads every vertex the next triangle does not start with
+        const CustomGem::VertexCacheStats tiny = CustomGem::MeshOptimizer::AnalyzeVertexCache(indices, 4, 1);
+        EXPECT_GT(tiny.acmr, stats.acmr);
+    }
+
+    TEST_F(CustomCppToolGemMeshOptimizerTest, OptimizeVertexCache_Grid_PermutesTrianglesAndLowersAcmr)
+    {
+        CustomGem::MeshData mesh;
+        AppendGrid(mesh, AZ::Vector3::CreateZero(), AZ::Vector3::CreateAxisX(), AZ::Vector3::CreateAxisY(), 48);
+        const auto trianglesBefore = GetTriangleSet(mesh);
+        const CustomGem::VertexCacheStats before = AnalyzeMesh(mesh);
+
+        CustomGem::MeshOptimizer::OptimizeVertexCache(mesh.indices, mesh.GetVertexCount());
+
+        EXPECT_EQ(GetTriangleSet(mesh), trianglesBefore);
+        EXPECT_LT(AnalyzeMesh(mesh).acmr, before.acmr);
+    }
+
+    TEST_F(CustomCppToolGemMeshOptimizerTest, OptimizeOverdraw_Box_PermutesTrianglesWithinThreshold)
+    {
+        for (float threshold : { 1.0f, 1.05f, 1.5f })
+        {
+            CustomGem::MeshData mesh = MakeBox(12);
+            CustomGem::MeshOptimizer::OptimizeVertexCache(mesh.indices, mesh.GetVertexCount());
+            const auto trianglesBefore = GetTriangleSet(mesh);
+            const float acmrBefore = AnalyzeMesh(mesh).acmr;
+
+            CustomGem::MeshOptimizer::OptimizeOverdraw(mesh.indices, mesh.positions, threshold);
+
+            EXPECT_EQ(GetTriangleSet(mesh), trianglesBefore) << "threshold = " << threshold;
+            EXPECT_LE(AnalyzeMesh(mesh).acmr, acmrBefore * threshold) << "threshold = " << threshold;
+        }
+    }
+
+    TEST_F(CustomCppToolGemMeshOptimizerTest, OptimizeVertexFetch_Grid_PermutesAllStreamsTogether)
+    {
+        CustomGem::MeshData mesh;
+        mesh.use16BitIndices = true;
+        AppendGrid(mesh, AZ::Vector3::CreateZero(), AZ::Vector3::CreateAxisX(), AZ::Vector3::CreateAxisY(), 16);
+        const auto trianglesBefore = GetTriangleSet(mesh);
+
+        // Shuffle the draw order so the fetch order differs from the vertex order
+        const size_t triangleCount = mesh.indices16.size() / 3;
+        for (size_t t = 0; t < triangleCount / 2; t += 7)
+        {
+            AZStd::swap_ranges(mesh.indices16.begin() + t * 3, mesh.indices16.begin() + t * 3 + 3, mesh.indices16.end() - t * 3 - 3);
+        }
+
+        CustomGem::MeshOptimizer::OptimizeVertexFetch(mesh);
+
+        ASSERT_TRUE(mesh.use16BitIndices);
+        EXPECT_TRUE(mesh.indices.empty());
+        EXPECT_EQ(GetTriangleSet(mesh), trianglesBefore);
+        ExpectAttributesMatchPositions(mesh);
+
+        // Vertices come in order of first use
+        uint32_t next = 0;
+        for (uint16_t index : mesh.indices16)
+        {
+            EXPECT_LE(index, next);
+            next = AZStd::max<uint32_t>(next, index + 1u);
+        }
+    }
+
+    TEST_F(CustomCppToolGemMeshOptimizerTest, Optimize_16BitGrid_KeepsIndexWidthTrianglesAndAttributes)
+    {
+        CustomGem::MeshData mesh;
+        mesh.use16BitIndices = true;
+        AppendGrid(mesh, AZ::Vector3::CreateZero(), AZ::Vector3::CreateAxisX(), AZ::Vector3::CreateAxisY(), 32);
+        const auto trianglesBefore = GetTriangleSet(mesh);
+
+        CustomGem::OptimizeSettings settings;
+        settings.overdraw = true;
+        const CustomGem::OptimizeStats stats = CustomGem::MeshOptimizer::Optimize(mesh, settings);
+
+        EXPECT_TRUE(mesh.use16BitIndices);
+        EXPECT_TRUE(mesh.indices.empty());
+        EXPECT_EQ(GetTriangleSet(mesh), trianglesBefore);
+        ExpectAttributesMatchPositions(mesh);
+        EXPECT_LE(stats.afterVertexCache.acmr, stats.initial.acmr);
+        EXPECT_LE(stats.afterOverdraw.acmr, stats.afterVertexCache.acmr * settings.overdrawThreshold);
+        EXPECT_FLOAT_EQ(AnalyzeMesh(mesh).acmr, stats.afterOverdraw.acmr);
+    }
+
+    class CustomCppToolGemMeshSimplifierTest : public LeakDetectionFixture
+    {
+    protected:
+        //! size x size grid on z = 0, raised by bump * sin cos when bump is set. The uvs follow the
+        //! positions except that quads from seamColumn on get u shifted by 1, which leaves a uv
+        //! seam along x = seamColumn; 0 means no seam. Unwelded grids repeat every corner per quad.
+        static CustomGem::MeshData MakeGrid(uint32_t size, bool welded, uint32_t seamColumn = 0, float bump = 0.0f)
+        {
+            CustomGem::MeshData mesh;
+            AZStd::vector<uint32_t> vertexIds((size + 1) * (size + 1) * 2, UINT32_MAX);
+            auto vertex = [&](uint32_t x, uint32_t y, bool rightOfSeam)
+            {
+                uint32_t& id = vertexIds[((y * (size + 1)) + x) * 2 + (rightOfSeam ? 1 : 0)];
+                if (!welded || id == UINT32_MAX)
+                {
+                    const float z = bump * std::sin(static_cast<float>(x) * 0.7f) * std::cos(static_cast<float>(y) * 0.9f);
+                    id = static_cast<uint32_t>(mesh.GetVertexCount());
+                    CustomGem::MeshUtils::PushVertex(mesh, AZ::Vector3(static_cast<float>(x), static_cast<float>(y), z),
+                        AZ::Vector3::CreateAxisZ(), AZ::Vector3::CreateAxisX(), AZ::Vector3::CreateAxisY(),
+                        static_cast<float>(x) / static_cast<float>(size) + (rightOfSeam ? 1.0f : 0.0f),
+                        static_cast<float>(y) / static_cast<float>(size));
+                }
+                return id;
+            };
+
+            for (uint32_t y = 0; y < size; ++y)
+            {
+                for (uint32_t x = 0; x < size; ++x)
+                {
+                    const bool rightOfSeam = seamColumn > 0 && x >= seamColumn;
+                    const uint32_t i0 = vertex(x, y, rightOfSeam);
+                    const uint32_t i1 = vertex(x + 1, y, rightOfSeam);
+                    const uint32_t i2 = vertex(x, y + 1, rightOfSeam);
+                    const uint32_t i3 = vertex(x + 1, y + 1, rightOfSeam);
+                    mesh.AppendIndices({ i0, i1, i3, i0, i3, i2 });
+                }
+            }
+            return mesh;
+        }
+
+        //! Whether mesh has a vertex with the position and uv of vertex v of other
+        static bool HasVertex(const CustomGem::MeshData& mesh, const CustomGem::MeshData& other, size_t v)
+        {
+            for (size_t i = 0; i < mesh.GetVertexCount(); ++i)
+            {
+                if (AZStd::equal(&mesh.positions[i * 3], &mesh.positions[i * 3] + 3, &other.positions[v * 3]) &&
+                    AZStd::equal(&mesh.uvs[i * 2], &mesh.uvs[i * 2] + 2, &other.uvs[v * 2]))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    TEST_F(CustomCppToolGemMeshSimplifierTest, Simplify_FlatGrid_ReachesTriangleRatio)
+    {
+        for (bool welded : { true, false })
+        {
+            const CustomGem::MeshData source = MakeGrid(24, welded);
+            CustomGem::SimplifySettings settings;
+            settings.triangleRatio = 0.25f;
+            settings.maxError = 0.01f;
+
+            CustomGem::MeshData output;
+            const CustomGem::SimplifyStats stats = CustomGem::MeshSimplifier::Simplify(source, output, settings);
+
+            EXPECT_EQ(stats.trianglesBefore, 24u * 24u * 2u) << "welded = " << welded;
+            EXPECT_GT(stats.trianglesAfter, 0u) << "welded = " << welded;
+            EXPECT_LE(stats.trianglesAfter, stats.trianglesBefore / 4) << "welded = " << welded;
+            EXPECT_EQ(output.GetIndexCount(), stats.trianglesAfter * 3) << "welded = " << welded;
+            EXPECT_EQ(output.GetVertexCount(), stats.verticesAfter) << "welded = " << welded;
+            EXPECT_LE(stats.error, settings.maxError) << "welded = " << welded;
+        }
+    }
+
+    TEST_F(CustomCppToolGemMeshSimplifierTest, Simplify_GridWithUvSeam_KeepsSeamAndBorderVertices)
+    {
+        constexpr uint32_t Size = 24;
+        constexpr uint32_t SeamColumn = 10;
+        for (bool welded : { true, false })
+        {
+            const CustomGem::MeshData source = MakeGrid(Size, welded, SeamColumn);
+            CustomGem::SimplifySettings settings;
+            settings.triangleRatio = 0.25f;
+
+            CustomGem::MeshData output;
+            const CustomGem::SimplifyStats stats = CustomGem::MeshSimplifier::Simplify(source, output, settings);
+            EXPECT_LT(stats.trianglesAfter, stats.trianglesBefore / 2) << "welded = " << welded;
+
+            for (size_t v = 0; v < source.GetVertexCount(); ++v)
+            {
+                const float x = source.positions[v * 3];
+                const float y = source.positions[v * 3 + 1];
+                const bool fixed = x == 0.0f || y == 0.0f || x == static_cast<float>(Size) || y == static_cast<float>(Size) ||
+                    x == static_cast<float>(SeamColumn);
+                if (fixed)
+                {
+                    EXPECT_TRUE(HasVertex(output, source, v)) << "welded = " << welded << ", x = " << x << ", y = " << y;
+                }
+            }
+            for (size_t v = 0; v < output.GetVertexCount(); ++v)
+            {
+                EXPECT_TRUE(HasVertex(source, output, v));
+            }
+        }
+    }
+
+    TEST_F(CustomCppToolGemMeshSimplifierTest, Simplify_BumpyGrid_ErrorStaysUnderMaxError)
+    {
+        // A looser limit never keeps more triangles, and the ratio alone would remove all of them
+        const CustomGem::MeshData source = MakeGrid(24, false, 0, 0.5f);
+        size_t previousTriangles = source.GetIndexCount() / 3;
+        for (float maxError : { 0.001f, 0.01f, 0.05f })
+        {
+            CustomGem::SimplifySettings settings;
+            settings.triangleRatio = 0.0f;
+            settings.maxError = maxError;
+
+            CustomGem::MeshData output;
+            const CustomGem::SimplifyStats stats = CustomGem::MeshSimplifier::Simplify(source, output, settings);
+            EXPECT_LE(stats.error, maxError) << "maxError = " << maxError;
+            EXPECT_GT(stats.trianglesAfter, 0u) << "maxError = " << maxError;
+            EXPECT_LE(stats.trianglesAfter, previousTriangles) << "maxError = " << maxError;
+            previousTriangles = stats.trianglesAfter;
+        }
+        EXPECT_LT(previousTriangles, source.GetIndexCount() / 3);
+    }
+
+    //! ComputeContentHash only needs names, so the fixture provides a name dictionary and no assets
+    class CustomCppToolGemContentHashTest : public LeakDetectionFixture
+    {
+    public:
+        void SetUp() override
+        {
+            LeakDetectionFixture::SetUp();
+            if (!AZ::NameDictionary::IsReady())
+            {
+                AZ::NameDictionary::Create();
+                m_ownsNameDictionary = true;
+            }
+        }
+
+        void TearDown() override
+        {
+            if (m_ownsNameDictionary)
+            {
+                AZ::NameDictionary::Destroy();
+                m_ownsNameDictionary = false;
+            }
+            LeakDetectionFixture::TearDown();
+        }
+
+    protected:
+        static CustomGem::MeshData MakeMesh()
+        {
+            CustomGem::MeshData mesh;
+            for (int i = 0; i < 8; ++i)
+            {
+                CustomGem::MeshUtils::PushQuad(mesh, AZ::Vector3(static_cast<float>(i), 0.0f, 0.0f), i % CustomGem::FaceCount, { 4, i });
+            }
+            return mesh;
+        }
+
+        //! Settings with every hashed field away from its default, so each one can be changed alone
+        static CustomGem::ModelBuildSettings MakeSettings()
+        {
+            CustomGem::ModelBuildSettings settings;
+            settings.optimizeMesh = true;
+            settings.lods = { CustomGem::ModelLodSettings{ 0.5f, 0.01f }, CustomGem::ModelLodSettings{ 0.25f, 0.02f } };
+            return settings;
+        }
+
+        static AZ::HashValue64 Hash(
+            const CustomGem::MeshData& mesh,
+            const CustomGem::ModelBuildSettings& settings,
+            const char* name = "HashedModel",
+            uint32_t materialSlotId = 0,
+            const char* materialSlotName = "Default")
+        {
+            CustomGem::SubMesh subMesh;
+            subMesh.mesh = mesh.GetStreams();
+            subMesh.materialSlotId = materialSlotId;
+            subMesh.materialSlotName = AZ::Name(materialSlotName);
+            return CustomGem::ModelBuilder::ComputeContentHash(
+                AZ::Name(name), AZStd::span<const CustomGem::SubMesh>(&subMesh, 1), settings);
+        }
+
+    private:
+        bool m_ownsNameDictionary = false;
+    };
+
+    TEST_F(CustomCppToolGemContentHashTest, ComputeContentHash_EqualContent_EqualHash)
+    {
+        // Separate copies, so only the content can make the hashes match
+        const CustomGem::MeshData first = MakeMesh();
+        const CustomGem::MeshData second = MakeMesh();
+        EXPECT_EQ(Hash(first, MakeSettings()), Hash(second, MakeSettings()));
+        EXPECT_EQ(Hash(first, {}), Hash(second, {}));
+
+        // Neither the timings sink nor optimizer options of a disabled optimizer change the assets
+        CustomGem::ModelBuildTimings timings;
+        CustomGem::ModelBuildSettings withTimings = MakeSettings();
+        withTimings.timings = &timings;
+        EXPECT_EQ(Hash(first, withTimings), Hash(first, MakeSettings()));
+
+        CustomGem::ModelBuildSettings disabledOptimizer;
+        disabledOptimizer.optimizeSettings.overdraw = true;
+        EXPECT_EQ(Hash(first, disabledOptimizer), Hash(first, {}));
+    }
+
+    TEST_F(CustomCppToolGemContentHashTest, ComputeContentHash_StreamChange_ChangesHash)
+    {
+        const CustomGem::MeshData base = MakeMesh();
+        const AZ::HashValue64 baseHash = Hash(base, MakeSettings());
+
+        struct StreamChange
+        {
+            const char* label;
+            AZStd::function<void(CustomGem::MeshData&)> apply;
+        };
+        const StreamChange changes[] = {
+            { "index", [](CustomGem::MeshData& mesh) { AZStd::swap(mesh.indices[0], mesh.indices[1]); } },
+            { "index count", [](CustomGem::MeshData& mesh) { mesh.indices.resize(mesh.indices.size() - 3); } },
+            { "16-bit indices", [](CustomGem::MeshData& mesh) { mesh.NarrowIndices(); } },
+            { "position", [](CustomGem::MeshData& mesh) { mesh.positions.back() += 1.0f; } },
+            { "normal", [](CustomGem::MeshData& mesh) { mesh.normals[4] = -mesh.normals[4]; } },
+            { "tangent", [](CustomGem::MeshData& mesh) { mesh.tangents[3] = -mesh.tangents[3]; } },
+            { "bitangent", [](CustomGem::MeshData& mesh) { mesh.bitangents[1] += 0.5f; } },
+            { "uv", [](CustomGem::MeshData& mesh) { mesh.uvs[7] += 0.25f; } },
+            { "missing stream", [](CustomGem::MeshData& mesh) { mesh.bitangents.clear(); } },
+            { "extra vertex", [](CustomGem::MeshData& mesh)
+                {
+                    CustomGem::MeshUtils::PushVertex(mesh, AZ::Vector3::CreateZero(), AZ::Vector3::CreateAxisZ(),
+                        AZ::Vector3::CreateAxisX(), AZ::Vector3::CreateAxisY(), 0.0f, 0.0f);
+                } },
+        };
+        for (const StreamChange& change : changes)
+        {
+            CustomGem::MeshData mesh = MakeMesh();
+            change.apply(mesh);
+            EXPECT_NE(Hash(mesh, MakeSettings()), baseHash) << change.label;
+        }
+    }
+
+    TEST_F(CustomCppToolGemContentHashTest, ComputeContentHash_SettingChange_ChangesHash)
+    {
+        const CustomGem::MeshData mesh = MakeMesh();
+        const AZ::HashValue64 baseHash = Hash(mesh, MakeSettings());
+
+        EXPECT_NE(Hash(mesh, MakeSettings(), "OtherModel"), baseHash) << "name";
+        EXPECT_NE(Hash(mesh, MakeSettings(), "HashedModel", 1), baseHash) << "material slot id";
+        EXPECT_NE(Hash(mesh, MakeSettings(), "HashedModel", 0, "Other"), baseHash) << "material slot name";
+
+        struct SettingChange
+        {
+            const char* label;
+            AZStd::function<void(CustomGem::ModelBuildSettings&)> apply;
+        };
+        const SettingChange changes[] = {
+            { "indexFormat", [](CustomGem::ModelBuildSettings& s) { s.indexFormat = CustomGem::IndexBufferFormat::Uint32; } },
+            { "vertexLayout", [](CustomGem::ModelBuildSettings& s) { s.vertexLayout = CustomGem::VertexBufferLayout::SingleBuffer; } },
+            { "vertexProfile", [](CustomGem::ModelBuildSettings& s) { s.vertexProfile = CustomGem::VertexProfile::Quantized; } },
+            { "optimizeMesh", [](CustomGem::ModelBuildSettings& s) { s.optimizeMesh = false; } },
+            { "weld", [](CustomGem::ModelBuildSettings& s) { s.optimizeSettings.weld = true; } },
+            { "positionEpsilon", [](CustomGem::ModelBuildSettings& s) { s.optimizeSettings.weldSettings.positionEpsilon = 1e-3f; } },
+            { "normalEpsilon", [](CustomGem::ModelBuildSettings& s) { s.optimizeSettings.weldSettings.normalEpsilon = 0.0f; } },
+            { "tangentEpsilon", [](CustomGem::ModelBuildSettings& s) { s.optimizeSettings.weldSettings.tangentEpsilon = 0.0f; } },
+            { "bitangentEpsilon", [](CustomGem::ModelBuildSettings& s) { s.optimizeSettings.weldSettings.bitangentEpsilon = -1.0f; } },
+            { "uvEpsilon", [](CustomGem::ModelBuildSettings& s) { s.optimizeSettings.weldSettings.uvEpsilon = 0.0f; } },
+            { "vertexCache", [](CustomGem::ModelBuildSettings& s) { s.optimizeSettings.vertexCache = false; } },
+            { "overdraw", [](CustomGem::ModelBuildSettings& s) { s.optimizeSettings.overdraw = true; } },
+            { "overdrawThreshold", [](CustomGem::ModelBuildSettings& s) { s.optimizeSettings.overdrawThreshold = 1.5f; } },
+            { "vertexFetch", [](CustomGem::ModelBuildSettings& s) { s.optimizeSettings.vertexFetch = false; } },
+            { "lod count", [](CustomGem::ModelBuildSettings& s) { s.lods.pop_back(); } },
+            { "lod triangleRatio", [](CustomGem::ModelBuildSettings& s) { s.lods[1].triangleRatio = 0.125f; } },
+            { "lod maxError", [](CustomGem::ModelBuildSettings& s) { s.lods[0].maxError = 0.05f; } },
+        };
+        for (const SettingChange& change : changes)
+        {
+            CustomGem::ModelBuildSettings settings = MakeSettings();
+            change.apply(settings);
+            EXPECT_NE(Hash(mesh, settings), baseHash) << change.label;
+        }
+    }
+
+    class CustomCppToolGemMeshUtilsTest : public LeakDetectionFixture
+    {
+    protected:
+        //! Pushes the same quads through PushQuad<F> and the runtime PushQuad and compares every stream
+        template<CustomGem::Face F>
+        static void ExpectFaceMatchesRuntime(bool use16BitIndices)
+        {
+            CustomGem::MeshData fixed;
+            CustomGem::MeshData runtime;
+            fixed.use16BitIndices = use16BitIndices;
+            runtime.use16BitIndices = use16BitIndices;
+
+            const AZ::Vector3 corners[] = { AZ::Vector3(0.0f), AZ::Vector3(-2.5f, 1.0f, 7.25f), AZ::Vector3(100.0f, -0.5f, 3.0f) };
+            const CustomGem::UVIndex uvs[] = { { 1, 0 }, { 4, 5 }, { 16, 255 } };
+            for (size_t i = 0; i < AZStd::size(corners); ++i)
+            {
+                const float width = 1.0f + static_cast<float>(i);
+                const float height = 0.5f * static_cast<float>(i + 1);
+                CustomGem::MeshUtils::PushQuad<F>(fixed, corners[i], uvs[i], width, height);
+                CustomGem::MeshUtils::PushQuad(runtime, corners[i], static_cast<int>(F), uvs[i], width, height);
+            }
+
+            const int face = static_cast<int>(F);
+            EXPECT_EQ(fixed.use16BitIndices, runtime.use16BitIndices) << "face " << face;
+            EXPECT_EQ(fixed.indices, runtime.indices) << "face " << face;
+            EXPECT_EQ(fixed.indices16, runtime.indices16) << "face " << face;
+            EXPECT_EQ(fixed.positions, runtime.positions) << "face " << face;
+            EXPECT_EQ(fixed.normals, runtime.normals) << "face " << face;
+            EXPECT_EQ(fixed.tangents, runtime.tangents) << "face " << face;
+            EXPECT_EQ(fixed.bitangents, runtime.bitangents) << "face " << face;
+            EXPECT_EQ(fixed.uvs, runtime.uvs) << "face " << face;
+        }
+
+        static void ExpectAllFacesMatchRuntime(bool use16BitIndices)
+        {
+            ExpectFaceMatchesRuntime<CustomGem::Face::PosZ>(use16BitIndices);
+            ExpectFaceMatchesRuntime<CustomGem::Face::NegZ>(use16BitIndices);
+            ExpectFaceMatchesRuntime<CustomGem::Face::NegX>(use16BitIndices);
+            ExpectFaceMatchesRuntime<CustomGem::Face::PosX>(use16BitIndices);
+            ExpectFaceMatchesRuntime<CustomGem::Face::PosY>(use16BitIndices);
+            ExpectFaceMatchesRuntime<CustomGem::Face::NegY>(use16BitIndices);
+        }
+    };
+
+    TEST_F(CustomCppToolGemMeshUtilsTest, PushQuadFace_AllFaces_MatchesRuntimePushQuad)
+    {
+        ExpectAllFacesMatchRuntime(false);
+    }
+
+    TEST_F(CustomCppToolGemMeshUtilsTest, PushQuadFace_AllFaces16BitIndices_MatchesRuntimePushQuad)
+    {
+        ExpectAllFacesMatchRuntime(true);
+    }
+
+    class CustomCppToolGemQuadBatchTest : public LeakDetectionFixture
+    {
+    protected:
+        template<class T>
+        static bool SameBytes(const AZStd::vector<T>& left, const AZStd::vector<T>& right)
+        {
+            return left.size() == right.size() && (left.empty() || memcmp(left.data(), right.data(), left.size() * sizeof(T)) == 0);
+        }
+
+        //! Emits a batch and pushes the same quads one by one through PushQuad, and compares the streams byte by byte
+        static void ExpectSameAsPushQuad(bool use16BitIndices)
+        {
+            // Every face with mixed sizes, tiles and signed zero corners
+            constexpr size_t QuadCount = 37;
+            AZStd::vector<float> corners;
+            AZStd::vector<CustomGem::Face> faces;
+            AZStd::vector<CustomGem::UVIndex> tiles;
+            AZStd::vector<float> sizes;
+            for (size_t i = 0; i < QuadCount; ++i)
+            {
+                const float x = (i % 3 == 0) ? -0.0f : static_cast<float>(i) * 0.75f;
+                corners.insert(corners.end(), { x, -static_cast<float>(i), 1.0f / static_cast<float>(i + 1) });
+                faces.push_back(static_cast<CustomGem::Face>(i % CustomGem::FaceCount));
+                tiles.push_back({ 4, static_cast<int>(i % 16) });
+                sizes.insert(sizes.end(), { 1.0f + static_cast<float>(i % 5), 0.25f * static_cast<float>(i % 7 + 1) });
+            }
+
+            CustomGem::QuadBatch batch;
+            batch.corners = corners;
+            batch.faces = faces;
+            batch.tiles = tiles;
+            batch.sizes = sizes;
+
+            CustomGem::MeshData pushed;
+            CustomGem::MeshData emitted;
+            pushed.use16BitIndices = use16BitIndices;
+            emitted.use16BitIndices = use16BitIndices;
+            // A first batch offsets the vertex base of the second one
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                for (size_t i = 0; i < QuadCount; ++i)
+                {
+                    CustomGem::MeshUtils::PushQuad(pushed, AZ::Vector3(corners[i * 3], corners[i * 3 + 1], corners[i * 3 + 2]),
+                        static_cast<int>(faces[i]), tiles[i], sizes[i * 2], sizes[i * 2 + 1]);
+                }
+                CustomGem::QuadBatchEmitter::Emit(emitted, batch);
+            }
+
+            EXPECT_TRUE(SameBytes(pushed.indices, emitted.indices));
+            EXPECT_TRUE(SameBytes(pushed.indices16, emitted.indices16));
+            EXPECT_TRUE(SameBytes(pushed.positions, emitted.positions));
+            EXPECT_TRUE(SameBytes(pushed.normals, emitted.normals));
+            EXPECT_TRUE(SameBytes(pushed.tangents, emitted.tangents));
+            EXPECT_TRUE(SameBytes(pushed.bitangents, emitted.bitangents));
+            EXPECT_TRUE(SameBytes(pushed.uvs, emitted.uvs));
+        }
+    };
+
+    TEST_F(CustomCppToolGemQuadBatchTest, Emit_MatchesPushQuadBytes)
+    {
+        ExpectSameAsPushQuad(false);
+        ExpectSameAsPushQuad(true);
+    }
+
+    class CustomCppToolGemMeshStatisticsTest : public LeakDetectionFixture
+    {
+    protected:
+        //! Vertices spread over a few thousand units, with NaN and infinities sprinkled over every
+        //! stream. The count is not a multiple of any kernel width, so the scalar tails run too.
+        static CustomGem::MeshData MakeMesh()
+        {
+            constexpr uint32_t VertexCount = 1001;
+            CustomGem::MeshData mesh;
+            for (uint32_t i = 0; i < VertexCount; ++i)
+            {
+                const float t = static_cast<float>(i);
+                CustomGem::MeshUtils::PushVertex(mesh, AZ::Vector3(std::sin(t) * 2000.0f, t * 0.5f - 100.0f, -std::cos(t * 0.3f) * 750.0f),
+                    AZ::Vector3::CreateAxisZ(), AZ::Vector3::CreateAxisX(), AZ::Vector3::CreateAxisY(), t / VertexCount, 1.0f - t / VertexCount);
+                mesh.indices.push_back((i * 7919u) % VertexCount);
+            }
+
+            const float nan = std::numeric_limits<float>::quiet_NaN();
+            const float inf = std::numeric_limits<float>::infinity();
+            mesh.positions[4] = nan;
+            mesh.positions[301] = inf;
+            mesh.positions[302] = -inf;
+            mesh.positions[mesh.positions.size() - 1] = nan;
+            mesh.normals[17] = inf;
+            mesh.tangents[mesh.tangents.size() - 2] = nan;
+            mesh.bitangents[0] = -inf;
+            mesh.uvs[999] = nan;
+            return mesh;
+        }
+
+        //! Plain loops over the same streams
+        static CustomGem::MeshStreamStats ComputeReference(const CustomGem::MeshStreams& mesh)
+        {
+            CustomGem::MeshStreamStats stats;
+            stats.vertexCount = mesh.positions.size() / 3;
+            stats.indexCount = mesh.indices.size() + mesh.indices16.size();
+            for (size_t i = 0; i < mesh.positions.size(); ++i)
+            {
+                const float value = mesh.positions[i];
+                if (!std::isfinite(value))
+                {
+                    ++stats.nonFinitePositions;
+                    continue;
+                }
+                stats.boundsMin[i % 3] = AZStd::min(stats.boundsMin[i % 3], value);
+                stats.boundsMax[i % 3] = AZStd::max(stats.boundsMax[i % 3], value);
+            }
+            for (AZStd::span<const float> stream : { mesh.normals, mesh.tangents, mesh.bitangents, mesh.uvs })
+            {
+                for (float value : stream)
+                {
+                    stats.nonFiniteAttributes += std::isfinite(value) ? 0 : 1;
+                }
+            }
+            for (uint32_t index : mesh.indices)
+            {
+                stats.maxIndex = AZStd::max(stats.maxIndex, index);
+            }
+            for (uint16_t index : mesh.indices16)
+            {
+                stats.maxIndex = AZStd::max(stats.maxIndex, static_cast<uint32_t>(index));
+            }
+            return stats;
+        }
+
+        static void ExpectSameStats(const CustomGem::MeshStreamStats& expected, const CustomGem::MeshStreamStats& actual, const char* label)
+        {
+            EXPECT_EQ(actual.vertexCount, expected.vertexCount) << label;
+            EXPECT_EQ(actual.indexCount, expected.indexCount) << label;
+            EXPECT_EQ(actual.nonFinitePositions, expected.nonFinitePositions) << label;
+            EXPECT_EQ(actual.nonFiniteAttributes, expected.nonFiniteAttributes) << label;
+            EXPECT_EQ(actual.maxIndex, expected.maxIndex) << label;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                EXPECT_EQ(actual.boundsMin[axis], expected.boundsMin[axis]) << label << " axis " << axis;
+                EXPECT_EQ(actual.boundsMax[axis], expected.boundsMax[axis]) << label << " axis " << axis;
+            }
+            EXPECT_EQ(actual.HasValidIndices(), expected.HasValidIndices()) << label;
+        }
+
+        static constexpr CustomGem::SimdLevel Levels[] = {
+            CustomGem::SimdLevel::Scalar, CustomGem::SimdLevel::Sse2, CustomGem::SimdLevel::Avx2, CustomGem::SimdLevel::Neon
+        };
+    };
+
+    TEST_F(CustomCppToolGemMeshStatisticsTest, Compute_AllLevels_MatchesScalarReference)
+    {
+        const CustomGem::MeshData mesh = MakeMesh();
+        const CustomGem::MeshStreamStats expected = ComputeReference(mesh.GetStreams());
+        EXPECT_EQ(expected.nonFinitePositions, 4u);
+        EXPECT_EQ(expected.nonFiniteAttributes, 4u);
+        EXPECT_EQ(expected.maxIndex, 1000u);
+
+        for (CustomGem::SimdLevel level : Levels)
+        {
+            CustomGem::MeshStatisticsSettings settings;
+            settings.level = level;
+            settings.verticesPerJob = 0;
+            ExpectSameStats(expected, CustomGem::MeshStatistics::Compute(mesh.GetStreams(), settings),
+                CustomGem::GetSimdLevelName(CustomGem::ClampSimdLevel(level)));
+            EXPECT_EQ(CustomGem::MeshStatistics::ComputeMaxIndex(mesh.GetStreams(), level), expected.maxIndex);
+        }
+    }
+
+    TEST_F(CustomCppToolGemMeshStatisticsTest, Compute_Aabb_MatchesScalarReference)
+    {
+        const CustomGem::MeshData mesh = MakeMesh();
+        const AZ::Aabb expected = ComputeReference(mesh.GetStreams()).GetAabb();
+        ASSERT_TRUE(expected.IsValid());
+
+        for (CustomGem::SimdLevel level : Levels)
+        {
+            CustomGem::MeshStatisticsSettings settings;
+            settings.level = level;
+            settings.verticesPerJob = 0;
+            const AZ::Aabb aabb = CustomGem::MeshStatistics::Compute(mesh.GetStreams(), settings).GetAabb();
+            EXPECT_TRUE(aabb.GetMin() == expected.GetMin()) << CustomGem::GetSimdLevelName(CustomGem::ClampSimdLevel(level));
+            EXPECT_TRUE(aabb.GetMax() == expected.GetMax()) << CustomGem::GetSimdLevelName(CustomGem::ClampSimdLevel(level));
+        }
+    }
+
+    TEST_F(CustomCppToolGemMeshStatisticsTest, Compute_IndexPastLastVertex_IsInvalid)
+    {
+        CustomGem::MeshData mesh = MakeMesh();
+        mesh.indices[500] = static_cast<uint32_t>(mesh.GetVertexCount());
+
+        const CustomGem::MeshStreamStats stats = CustomGem::MeshStatistics::Compute(mesh.GetStreams());
+        EXPECT_EQ(stats.maxIndex, mesh.GetVertexCount());
+        EXPECT_FALSE(stats.HasValidIndices());
+        EXPECT_FALSE(stats.IsValid());
+    }
+
+    TEST_F(CustomCppToolGemMeshStatisticsTest, Compute_16BitIndices_ReportsMaxIndex)
+    {
+        CustomGem::MeshData mesh = MakeMesh();
+        mesh.use16BitIndices = true;
+        mesh.indices16.assign(mesh.indices.begin(), mesh.indices.end());
+        mesh.indices.clear();
+        mesh.indices16[123] = 0xFFFE;
+
+        for (CustomGem::SimdLevel level : Levels)
+        {
+            CustomGem::MeshStatisticsSettings settings;
+            settings.level = level;
+            settings.verticesPerJob = 0;
+            const CustomGem::MeshStreamStats stats = CustomGem::MeshStatistics::Compute(mesh.GetStreams(), settings);
+            EXPECT_EQ(stats.maxIndex, 0xFFFEu);
+            EXPECT_FALSE(stats.HasValidIndices());
+        }
+    }
+
+    //! Runs on a LocalFileIO over a temporary directory that is removed after the test
+    class CustomCppToolGemVertexCompressionTest : public LeakDetectionFixture
+    {
+    protected:
+        //! Unit directions covering every octant and the folds, then directions whose x lands exactly
+        //! halfway between two snorm16 steps, which the scalar and SIMD paths must round alike.
+        //! The count is not a multiple of four, so the scalar tail runs too.
+        static AZStd::vector<float> MakeDirections()
+        {
+            AZStd::vector<float> directions = {
+                1, 0, 0, -1, 0, 0, 0, 1, 0, 0, -1, 0, 0, 0, 1, 0, 0, -1,
+            };
+            uint32_t seed = 12345;
+            auto next = [&seed]()
+            {
+                seed = seed * 1664525u + 1013904223u;
+                return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24) * 2.0f - 1.0f;
+            };
+            for (int i = 0; i < 501; ++i)
+            {
+                const float x = next();
+                const float y = next();
+                const float z = next();
+                const float length = std::sqrt(x * x + y * y + z * z);
+                if (length > 1e-3f)
+                {
+                    directions.insert(directions.end(), { x / length, y / length, z / length });
+                }
+            }
+            for (int step = 0; step < TieCount; ++step)
+            {
+                const float x = (static_cast<float>(step * 2) + 0.5f) / 32767.0f;
+                directions.insert(directions.end(), { x, 0.0f, 1.0f - x });
+            }
+            return directions;
+        }
+
+        //! Index of the first tie direction in MakeDirections()
+        static size_t GetFirstTie(const AZStd::vector<float>& directions) { return directions.size() / 3 - TieCount; }
+
+        static AZStd::vector<float> MakeTangents(const AZStd::vector<float>& directions)
+        {
+            AZStd::vector<float> tangents;
+            for (size_t i = 0; i < directions.size() / 3; ++i)
+            {
+                tangents.insert(tangents.end(), { directions[i * 3], directions[i * 3 + 1], directions[i * 3 + 2], (i % 3 == 0) ? -1.0f : 1.0f });
+            }
+            return tangents;
+        }
+
+        static constexpr int TieCount = 8;
+    };
+
+    TEST_F(CustomCppToolGemVertexCompressionTest, EncodeOctahedral_SimdMatchesScalarBytes)
+    {
+        const AZStd::vector<float> normals = MakeDirections();
+        const AZStd::vector<float> tangents = MakeTangents(normals);
+        const size_t count = normals.size() / 3;
+
+        AZStd::vector<int16_t> scalar(count * 2);
+        AZStd::vector<int16_t> vector(count * 2);
+        CustomGem::VertexCompression::EncodeOctahedralNormals(normals, scalar, CustomGem::SimdLevel::Scalar);
+        CustomGem::VertexCompression::EncodeOctahedralNormals(normals, vector);
+        EXPECT_EQ(memcmp(scalar.data(), vector.data(), scalar.size() * sizeof(int16_t)), 0);
+
+        // Ties round to even on both paths
+        for (size_t i = GetFirstTie(normals), step = 0; i < count; ++i, ++step)
+        {
+            EXPECT_EQ(scalar[i * 2], static_cast<int16_t>(step * 2));
+        }
+
+        CustomGem::VertexCompression::EncodeOctahedralTangents(tangents, scalar, CustomGem::SimdLevel::Scalar);
+        CustomGem::VertexCompression::EncodeOctahedralTangents(tangents, vector);
+        EXPECT_EQ(memcmp(scalar.data(), vector.data(), scalar.size() * sizeof(int16_t)), 0);
+    }
+
+    TEST_F(CustomCppToolGemVertexCompressionTest, EncodeOctahedral_RoundTripsWithinError)
+    {
+        const AZStd::vector<float> normals = MakeDirections();
+        const AZStd::vector<float> tangents = MakeTangents(normals);
+        // The tie directions are not unit length
+        const size_t count = GetFirstTie(normals);
+
+        // Distance between the unit input and the decoded direction, about its angle in radians
+        auto error = [](const float* decoded, const float* expected)
+        {
+            const float dx = decoded[0] - expected[0];
+            const float dy = decoded[1] - expected[1];
+            const float dz = decoded[2] - expected[2];
+            return std::sqrt(dx * dx + dy * dy + dz * dz);
+        };
+
+        float maxNormalError = 0.0f;
+        AZStd::vector<int16_t> encoded(normals.size() / 3 * 2);
+        CustomGem::VertexCompression::EncodeOctahedralNormals(normals, encoded);
+        for (size_t i = 0; i < count; ++i)
+        {
+            float n[3];
+            CustomGem::VertexCompression::DecodeOctahedral(encoded[i * 2], encoded[i * 2 + 1], n[0], n[1], n[2]);
+            maxNormalError = AZStd::max(maxNormalError, error(n, &normals[i * 3]));
+        }
+        // Two snorm16 octahedral components resolve directions to about 0.004 degrees
+        EXPECT_LT(maxNormalError, 1e-4f);
+
+        float maxTangentError = 0.0f;
+        CustomGem::VertexCompression::EncodeOctahedralTangents(tangents, encoded);
+        for (size_t i = 0; i < count; ++i)
+        {
+            float t[4];
+            CustomGem::VertexCompression::DecodeOctahedralTangent(encoded[i * 2], encoded[i * 2 + 1], t[0], t[1], t[2], t[3]);
+            maxTangentError = AZStd::max(maxTangentError, error(t, &tangents[i * 4]));
+            EXPECT_EQ(t[3], tangents[i * 4 + 3]) << "tangent " << i;
+        }
+        // The handedness fold halves the resolution of the second component
+        EXPECT_LT(maxTangentError, 2e-4f);
+    }
+
+    TEST_F(CustomCppToolGemVertexCompressionTest, EncodeOctahedralTangents_KeepsHandednessAtFoldEdge)
+    {
+        // -Y and the lower hemisphere edge put the second octahedral component at -1, where only the
+        // epsilon of the fold keeps its sign
+        const AZStd::vector<float> tangents = {
+            0, -1, 0, -1, 0, -1, 0, 1, 1, 0, 0, -1, 0, 0, -1, -1, 0, 0, -1, 1,
+        };
+        for (CustomGem::SimdLevel level : { CustomGem::SimdLevel::Scalar, CustomGem::GetSimdLevel() })
+        {
+            AZStd::vector<int16_t> encoded(tangents.size() / 2);
+            CustomGem::VertexCompression::EncodeOctahedralTangents(tangents, encoded, level);
+            for (size_t i = 0; i < tangents.size() / 4; ++i)
+            {
+                float t[4];
+                CustomGem::VertexCompression::DecodeOctahedralTangent(encoded[i * 2], encoded[i * 2 + 1], t[0], t[1], t[2], t[3]);
+                EXPECT_EQ(t[3], tangents[i * 4 + 3]) << CustomGem::GetSimdLevelName(level) << " tangent " << i;
+                EXPECT_NEAR(t[0], tangents[i * 4], 1e-3f);
+                EXPECT_NEAR(t[1], tangents[i * 4 + 1], 1e-3f);
+                EXPECT_NEAR(t[2], tangents[i * 4 + 2], 1e-3f);
+            }
+        }
+    }
+
+    TEST_F(CustomCppToolGemVertexCompressionTest, EncodeHalfFloats_SimdMatchesScalarAndRoundTrips)
+    {
+        AZStd::vector<float> values = {
+            0.0f, -0.0f, 1.0f, -2.0f, 0.5f, 65504.0f, 65520.0f, 1e6f, -1e6f, 6.1e-5f, 3e-6f, -3e-8f,
+            std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+        };
+        for (int i = 0; i < 1001; ++i)
+        {
+            values.push_back(static_cast<float>(i) * 0.0123f - 6.0f);
+        }
+
+        AZStd::vector<uint16_t> scalar(values.size());
+        AZStd::vector<uint16_t> vector(values.size());
+        CustomGem::VertexCompression::EncodeHalfFloats(values, scalar, CustomGem::SimdLevel::Scalar);
+        CustomGem::VertexCompression::EncodeHalfFloats(values, vector);
+        EXPECT_EQ(memcmp(scalar.data(), vector.data(), scalar.size() * sizeof(uint16_t)), 0);
+
+        EXPECT_EQ(scalar[0], 0x0000);
+        EXPECT_EQ(scalar[1], 0x8000);
+        EXPECT_EQ(scalar[5], 0x7bff);
+        // Past the largest half rounds to infinity
+        EXPECT_EQ(scalar[6], 0x7c00);
+        EXPECT_EQ(scalar[7], 0x7c00);
+        EXPECT_EQ(scalar[8], 0xfc00);
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            const float decoded = CustomGem::VertexCompression::DecodeHalfFloat(scalar[i]);
+            if (std::fabs(values[i]) <= 65504.0f)
+            {
+                // Half of the 2^-10 mantissa step, or of the denormal step near zero
+                EXPECT_LE(std::fabs(decoded - values[i]), AZStd::max(std::fabs(values[i]) * 0x1p-11f, 0x1p-25f)) << values[i];
+            }
+            else
+            {
+                EXPECT_EQ(decoded, std::copysign(std::numeric_limits<float>::infinity(), values[i])) << values[i];
+            }
+        }
+    }
+
+    class CustomCppToolGemTempFileTest : public LeakDetectionFixture
+    {
+    protected:
+        void SetUp() override
+        {
+            LeakDetectionFixture::SetUp();
+            m_priorFileIO = AZ::IO::FileIOBase::GetInstance();
+            AZ::IO::FileIOBase::SetInstance(nullptr);
+            m_fileIO = AZStd::make_unique<AZ::IO::LocalFileIO>();
+            AZ::IO::FileIOBase::SetInstance(m_fileIO.get());
+        }
+
+        void TearDown() override
+        {
+            AZ::IO::FileIOBase::SetInstance(nullptr);
+            m_fileIO.reset();
+            AZ::IO::FileIOBase::SetInstance(m_priorFileIO);
+            LeakDetectionFixture::TearDown();
+        }
+
+        AZStd::string GetPath(const char* fileName) const
+        {
+            return (AZ::IO::Path(m_tempDirectory.GetDirectory()) / fileName).String();
+        }
+
+        static bool WriteFile(const AZStd::string& path, const void* data, size_t byteCount)
+        {
+            AZ::IO::FileIOBase* fileIO = AZ::IO::FileIOBase::GetInstance();
+            AZ::IO::HandleType handle = AZ::IO::InvalidHandle;
+            if (!fileIO->Open(path.c_str(), AZ::IO::OpenMode::ModeWrite | AZ::IO::OpenMode::ModeBinary, handle))
+            {
+                return false;
+            }
+            const bool written = static_cast<bool>(fileIO->Write(handle, data, byteCount));
+            fileIO->Close(handle);
+            return written;
+        }
+
+    private:
+        AZ::Test::ScopedAutoTempDirectory m_tempDirectory;
+        AZ::IO::FileIOBase* m_priorFileIO = nullptr;
+        AZStd::unique_ptr<AZ::IO::FileIOBase> m_fileIO;
+    };
+
+    class CustomCppToolGemMeshFileTest : public CustomCppToolGemTempFileTest
+    {
+    protected:
+        //! A few thousand quads; with 16-bit indices only indices16 is filled, otherwise only indices
+        static CustomGem::MeshData MakeMesh(bool use16BitIndices)
+        {
+            CustomGem::MeshData mesh;
+            mesh.use16BitIndices = use16BitIndices;
+            for (int i = 0; i < 3000; ++i)
+            {
+                CustomGem::MeshUtils::PushQuad(mesh, AZ::Vector3(static_cast<float>(i % 50), static_cast<float>(i / 50), 0.0f),
+                    i % CustomGem::FaceCount, { 4, i % 16 }, 1.0f, 1.0f);
+            }
+            return mesh;
+        }
+
+        static void ExpectSameMesh(const CustomGem::MeshData& expected, const CustomGem::MeshData& actual)
+        {
+            EXPECT_EQ(actual.use16BitIndices, expected.use16BitIndices);
+            EXPECT_EQ(actual.indices, expected.indices);
+            EXPECT_EQ(actual.indices16, expected.indices16);
+            EXPECT_EQ(actual.positions, expected.positions);
+            EXPECT_EQ(actual.normals, expected.normals);
+            EXPECT_EQ(actual.tangents, expected.tangents);
+            EXPECT_EQ(actual.bitangents, expected.bitangents);
+            EXPECT_EQ(actual.uvs, expected.uvs);
+        }
+
+        //! Rewrites the file at path with only its first byteCount bytes, or with byte offset xor'ed
+        static bool RewriteFile(const AZStd::string& path, size_t byteCount, size_t corruptOffset = SIZE_MAX)
+        {
+            AZ::IO::FileIOBase* fileIO = AZ::IO::FileIOBase::GetInstance();
+            AZ::u64 size = 0;
+            AZ::IO::HandleType handle = AZ::IO::InvalidHandle;
+            if (!fileIO->Size(path.c_str(), size) || !fileIO->Open(path.c_str(), AZ::IO::OpenMode::ModeRead | AZ::IO::OpenMode::ModeBinary, handle))
+            {
+                return false;
+            }
+            AZStd::vector<uint8_t> bytes(static_cast<size_t>(size));
+            const bool read = static_cast<bool>(fileIO->Read(handle, bytes.data(), bytes.size(), true));
+            fileIO->Close(handle);
+            if (!read)
+            {
+                return false;
+            }
+
+            bytes.resize(AZStd::min(bytes.size(), byteCount));
+            if (corruptOffset < bytes.size())
+            {
+                bytes[corruptOffset] ^= 0x5A;
+            }
+            return WriteFile(path, bytes.data(), bytes.size());
+        }
+    };
+
+    TEST_F(CustomCppToolGemMeshFileTest, WriteOpen_EveryCompressionAndIndexWidth_RoundTrips)
+    {
+        for (CustomGem::MeshFileCompression compression : { CustomGem::MeshFileCompression::None, CustomGem::MeshFileCompression::ZLib })
+        {
+            for (bool use16BitIndices : { false, true })
+            {
+                const CustomGem::MeshData mesh = MakeMesh(use16BitIndices);
+                CustomGem::MeshFileWriteSettings settings;
+                settings.compression = compression;
+                // Compress every stream, including the empty index stream of the other width
+                settings.minCompressBytes = 0;
+                settings.generatorVersion = 7;
+                settings.key = 0x1234567890ABCDEFull;
+
+                const AZStd::string path = GetPath("RoundTrip.mesh");
+                ASSERT_GT(CustomGem::MeshFile::Write(path.c_str(), mesh, settings), 0u);
+
+                CustomGem::MappedMeshFile file;
+                ASSERT_TRUE(file.Open(path.c_str()));
+                EXPECT_EQ(file.GetHeader().key, settings.key);
+                EXPECT_EQ(file.GetHeader().generatorVersion, settings.generatorVersion);
+                EXPECT_EQ(file.Uses16BitIndices(), use16BitIndices);
+                for (const CustomGem::MeshFileStream& stream : file.GetHeader().streams)
+                {
+                    const bool compressed = compression == CustomGem::MeshFileCompression::ZLib && stream.elementCount > 0;
+                    EXPECT_EQ(stream.compression == CustomGem::MeshFileCompression::ZLib, compressed);
+                }
+
+                CustomGem::MeshData loaded;
+                file.CopyTo(loaded);
+                ExpectSameMesh(mesh, loaded);
+            }
+        }
+    }
+
+    TEST_F(CustomCppToolGemMeshFileTest, Write_EmptyMeshWithZLib_Succeeds)
+    {
+        CustomGem::MeshFileWriteSettings settings;
+        settings.compression = CustomGem::MeshFileCompression::ZLib;
+        settings.minCompressBytes = 0;
+        const AZStd::string path = GetPath("Empty.mesh");
+        EXPECT_GT(CustomGem::MeshFile::Write(path.c_str(), CustomGem::MeshData(), settings), 0u);
+
+        CustomGem::MappedMeshFile file;
+        ASSERT_TRUE(file.Open(path.c_str()));
+        EXPECT_TRUE(file.GetStreams().positions.empty());
+    }
+
+    TEST_F(CustomCppToolGemMeshFileTest, Open_TruncatedFile_Fails)
+    {
+        for (CustomGem::MeshFileCompression compression : { CustomGem::MeshFileCompression::None, CustomGem::MeshFileCompression::ZLib })
+        {
+            CustomGem::MeshFileWriteSettings settings;
+            settings.compression = compression;
+            settings.minCompressBytes = 0;
+            const AZStd::string path = GetPath("Truncated.mesh");
+            const uint64_t bytes = CustomGem::MeshFile::Write(path.c_str(), MakeMesh(false), settings);
+            ASSERT_GT(bytes, 0u);
+
+            // Cut into the last stream, then into the header
+            for (uint64_t keep : { bytes - 5, static_cast<uint64_t>(sizeof(CustomGem::MeshFileHeader) - 8) })
+            {
+                ASSERT_TRUE(RewriteFile(path, static_cast<size_t>(keep)));
+                CustomGem::MappedMeshFile file;
+                EXPECT_FALSE(file.Open(path.c_str())) << "kept " << keep << " bytes";
+                EXPECT_FALSE(file.IsOpen());
+            }
+        }
+    }
+
+    TEST_F(CustomCppToolGemMeshFileTest, Open_CorruptFile_Fails)
+    {
+        CustomGem::MeshFileWriteSettings settings;
+        settings.compression = CustomGem::MeshFileCompression::ZLib;
+        settings.minCompressBytes = 0;
+        const AZStd::string path = GetPath("Corrupt.mesh");
+        const CustomGem::MeshData mesh = MakeMesh(false);
+
+        // The magic, the element size of the positions and the first block header of the positions
+        CustomGem::MeshFileHeader header;
+        ASSERT_GT(CustomGem::MeshFile::Write(path.c_str(), mesh, settings), 0u);
+        ASSERT_TRUE(CustomGem::MeshFile::ReadHeader(path.c_str(), header));
+        const size_t positions = offsetof(CustomGem::MeshFileHeader, streams) + 2 * sizeof(CustomGem::MeshFileStream);
+        const size_t offsets[] = {
+            offsetof(CustomGem::MeshFileHeader, magic),
+            positions + offsetof(CustomGem::MeshFileStream, elementSize),
+            static_cast<size_t>(header.streams[2].offset) + 1,
+        };
+
+        for (size_t offset : offsets)
+        {
+            ASSERT_GT(CustomGem::MeshFile::Write(path.c_str(), mesh, settings), 0u);
+            ASSERT_TRUE(RewriteFile(path, SIZE_MAX, offset));
+            CustomGem::MappedMeshFile file;
+            EXPECT_FALSE(file.Open(path.c_str())) << "corrupted byte " << offset;
+            EXPECT_FALSE(file.IsOpen());
+        }
+    }
+
+    class CustomCppToolGemMeshImporterTest : public CustomCppToolGemTempFileTest
+    {
+    protected:
+        bool Import(const char* fileName, AZStd::string_view contents, CustomGem::MeshData& mesh)
+        {
+            const AZStd::string path = GetPath(fileName);
+            if (!WriteFile(path, contents.data(), contents.size()))
+            {
+                return false;
+            }
+            CustomGem::MeshImportSettings settings;
+            settings.generateTangents = false;
+            return CustomGem::MeshImporter::Import(path.c_str(), mesh, settings);
+        }
+
+        static AZStd::vector<uint32_t> GetIndices(const CustomGem::MeshData& mesh)
+        {
+            AZStd::vector<uint32_t> indices(mesh.indices.begin(), mesh.indices.end());
+            indices.insert(indices.end(), mesh.indices16.begin(), mesh.indices16.end());
+            return indices;
+        }
+
+        //! Binary PLY with the unit triangle, its face list counted by countType holding count
+        template<typename Count>
+        static AZStd::string MakeBinaryPly(bool bigEndian, const char* countType, Count count)
+        {
+            AZStd::string ply = AZStd::string::format(
+                "ply\nformat %s 1.0\nelement vertex 3\nproperty float x\nproperty float y\nproperty float z\n"
+                "property uchar red\nelement face 1\nproperty list %s uint vertex_indices\nend_header\n",
+                bigEndian ? "binary_big_endian" : "binary_little_endian", countType);
+            auto append = [&ply, bigEndian](const auto& value)
+            {
+                char bytes[sizeof(value)];
+                memcpy(bytes, &value, sizeof(value));
+                for (size_t i = 0; i < sizeof(value); ++i)
+                {
+                    ply.push_back(bytes[bigEndian ? sizeof(value) - 1 - i : i]);
+                }
+            };
+            const float positions[] = { 0.0f, 0.0f, 0.0f, 2.0f, 0.0f, 0.0f, 0.0f, 2.0f, 0.0f };
+            for (int vertex = 0; vertex < 3; ++vertex)
+            {
+                append(positions[vertex * 3 + 0]);
+                append(positions[vertex * 3 + 1]);
+                append(positions[vertex * 3 + 2]);
+                append(uint8_t{ 7 });
+            }
+            append(count);
+            for (uint32_t index = 0; index < 3; ++index)
+            {
+                append(index);
+            }
+            return ply;
+        }
+    };
+
+    TEST_F(CustomCppToolGemMeshImporterTest, Obj_QuadAndNegativeIndices_FansAndSharesVertices)
+    {
+        constexpr const char* Obj =
+            "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+            "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+            "vn 0 0 1\n"
+            "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+            "f -4/-4/-1 -2/-2/-1 -1/-1/-1\n";
+        CustomGem::MeshData mesh;
+        ASSERT_TRUE(Import("Quad.obj", Obj, mesh));
+
+        // The relative face reuses corners 1, 3 and 4 of the quad
+        EXPECT_EQ(mesh.GetVertexCount(), 4u);
+        EXPECT_EQ(GetIndices(mesh), (AZStd::vector<uint32_t>{ 0, 1, 2, 0, 2, 3, 0, 2, 3 }));
+        EXPECT_EQ(mesh.positions, (AZStd::vector<float>{ 0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0 }));
+        EXPECT_EQ(mesh.uvs.size(), 8u);
+        EXPECT_EQ(mesh.normals, (AZStd::vector<float>{ 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1 }));
+    }
+
+    TEST_F(CustomCppToolGemMeshImporterTest, Obj_PolygonWithManyCorners_IsFannedWhole)
+    {
+        // 100 corners, past any fixed corner limit
+        AZStd::string obj;
+        AZStd::string face = "f";
+        for (int i = 0; i < 100; ++i)
+        {
+            const float angle = 6.2831853f * static_cast<float>(i) / 100.0f;
+            obj += AZStd::string::format("v %f %f 0\n", std::cos(angle), std::sin(angle));
+            face += AZStd::string::format(" %d", i + 1);
+        }
+        obj += face + "\n";
+
+        CustomGem::MeshData mesh;
+        ASSERT_TRUE(Import("Polygon.obj", obj, mesh));
+        EXPECT_EQ(mesh.GetVertexCount(), 100u);
+        EXPECT_EQ(mesh.GetIndexCount(), 98u * 3);
+    }
+
+    TEST_F(CustomCppToolGemMeshImporterTest, Obj_IndexPastLastVertex_Fails)
+    {
+        CustomGem::MeshData mesh;
+        EXPECT_FALSE(Import("BadIndex.obj", "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 4\n", mesh));
+        EXPECT_FALSE(Import("BadIndex.obj", "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 -4\n", mesh));
+        EXPECT_EQ(mesh.GetVertexCount(), 0u);
+    }
+
+    TEST_F(CustomCppToolGemMeshImporterTest, Obj_MalformedFaces_AreSkipped)
+    {
+        constexpr const char* Obj =
+            "v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+            "f 1 x 3\n"   // not an index
+            "f 0 1 2\n"   // OBJ indices start at 1
+            "f 1 2 3\n";
+        CustomGem::MeshData mesh;
+        ASSERT_TRUE(Import("Malformed.obj", Obj, mesh));
+        EXPECT_EQ(GetIndices(mesh), (AZStd::vector<uint32_t>{ 0, 1, 2 }));
+    }
+
+    TEST_F(CustomCppToolGemMeshImporterTest, Ply_Ascii_ReadsVerticesUvsAndFaces)
+    {
+        constexpr const char* Ply =
+            "ply\nformat ascii 1.0\ncomment quad\nelement vertex 4\n"
+            "property float x\nproperty float y\nproperty float z\nproperty float s\nproperty float t\n"
+            "element face 1\nproperty list uchar int vertex_indices\nend_header\n"
+            "0 0 0 0 0\n1 0 0 1 0\n1 1 0 1 1\n0 1 0 0 1\n4 0 1 2 3\n";
+        CustomGem::MeshData mesh;
+        ASSERT_TRUE(Import("Quad.ply", Ply, mesh));
+        EXPECT_EQ(mesh.positions, (AZStd::vector<float>{ 0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0 }));
+        EXPECT_EQ(mesh.uvs, (AZStd::vector<float>{ 0, 0, 1, 0, 1, 1, 0, 1 }));
+        EXPECT_EQ(GetIndices(mesh), (AZStd::vector<uint32_t>{ 0, 1, 2, 0, 2, 3 }));
+    }
+
+    TEST_F(CustomCppToolGemMeshImporterTest, Ply_BinaryLittleAndBigEndian_ReadSameTriangle)
+    {
+        for (bool bigEndian : { false, true })
+        {
+            const AZStd::string ply = MakeBinaryPly(bigEndian, "uchar", uint8_t{ 3 });
+            CustomGem::MeshData mesh;
+            ASSERT_TRUE(Import("Triangle.ply", ply, mesh)) << (bigEndian ? "big endian" : "little endian");
+            EXPECT_EQ(mesh.positions, (AZStd::vector<float>{ 0, 0, 0, 2, 0, 0, 0, 2, 0 }));
+            EXPECT_EQ(GetIndices(mesh), (AZStd::vector<uint32_t>{ 0, 1, 2 }));
+        }
+    }
+
+    TEST_F(CustomCppToolGemMeshImporterTest, Ply_TruncatedOrNegativeListCount_Fails)
+    {
+        CustomGem::MeshData mesh;
+        const AZStd::string truncated = MakeBinaryPly(false, "uchar", uint8_t{ 3 });
+        EXPECT_FALSE(Import("Truncated.ply", truncated.substr(0, truncated.size() - 3), mesh));
+
+        // Binary records have no line breaks to resync on, so a bad count fails the import
+        EXPECT_FALSE(Import("NegativeCount.ply", MakeBinaryPly(false, "char", int8_t{ -1 }), mesh));
+        EXPECT_FALSE(Import("NegativeCount.ply", MakeBinaryPly(true, "int", int32_t{ -3 }), mesh));
+        EXPECT_FALSE(Import("NoVertices.ply", "ply\nformat ascii 1.0\nend_header\n", mesh));
+        EXPECT_EQ(mesh.GetVertexCount(), 0u);
+    }
+
+    TEST_F(CustomCppToolGemMeshImporterTest, Ply_AsciiMalformedFaces_AreSkipped)
+    {
+        constexpr const char* Ply =
+            "ply\nformat ascii 1.0\nelement vertex 3\nproperty float x\nproperty float y\nproperty float z\n"
+            "element face 3\nproperty list char int vertex_indices\nend_header\n0 0 0\n1 0 0\n0 1 0\n"
+            "-1 0 1 2\n"  // negative count
+            "3 0 1 3\n"   // index past the last vertex
+            "3 0 1 2\n";
+        CustomGem::MeshData mesh;
+        ASSERT_TRUE(Import("Malformed.ply", Ply, mesh));
+        EXPECT_EQ(mesh.GetVertexCount(), 3u);
+        EXPECT_EQ(GetIndices(mesh), (AZStd::vector<uint32_t>{ 0, 1, 2 }));
+    }
+
+    class CustomCppToolGemGenerationSchedulerTest : public LeakDetectionFixture
+    {
+    protected:
+        //! Step that records its tag and finishes
+        CustomGem::GenerationStep Record(int tag)
+        {
+            return [this, tag]()
+            {
+                m_order.push_back(tag);
+                return CustomGem::GenerationStepResult::Done;
+            };
+        }
+
+        //! Never enough budget to finish a second step
+        static constexpr float TinyBudget = 0.001f;
+        static constexpr float LargeBudget = 60000.0f;
+
+        CustomCppToolGem::GenerationScheduler m_scheduler;
+        AZStd::vector<int> m_order;
+    };
+
+    TEST_F(CustomCppToolGemGenerationSchedulerTest, Run_LowestPriorityFirst)
+    {
+        m_scheduler.Queue(Record(3), 3.0f);
+        m_scheduler.Queue(Record(1), 1.0f);
+        m_scheduler.Queue(Record(2), 2.0f);
+        m_scheduler.Queue(Record(0), -1.0f);
+        m_scheduler.Run(LargeBudget);
+        EXPECT_EQ(m_order, (AZStd::vector<int>{ 0, 1, 2, 3 }));
+        EXPECT_EQ(m_scheduler.GetStats().queueDepth, 0u);
+        EXPECT_EQ(m_scheduler.GetStats().lastSteps, 4u);
+    }
+
+    TEST_F(CustomCppToolGemGenerationSchedulerTest, Run_SamePriority_OldestFirst)
+    {
+        for (int tag = 0; tag < 5; ++tag)
+        {
+            m_scheduler.Queue(Record(tag), 1.0f);
+        }
+        m_scheduler.Queue(Record(-1), 0.0f);
+
+        // One step per Run() keeps the order across calls as well
+        for (int run = 0; run < 6; ++run)
+        {
+            m_scheduler.Run(TinyBudget);
+        }
+        EXPECT_EQ(m_order, (AZStd::vector<int>{ -1, 0, 1, 2, 3, 4 }));
+    }
+
+    TEST_F(CustomCppToolGemGenerationSchedulerTest, Run_Continue_StepsTaskUntilDone)
+    {
+        int remaining = 5;
+        m_scheduler.Queue([&remaining]()
+            {
+                return --remaining > 0 ? CustomGem::GenerationStepResult::Continue : CustomGem::GenerationStepResult::Done;
+            }, 0.0f);
+        m_scheduler.Queue(Record(1), 1.0f);
+        m_scheduler.Run(LargeBudget);
+        EXPECT_EQ(remaining, 0);
+        EXPECT_EQ(m_order, (AZStd::vector<int>{ 1 }));
+        EXPECT_EQ(m_scheduler.GetStats().lastSteps, 6u);
+    }
+
+    TEST_F(CustomCppToolGemGenerationSchedulerTest, Run_Wait_RetriesOnNextRunAndLetsOthersRun)
+    {
+        int calls = 0;
+        m_scheduler.Queue([&calls]()
+            {
+                return ++calls < 3 ? CustomGem::GenerationStepResult::Wait : CustomGem::GenerationStepResult::Done;
+            }, 0.0f);
+        m_scheduler.Queue(Record(1), 1.0f);
+
+        m_scheduler.Run(LargeBudget);
+        EXPECT_EQ(calls, 1);
+        EXPECT_EQ(m_order, (AZStd::vector<int>{ 1 }));
+        EXPECT_EQ(m_scheduler.GetStats().queueDepth, 1u);
+
+        m_scheduler.Run(LargeBudget);
+        EXPECT_EQ(calls, 2);
+        EXPECT_EQ(m_scheduler.GetStats().queueDepth, 1u);
+
+        m_scheduler.Run(LargeBudget);
+        EXPECT_EQ(calls, 3);
+        EXPECT_EQ(m_scheduler.GetStats().queueDepth, 0u);
+    }
+
+    TEST_F(CustomCppToolGemGenerationSchedulerTest, Cancel_FromStepDuringRun_SkipsTask)
+    {
+        CustomGem::GenerationTaskId later = CustomGem::InvalidGenerationTaskId;
+        int selfSteps = 0;
+        CustomGem::GenerationTaskId self = CustomGem::InvalidGenerationTaskId;
+        m_scheduler.Queue([&]()
+            {
+                EXPECT_TRUE(m_scheduler.Cancel(later));
+                EXPECT_FALSE(m_scheduler.Cancel(later));
+                return CustomGem::GenerationStepResult::Done;
+            }, 0.0f);
+        self = m_scheduler.Queue([&]()
+            {
+                // Canceling itself ends the task after this step
+                ++selfSteps;
+                m_scheduler.Cancel(self);
+                return CustomGem::GenerationStepResult::Continue;
+            }, 1.0f);
+        later = m_scheduler.Queue(Record(2), 2.0f);
+        m_scheduler.Queue(Record(3), 3.0f);
+
+        m_scheduler.Run(LargeBudget);
+        EXPECT_EQ(selfSteps, 1);
+        EXPECT_EQ(m_order, (AZStd::vector<int>{ 3 }));
+        EXPECT_EQ(m_scheduler.GetStats().queueDepth, 0u);
+        EXPECT_FALSE(m_scheduler.Cancel(self));
+    }
+
+    TEST_F(CustomCppToolGemGenerationSchedulerTest, SetPriority_FromStepDuringRun_AppliesOnNextRun)
+    {
+        bool waited[2] = {};
+        auto waitOnce = [this, &waited](int tag)
+        {
+            return [this, &waited, tag]()
+            {
+                if (!waited[tag])
+                {
+                    waited[tag] = true;
+                    return CustomGem::GenerationStepResult::Wait;
+                }
+                m_order.push_back(tag);
+                return CustomGem::GenerationStepResult::Done;
+            };
+        };
+        m_scheduler.Queue(waitOnce(0), 1.0f);
+        const CustomGem::GenerationTaskId second = m_scheduler.Queue(waitOnce(1), 2.0f);
+        m_scheduler.Queue([this, second]()
+            {
+                m_scheduler.SetPriority(second, 0.0f);
+                // Queued from a step, it runs on the next Run() after the tasks handed back
+                m_scheduler.Queue(Record(2), 0.0f);
+                return CustomGem::GenerationStepResult::Done;
+            }, 3.0f);
+
+        m_scheduler.Run(LargeBudget);
+        EXPECT_TRUE(m_order.empty());
+        EXPECT_EQ(m_scheduler.GetStats().queueDepth, 3u);
+
+        m_scheduler.Run(LargeBudget);
+        EXPECT_EQ(m_order, (AZStd::vector<int>{ 1, 2, 0 }));
+    }
+
+    TEST_F(CustomCppToolGemGenerationSchedulerTest, Run_PastBudget_CountsOverrun)
+    {
+        int steps = 0;
+        m_scheduler.Queue([&steps]()
+            {
+                ++steps;
+                AZStd::this_thread::sleep_for(AZStd::chrono::milliseconds(2));
+                return CustomGem::GenerationStepResult::Continue;
+            }, 0.0f);
+
+        // A budget smaller than any step still runs one step, and counts the call as an overrun
+        m_scheduler.Run(TinyBudget);
+        EXPECT_EQ(steps, 1);
+        EXPECT_EQ(m_scheduler.GetStats().lastSteps, 1u);
+        EXPECT_EQ(m_scheduler.GetStats().overruns, 1u);
+        EXPECT_GE(m_scheduler.GetStats().lastMilliseconds, 2.0f);
+
+        m_scheduler.Run(TinyBudget);
+        EXPECT_EQ(m_scheduler.GetStats().overruns, 2u);
+        EXPECT_EQ(m_scheduler.GetStats().totalSteps, 2u);
+
+        // Nothing to run is not an overrun
+        m_scheduler.Clear();
+        m_scheduler.Run(TinyBudget);
+        EXPECT_EQ(m_scheduler.GetStats().lastSteps, 0u);
+        EXPECT_EQ(m_scheduler.GetStats().overruns, 2u);
+        EXPECT_EQ(m_scheduler.GetStats().queueDepth, 0u);
+    }
+} // namespace UnitTest
 
 AZ_UNIT_TEST_HOOK(DEFAULT_UNIT_TEST_ENV);
@@ -1,4 +1,419 @@
 
 #include <AzTest/AzTest.h>
 
+#if defined(HAVE_BENCHMARK)
+#include <benchmark/benchmark.h>
+
+#include <AzCore/Asset/AssetManager.h>
+#include <AzCore/Debug/AllocationRecords.h>
+#include <AzCore/Jobs/JobContext.h>
+#include <AzCore/Jobs/JobManager.h>
+#include <AzCore/Jobs/JobManagerDesc.h>
+#include <AzCore/Math/MathUtils.h>
+#include <AzCore/Memory/SystemAllocator.h>
+#include <AzCore/Name/NameDictionary.h>
+#include <AzCore/std/parallel/thread.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+
+#include <Atom/RPI.Reflect/Asset/AssetHandler.h>
+#include <Atom/RPI.Reflect/Buffer/BufferAsset.h>
+#include <Atom/RPI.Reflect/Model/ModelAsset.h>
+#include <Atom/RPI.Reflect/Model/ModelLodAsset.h>
+#include <Atom/RPI.Reflect/ResourcePoolAsset.h>
+
+#include <Generation/BufferPoolRegistry.h>
+#include <Generation/ChunkedVoxelMesher.h>
+#include <Generation/ModelBuilder.h>
+#include <Generation/ModelDiskCache.h>
+#include <Generation/MeshUtils.h>
+#include <Generation/QuadBatch.h>
+
+#include <cmath>
+#include <cstdlib>
+
+namespace CustomGem
+{
+    namespace
+    {
+        //! Rolling heightfield with a different top material, dense enough to exercise culling and merging
+        void FillTestTerrain(VoxelVolume& volume, int sizeX, int sizeY, int sizeZ)
+        {
+            volume.Resize(sizeX, sizeY, sizeZ);
+            volume.palette = { VoxelMaterial{}, VoxelMaterial::FromTile({ 3, 1 }), VoxelMaterial::FromTile({ 3, 0 }) };
+            for (int z = 0; z < sizeZ; ++z)
+            {
+                for (int x = 0; x < sizeX; ++x)
+                {
+                    const float wave = std::sin(x * 0.11f) * std::cos(z * 0.07f);
+                    const int height = AZ::GetClamp(static_cast<int>(sizeY * (0.5f + 0.25f * wave)), 1, sizeY);
+                    for (int y = 0; y < height; ++y)
+                    {
+                        volume.Set(x, y, z, y + 1 == height ? 2 : 1);
+                    }
+                }
+            }
+        }
+
+        //! SystemAllocator allocations since construction, from its allocation records. Allocators
+        //! without records (memory tracking off) report nothing.
+        class AllocationCounter
+        {
+        public:
+            AllocationCounter()
+                : m_records(AZ::AllocatorInstance<AZ::SystemAllocator>::Get().GetRecords())
+                , m_start(m_records ? m_records->RequestedAllocs() : 0)
+            {
+            }
+
+            //! Adds the average allocations per iteration to the counters of state
+            void Report(benchmark::State& state) const
+            {
+                if (m_records)
+                {
+                    state.counters["allocs"] = benchmark::Counter(
+                        static_cast<double>(m_records->RequestedAllocs() - m_start), benchmark::Counter::kAvgIterations);
+                }
+            }
+
+        private:
+            AZ::Debug::AllocationRecords* m_records;
+            size_t m_start;
+        };
+
+        //! Mesh sizes in quads, 1 to 1M by powers of ten; a 1M quad mesh holds about 300 MB.
+        //! Setting CUSTOMGEM_BENCHMARK_10M_QUADS in the environment adds a 10M quad run, which needs
+        //! about 3 GB, twice that for CreateModel since it copies the mesh into buffers.
+        void QuadCounts(benchmark::internal::Benchmark* registration)
+        {
+            registration->RangeMultiplier(10)->Range(1, 1000000)->Unit(benchmark::kMicrosecond);
+            if (std::getenv("CUSTOMGEM_BENCHMARK_10M_QUADS"))
+            {
+                registration->Arg(10000000);
+            }
+        }
+
+        //! Quads per second, allocations per iteration and the bytes the mesh streams hold per vertex
+        void ReportMesh(benchmark::State& state, int64_t quadCount, const MeshData& mesh, const AllocationCounter& allocations)
+        {
+            state.SetItemsProcessed(state.iterations() * quadCount);
+            state.counters["bytes/vertex"] = static_cast<double>(mesh.GetCapacityBytes()) / AZStd::max<size_t>(mesh.GetVertexCount(), 1);
+            allocations.Report(state);
+        }
+
+        //! quadCount unit quads along +X cycling through all six faces
+        void PushTestQuads(MeshData& mesh, int64_t quadCount)
+        {
+            for (int64_t i = 0; i < quadCount; ++i)
+            {
+                MeshUtils::PushQuad(mesh, AZ::Vector3(static_cast<float>(i), 0.0f, 0.0f), static_cast<int>(i % FaceCount), { 4, static_cast<int>(i & 15) });
+            }
+        }
+    } // namespace
+
+    //! Chunks meshed per second against worker thread count (range(0))
+    static void BM_ChunkedVoxelMesher(benchmark::State& state)
+    {
+        AZ::JobManagerDesc desc;
+        for (int64_t i = 0; i < state.range(0); ++i)
+        {
+            desc.m_workerThreads.push_back(AZ::JobManagerThreadDesc());
+        }
+        auto jobManager = AZStd::make_unique<AZ::JobManager>(desc);
+        auto jobContext = AZStd::make_unique<AZ::JobContext>(*jobManager);
+
+        VoxelVolume volume;
+        FillTestTerrain(volume, 256, 64, 256);
+
+        ChunkedMeshSettings settings;
+        settings.createModels = false;
+        settings.jobContext = jobContext.get();
+
+        AZStd::vector<VoxelChunk> chunks;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            ChunkedVoxelMesher::Build(volume, settings, chunks);
+            benchmark::DoNotOptimize(chunks.data());
+        }
+
+        state.counters["chunks/s"] = benchmark::Counter(
+            static_cast<double>(chunks.size() * state.iterations()), benchmark::Counter::kIsRate);
+
+        jobContext.reset();
+        jobManager.reset();
+    }
+    BENCHMARK(BM_ChunkedVoxelMesher)->RangeMultiplier(2)->Range(1, 32)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+    //! Per-quad cost of PushQuad with the face picked at runtime, range(0) quads per iteration
+    static void BM_PushQuad(benchmark::State& state)
+    {
+        const int quadCount = static_cast<int>(state.range(0));
+        MeshData mesh;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            mesh.Clear();
+            for (int i = 0; i < quadCount; ++i)
+            {
+                MeshUtils::PushQuad(mesh, AZ::Vector3(static_cast<float>(i), 0.0f, 0.0f), static_cast<int>(Face::PosY), { 4, i & 15 }, 1.0f, 1.0f);
+            }
+            benchmark::DoNotOptimize(mesh.positions.data());
+        }
+        state.SetItemsProcessed(state.iterations() * quadCount);
+    }
+    BENCHMARK(BM_PushQuad)->Arg(1 << 16);
+
+    //! Same quads through PushQuad<Face>, where basis and winding are compile-time constants
+    static void BM_PushQuadFace(benchmark::State& state)
+    {
+        const int quadCount = static_cast<int>(state.range(0));
+        MeshData mesh;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            mesh.Clear();
+            for (int i = 0; i < quadCount; ++i)
+            {
+                MeshUtils::PushQuad<Face::PosY>(mesh, AZ::Vector3(static_cast<float>(i), 0.0f, 0.0f), { 4, i & 15 });
+            }
+            benchmark::DoNotOptimize(mesh.positions.data());
+        }
+        state.SetItemsProcessed(state.iterations() * quadCount);
+    }
+    BENCHMARK(BM_PushQuadFace)->Arg(1 << 16);
+
+    //! Same quads cycling through all faces as one QuadBatch
+    static void BM_QuadBatchEmitter(benchmark::State& state)
+    {
+        const int quadCount = static_cast<int>(state.range(0));
+        AZStd::vector<float> corners(static_cast<size_t>(quadCount) * 3, 0.0f);
+        AZStd::vector<Face> faces(quadCount);
+        AZStd::vector<UVIndex> tiles(quadCount);
+        for (int i = 0; i < quadCount; ++i)
+        {
+            corners[static_cast<size_t>(i) * 3] = static_cast<float>(i);
+            faces[i] = static_cast<Face>(i % FaceCount);
+            tiles[i] = { 4, i & 15 };
+        }
+        QuadBatch batch;
+        batch.corners = corners;
+        batch.faces = faces;
+        batch.tiles = tiles;
+
+        MeshData mesh;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            mesh.Clear();
+            QuadBatchEmitter::Emit(mesh, batch);
+            benchmark::DoNotOptimize(mesh.positions.data());
+        }
+        state.SetItemsProcessed(state.iterations() * quadCount);
+    }
+    BENCHMARK(BM_QuadBatchEmitter)->Arg(1 << 16);
+
+    //! PushQuad into a new mesh every iteration, so stream growth is part of the cost
+    static void BM_MeshPushQuad(benchmark::State& state)
+    {
+        const AllocationCounter allocations;
+        MeshData mesh;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            mesh = MeshData();
+            mesh.use16BitIndices = true;
+            PushTestQuads(mesh, state.range(0));
+            benchmark::DoNotOptimize(mesh.positions.data());
+        }
+        ReportMesh(state, state.range(0), mesh, allocations);
+    }
+    BENCHMARK(BM_MeshPushQuad)->Apply(QuadCounts);
+
+    //! The four PushVertex calls of each quad into a new mesh every iteration, without indices
+    static void BM_MeshPushVertex(benchmark::State& state)
+    {
+        const AZ::Vector3 normal = AZ::Vector3::CreateAxisZ();
+        const AZ::Vector3 tangent = AZ::Vector3::CreateAxisX();
+        const AZ::Vector3 bitangent = AZ::Vector3::CreateAxisY();
+        const AllocationCounter allocations;
+        MeshData mesh;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            mesh = MeshData();
+            for (int64_t i = 0; i < state.range(0); ++i)
+            {
+                const float x = static_cast<float>(i);
+                MeshUtils::PushVertex(mesh, AZ::Vector3(x, 0.0f, 0.0f), normal, tangent, bitangent, 0.0f, 0.0f);
+                MeshUtils::PushVertex(mesh, AZ::Vector3(x + 1.0f, 0.0f, 0.0f), normal, tangent, bitangent, 1.0f, 0.0f);
+                MeshUtils::PushVertex(mesh, AZ::Vector3(x + 1.0f, 1.0f, 0.0f), normal, tangent, bitangent, 1.0f, 1.0f);
+                MeshUtils::PushVertex(mesh, AZ::Vector3(x, 1.0f, 0.0f), normal, tangent, bitangent, 0.0f, 1.0f);
+            }
+            benchmark::DoNotOptimize(mesh.positions.data());
+        }
+        ReportMesh(state, state.range(0), mesh, allocations);
+    }
+    BENCHMARK(BM_MeshPushVertex)->Apply(QuadCounts);
+
+    //! One repeated-tile uv rect per quad, as PushQuad computes them
+    static void BM_ComputeUvRect(benchmark::State& state)
+    {
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (int64_t i = 0; i < state.range(0); ++i)
+            {
+                float u0, v0, u1, v1;
+                MeshUtils::ComputeUvRect({ 4, static_cast<int>(i & 15) }, 1.0f + (i & 3), 1.0f, u0, v0, u1, v1);
+                benchmark::DoNotOptimize(u0 + v0 + u1 + v1);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_ComputeUvRect)->Apply(QuadCounts);
+
+    //! Name dictionary, asset manager with the RPI handlers CreateModel needs, and a global job
+    //! context for the stream statistics of large meshes. Whatever the test environment already
+    //! provides is left alone.
+    class ModelBuilderBenchmark : public benchmark::Fixture
+    {
+    public:
+        void SetUp(const benchmark::State&) override
+        {
+            if (!AZ::NameDictionary::IsReady())
+            {
+                AZ::NameDictionary::Create();
+                m_ownsNameDictionary = true;
+            }
+            if (!AZ::Data::AssetManager::IsReady())
+            {
+                AZ::Data::AssetManager::Create(AZ::Data::AssetManager::Descriptor());
+                m_ownsAssetManager = true;
+            }
+            m_assetHandlers.push_back(AZ::RPI::MakeAssetHandler<AZ::RPI::BufferAssetHandler>());
+            m_assetHandlers.push_back(AZ::RPI::MakeAssetHandler<AZ::RPI::ResourcePoolAssetHandler>());
+            m_assetHandlers.push_back(AZ::RPI::MakeAssetHandler<AZ::RPI::ModelLodAssetHandler>());
+            m_assetHandlers.push_back(AZ::RPI::MakeAssetHandler<AZ::RPI::ModelAssetHandler>());
+
+            if (!AZ::JobContext::GetGlobalContext())
+            {
+                AZ::JobManagerDesc desc;
+                desc.m_workerThreads.resize(AZStd::max(AZStd::thread::hardware_concurrency(), 2u) - 1);
+                m_jobManager = AZStd::make_unique<AZ::JobManager>(desc);
+                m_jobContext = AZStd::make_unique<AZ::JobContext>(*m_jobManager);
+                AZ::JobContext::SetGlobalContext(m_jobContext.get());
+            }
+        }
+
+        void TearDown(const benchmark::State&) override
+        {
+            if (m_jobContext)
+            {
+                AZ::JobContext::SetGlobalContext(nullptr);
+                m_jobContext.reset();
+                m_jobManager.reset();
+            }
+
+            BufferPoolRegistry::Get().ReleaseUnused();
+            for (const AZStd::unique_ptr<AZ::Data::AssetHandler>& handler : m_assetHandlers)
+            {
+                AZ::Data::AssetManager::Instance().UnregisterHandler(handler.get());
+            }
+            m_assetHandlers.clear();
+            if (m_ownsAssetManager)
+            {
+                AZ::Data::AssetManager::Destroy();
+                m_ownsAssetManager = false;
+            }
+            if (m_ownsNameDictionary)
+            {
+                AZ::NameDictionary::Destroy();
+                m_ownsNameDictionary = false;
+            }
+        }
+
+    private:
+        AZStd::vector<AZStd::unique_ptr<AZ::Data::AssetHandler>> m_assetHandlers;
+        AZStd::unique_ptr<AZ::JobManager> m_jobManager;
+        AZStd::unique_ptr<AZ::JobContext> m_jobContext;
+        bool m_ownsAssetManager = false;
+        bool m_ownsNameDictionary = false;
+    };
+
+    //! CreateModel of a PushQuad mesh without the model cache, split into its phases through
+    //! ModelBuildTimings. Releasing the model is not timed.
+    BENCHMARK_DEFINE_F(ModelBuilderBenchmark, BM_CreateModel)(benchmark::State& state)
+    {
+        MeshData mesh;
+        mesh.use16BitIndices = true;
+        PushTestQuads(mesh, state.range(0));
+
+        const AZ::Name name("BenchmarkModel");
+        ModelBuildTimings timings;
+        ModelBuildSettings settings;
+        settings.useModelCache = false;
+        settings.timings = &timings;
+
+        const AllocationCounter allocations;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            AZ::Data::Asset<AZ::RPI::ModelAsset> model = ModelBuilder::CreateModel(name, mesh, settings);
+            benchmark::DoNotOptimize(model.Get());
+
+            state.PauseTiming();
+            ModelBuilder::ReleaseModel(model);
+            state.ResumeTiming();
+        }
+
+        // Phase times in microseconds per build, to match the benchmark unit
+        state.counters["bounds_us"] = benchmark::Counter(timings.boundsSeconds * 1e6, benchmark::Counter::kAvgIterations);
+        state.counters["buffers_us"] = benchmark::Counter(timings.bufferSeconds * 1e6, benchmark::Counter::kAvgIterations);
+        state.counters["assembly_us"] = benchmark::Counter(timings.GetAssemblySeconds() * 1e6, benchmark::Counter::kAvgIterations);
+        state.counters["buffer_bytes/vertex"] = benchmark::Counter(
+            static_cast<double>(timings.bufferBytes) / AZStd::max<size_t>(mesh.GetVertexCount(), 1), benchmark::Counter::kAvgIterations);
+        ReportMesh(state, state.range(0), mesh, allocations);
+    }
+    BENCHMARK_REGISTER_F(ModelBuilderBenchmark, BM_CreateModel)->Apply(QuadCounts);
+
+    //! BuildOctCube end to end, through the model cache but not the disk cache; releasing every model
+    //! makes each build a cache miss that runs the generator
+    BENCHMARK_DEFINE_F(ModelBuilderBenchmark, BM_BuildOctCube)(benchmark::State& state)
+    {
+        ModelBuildSettings settings;
+        settings.useDiskCache = false;
+
+        const AllocationCounter allocations;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            AZ::Data::Asset<AZ::RPI::ModelAsset> model = ModelBuilder::BuildOctCube(settings);
+            benchmark::DoNotOptimize(model.Get());
+            ModelBuilder::ReleaseModel(model);
+        }
+        state.SetItemsProcessed(state.iterations());
+        allocations.Report(state);
+    }
+    BENCHMARK_REGISTER_F(ModelBuilderBenchmark, BM_BuildOctCube)->Unit(benchmark::kMicrosecond);
+
+    //! BuildOctCube uploading from a ModelDiskCache hit instead of running the generator. The model
+    //! cache is off so every build reads the disk cache, which is cleared before and after the run.
+    BENCHMARK_DEFINE_F(ModelBuilderBenchmark, BM_BuildOctCubeDiskHit)(benchmark::State& state)
+    {
+        ModelBuildSettings settings;
+        settings.useModelCache = false;
+
+        ModelDiskCache::Get().Clear();
+        AZ::Data::Asset<AZ::RPI::ModelAsset> warm = ModelBuilder::BuildOctCube(settings);
+        ModelBuilder::ReleaseModel(warm);
+        const uint64_t hits = ModelDiskCache::Get().GetStats().hits;
+
+        const AllocationCounter allocations;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            AZ::Data::Asset<AZ::RPI::ModelAsset> model = ModelBuilder::BuildOctCube(settings);
+            benchmark::DoNotOptimize(model.Get());
+            ModelBuilder::ReleaseModel(model);
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.counters["disk_hits"] = benchmark::Counter(
+            static_cast<double>(ModelDiskCache::Get().GetStats().hits - hits), benchmark::Counter::kAvgIterations);
+        allocations.Report(state);
+        ModelDiskCache::Get().Clear();
+    }
+    BENCHMARK_REGISTER_F(ModelBuilderBenchmark, BM_BuildOctCubeDiskHit)->Unit(benchmark::kMicrosecond);
+} // namespace CustomGem
+#endif
+
 AZ_UNIT_TEST_HOOK(DEFAULT_UNIT_TEST_ENV);
@@ -2,4 +2,6 @@
 set(FILES
     Include/CustomCppToolGem/CustomCppToolGemBus.h
     Include/CustomCppToolGem/CustomCppToolGemTypeIds.h
+    Include/CustomCppToolGem/MeshData.h
+    Include/CustomCppToolGem/ProceduralModel.h
 )
@@ -5,8 +5,10 @@ set(FILES
     Source/Tools/CustomCppToolGemWidget.cpp
     Source/Tools/CustomCppToolGemWidget.h
     Source/Tools/CustomCppToolGem.qrc
-    Source/Tools/ModelBuilder.h
-    Source/Tools/ModelBuilder.cpp
+    Source/Tools/InstanceSpawner.h
+    Source/Tools/InstanceSpawner.cpp
+    Source/Generation/VoxelChunkStore.h
+    Source/Generation/VoxelChunkStore.cpp
 )
 
 
@@ -4,4 +4,43 @@ set(FILES
     Source/CustomCppToolGemModuleInterface.h
     Source/Clients/CustomCppToolGemSystemComponent.cpp
     Source/Clients/CustomCppToolGemSystemComponent.h
+    Source/Clients/GenerationScheduler.h
+    Source/Clients/GenerationScheduler.cpp
+    Source/Generation/ModelBuilder.h
+    Source/Generation/ModelBuilder.cpp
+    Source/Generation/MeshUtils.h
+    Source/Generation/MeshUtils.cpp
+    Source/Generation/MeshDataPool.h
+    Source/Generation/MeshDataPool.cpp
+    Source/Generation/SimdDispatch.h
+    Source/Generation/QuadBatch.h
+    Source/Generation/QuadBatch.cpp
+    Source/Generation/MeshStatistics.h
+    Source/Generation/MeshStatistics.cpp
+    Source/Generation/BufferPoolRegistry.h
+    Source/Generation/BufferPoolRegistry.cpp
+    Source/Generation/VertexCompression.h
+    Source/Generation/VertexCompression.cpp
+    Source/Generation/VoxelMesher.h
+    Source/Generation/VoxelMesher.cpp
+    Source/Generation/ChunkedVoxelMesher.h
+    Source/Generation/ChunkedVoxelMesher.cpp
+    Source/Generation/VoxelDirtyChunks.h
+    Source/Generation/VoxelDirtyChunks.cpp
+    Source/Generation/MeshOptimizer.h
+    Source/Generation/MeshOptimizer.cpp
+    Source/Generation/MeshSimplifier.h
+    Source/Generation/MeshSimplifier.cpp
+    Source/Generation/ModelCache.h
+    Source/Generation/ModelCache.cpp
+    Source/Generation/ModelDiskCache.h
+    Source/Generation/ModelDiskCache.cpp
+    Source/Generation/MappedFile.h
+    Source/Generation/MappedFile.cpp
+    Source/Generation/MeshFile.h
+    Source/Generation/MeshFile.cpp
+    Source/Generation/MeshImporter.h
+    Source/Generation/MeshImporter.cpp
+    Source/Generation/PrimitiveGenerator.h
+    Source/Generation/PrimitiveGenerator.cpp
 )